@@ -7,6 +7,7 @@
  */
 #include "backend/config.h"
 #include "backend/timer.h"
+#include "backend/profile.h"
 #include "topology/split_and_join.h"
 #include "topology/xspacelib.h"
 #include "topology/evaluationX.h"
@@ -26,6 +27,8 @@
 #include "multistep.h"
 #include "elliptic.h"
 #include "runge_kutta.h"
+#include "multirate.h"
+#include "parareal.h"
 #include "adaptive.h"
 #include "extrapolation.h"
 #include "multigrid.h"
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "exceptions.h"
+#include "timer.h"
+
+/*! @file
+ * @brief Benchmark harness with statistics and machine readable output
+ */
+namespace dg
+{
+
+/**
+ * @brief Statistics of the repetitions of a benchmark (times in seconds)
+ * @ingroup profiling
+ */
+struct BenchmarkResult
+{
+    std::string name; //!< name of the benchmark
+    std::string params; //!< parameters of the measurement in the form \c "n=3;Nx=64"
+    unsigned repetitions = 0; //!< number of timed repetitions
+    double median = 0.; //!< median time of one repetition
+    double mean = 0.; //!< mean time of one repetition
+    double min = 0.; //!< minimum time of one repetition
+    double max = 0.; //!< maximum time of one repetition
+    double stddev = 0.; //!< standard deviation of the time of one repetition
+    double gbytes = 0.; //!< memory traffic of one repetition in GB (0 if unknown)
+    /// Bandwidth in GB/s computed from the median time (0 if unknown)
+    double bandwidth() const{ return gbytes > 0 && median > 0 ? gbytes/median : 0.;}
+    /// Unique key of the measurement <tt> name + "|" + params </tt>
+    std::string key() const{ return name + "|" + params;}
+};
+
+/**
+ * @brief Time functions repeatedly and write the results as CSV or JSON
+ *
+ * Each call to \c run executes the given function a number of times without
+ * timing (warm-up) and then times every repetition separately.
+ * The results can be written in CSV or JSON format and compared to a
+ * baseline that was written to CSV before (e.g. on the same machine with an older
+ * version of the code) to detect performance regressions.
+ * @snippet{trimleft} benchmark_t.cpp benchmark
+ * @note Times are measured with \c dg::Timer, i.e. with MPI all processes
+ * in \c MPI_COMM_WORLD are synchronized before and after each repetition
+ * @sa \c bench_b.cpp for a program that sweeps over grid sizes and number of threads
+ * @ingroup profiling
+ */
+struct Benchmark
+{
+    Benchmark() = default;
+    /**
+     * @brief Set number of warm-up and timed repetitions
+     * @param warmup number of untimed calls before the measurement
+     * @param repetitions number of timed calls (must be > 0)
+     */
+    Benchmark( unsigned warmup, unsigned repetitions) :
+        m_warmup( warmup), m_repetitions( repetitions)
+    {
+        if( repetitions == 0)
+            throw Error( Message(_ping_)<<"Number of repetitions must be larger than 0");
+    }
+    /**
+     * @brief Set the parameters that are stored with all following results
+     * @param params any string that does not contain commas, by convention
+     *  <tt> key=value </tt> pairs separated by semicolons, e.g. \c "n=3;Nx=64"
+     */
+    void set_params( std::string params){ m_params = params;}
+    /// Parameters that are stored with the following results
+    const std::string& get_params() const{ return m_params;}
+
+    /**
+     * @brief Benchmark a function
+     *
+     * @param name name of the benchmark (must not contain commas)
+     * @param f function called as \c f() in every repetition
+     * @param gbytes memory traffic of one call to \c f in GB (used to
+     * compute the bandwidth; 0 if unknown)
+     * @return the result (which is also appended to \c results())
+     * @tparam Function callable as <tt> void f() </tt>
+     */
+    template<class Function>
+    const BenchmarkResult& run( std::string name, Function&& f, double gbytes = 0.)
+    {
+        for( unsigned u=0; u<m_warmup; u++)
+            f();
+        std::vector<double> times( m_repetitions);
+        dg::Timer t;
+        for( unsigned u=0; u<m_repetitions; u++)
+        {
+            t.tic();
+            f();
+            t.toc();
+            times[u] = t.diff();
+        }
+        BenchmarkResult r;
+        r.name = name;
+        r.params = m_params;
+        r.repetitions = m_repetitions;
+        r.gbytes = gbytes;
+        std::sort( times.begin(), times.end());
+        unsigned N = times.size();
+        r.median = N%2 == 1 ? times[N/2] : 0.5*(times[N/2-1] + times[N/2]);
+        r.min = times.front();
+        r.max = times.back();
+        for( auto time : times)
+            r.mean += time/(double)N;
+        for( auto time : times)
+            r.stddev += (time - r.mean)*(time - r.mean);
+        r.stddev = N > 1 ? sqrt( r.stddev/(double)(N-1)) : 0.;
+        m_results.push_back( r);
+        return m_results.back();
+    }
+    /// All results in the order they were measured
+    const std::vector<BenchmarkResult>& results() const{ return m_results;}
+
+    /**
+     * @brief Write a human readable table of all results
+     * @param os output stream
+     */
+    void display( std::ostream& os = std::cout) const
+    {
+        for( auto& r : m_results)
+            display( r, os);
+    }
+    /**
+     * @brief Write one human readable line
+     * @param r result to write
+     * @param os output stream
+     */
+    static void display( const BenchmarkResult& r, std::ostream& os = std::cout)
+    {
+        os << std::left<<std::setw(24)<<r.name<<std::setw(40)<<r.params
+           << std::right<<std::setprecision(4)
+           << std::setw(12)<<r.median<<"s +- "<<std::setw(10)<<r.stddev<<"s";
+        if( r.gbytes > 0)
+            os << std::setw(10)<<r.bandwidth()<<"GB/s";
+        os << "\n";
+    }
+
+    /**
+     * @brief Write all results in CSV format (with header line)
+     *
+     * The output can be read back with \c read_csv
+     * @param os output stream
+     */
+    void write_csv( std::ostream& os) const
+    {
+        os << "name,params,repetitions,median,mean,min,max,stddev,gbytes,bandwidth\n";
+        os << std::setprecision( 10);
+        for( auto& r : m_results)
+            os << r.name<<","<<r.params<<","<<r.repetitions<<","<<r.median
+               <<","<<r.mean<<","<<r.min<<","<<r.max<<","<<r.stddev
+               <<","<<r.gbytes<<","<<r.bandwidth()<<"\n";
+    }
+    /**
+     * @brief Write all results in JSON format
+     *
+     * The \c params string is split into an object at \c ; and \c =
+     * @param os output stream
+     */
+    void write_json( std::ostream& os) const
+    {
+        os << "{\n  \"results\": [";
+        os << std::setprecision( 10);
+        for( unsigned u=0; u<m_results.size(); u++)
+        {
+            const BenchmarkResult& r = m_results[u];
+            os << (u == 0 ? "\n" : ",\n");
+            os << "    {\"name\": \""<<r.name<<"\", \"params\": {";
+            std::stringstream ss( r.params);
+            std::string pair;
+            bool first = true;
+            while( std::getline( ss, pair, ';'))
+            {
+                auto pos = pair.find( '=');
+                if( pos == std::string::npos)
+                    continue;
+                std::string value = pair.substr( pos+1);
+                os << (first ? "" : ", ")<<"\""<<pair.substr( 0, pos)<<"\": ";
+                if( is_number( value))
+                    os << value;
+                else
+                    os << "\""<<value<<"\"";
+                first = false;
+            }
+            os << "}, \"repetitions\": "<<r.repetitions
+               << ", \"median\": "<<r.median<<", \"mean\": "<<r.mean
+               << ", \"min\": "<<r.min<<", \"max\": "<<r.max
+               << ", \"stddev\": "<<r.stddev<<", \"gbytes\": "<<r.gbytes
+               << ", \"bandwidth\": "<<r.bandwidth()<<"}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    /**
+     * @brief Read results previously written with \c write_csv
+     * @param is input stream
+     * @return results
+     */
+    static std::vector<BenchmarkResult> read_csv( std::istream& is)
+    {
+        std::vector<BenchmarkResult> results;
+        std::string line;
+        std::getline( is, line); // header
+        unsigned line_number = 1;
+        while( std::getline( is, line))
+        {
+            line_number++;
+            if( line.empty())
+                continue;
+            std::vector<std::string> fields;
+            std::stringstream ss( line);
+            std::string field;
+            while( std::getline( ss, field, ','))
+                fields.push_back( field);
+            if( fields.size() != 10)
+                throw Error( Message(_ping_)<<"Line "<<line_number
+                        <<" of baseline has "<<fields.size()<<" fields instead of 10");
+            BenchmarkResult r;
+            r.name = fields[0];
+            r.params = fields[1];
+            r.repetitions = std::stoul( fields[2]);
+            r.median = std::stod( fields[3]);
+            r.mean = std::stod( fields[4]);
+            r.min = std::stod( fields[5]);
+            r.max = std::stod( fields[6]);
+            r.stddev = std::stod( fields[7]);
+            r.gbytes = std::stod( fields[8]);
+            results.push_back( r);
+        }
+        return results;
+    }
+
+    /**
+     * @brief Compare results with a baseline
+     *
+     * A result whose median time is larger than <tt> (1+tolerance) </tt> times
+     * the median of the baseline result with the same name and parameters is a
+     * regression. Results without baseline are marked as new, results whose
+     * baseline median is not positive as invalid baseline (neither counts as
+     * regression).
+     * @param baseline results e.g. from \c read_csv
+     * @param tolerance relative tolerance (e.g. 0.1 for 10%)
+     * @param os a table with the relative change of every result is written here
+     * @return number of regressions
+     */
+    unsigned compare( const std::vector<BenchmarkResult>& baseline,
+        double tolerance, std::ostream& os = std::cout) const
+    {
+        std::map<std::string, BenchmarkResult> base;
+        for( auto& r : baseline)
+            base[r.key()] = r;
+        unsigned regressions = 0;
+        os << std::left<<std::setw(24)<<"name"<<std::setw(40)<<"params"
+           << std::right<<std::setw(12)<<"baseline[s]"<<std::setw(12)<<"median[s]"
+           << std::setw(10)<<"change"<<"  status\n";
+        for( auto& r : m_results)
+        {
+            os << std::left<<std::setw(24)<<r.name<<std::setw(40)<<r.params
+               << std::right<<std::setprecision(4);
+            if( base.count( r.key()) == 0)
+            {
+                os << std::setw(12)<<"-"<<std::setw(12)<<r.median
+                   << std::setw(10)<<"-"<<"  new\n";
+                continue;
+            }
+            double b = base[r.key()].median;
+            if( !(b > 0)) // cannot compute a relative change
+            {
+                os << std::setw(12)<<b<<std::setw(12)<<r.median
+                   << std::setw(10)<<"-"<<"  invalid baseline\n";
+                continue;
+            }
+            double change = (r.median - b)/b;
+            os << std::setw(12)<<b<<std::setw(12)<<r.median
+               << std::setw(9)<<std::setprecision(3)<<100.*change<<"%  ";
+            if( change > tolerance)
+            {
+                os << "REGRESSION\n";
+                regressions++;
+            }
+            else if( change < -tolerance)
+                os << "faster\n";
+            else
+                os << "ok\n";
+        }
+        return regressions;
+    }
+    private:
+    static bool is_number( const std::string& value)
+    {
+        if( value.empty())
+            return false;
+        std::stringstream ss( value);
+        double d;
+        ss >> d;
+        return !ss.fail() && ss.eof();
+    }
+    unsigned m_warmup = 2, m_repetitions = 10;
+    std::string m_params;
+    std::vector<BenchmarkResult> m_results;
+};
+
+}//namespace dg
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "benchmark.h"
+
+#include "catch2/catch_all.hpp"
+
+TEST_CASE( "Benchmark harness")
+{
+    //! [benchmark]
+    std::vector<double> x( 1000, 1.), y( 1000, 2.);
+    dg::Benchmark bench( 1, 5); // 1 warm-up, 5 timed repetitions
+    bench.set_params( "size=1000");
+    bench.run( "axpy", [&](){
+            for( unsigned u=0; u<x.size(); u++)
+                y[u] += 2.*x[u];
+        }, 3*1000*sizeof(double)/1e9);
+    std::stringstream csv;
+    bench.write_csv( csv);
+    //! [benchmark]
+    const dg::BenchmarkResult& r = bench.results()[0];
+    CHECK( r.name == "axpy");
+    CHECK( r.params == "size=1000");
+    CHECK( r.repetitions == 5);
+    CHECK( y[0] == 14.); // 6 calls in total
+    CHECK( r.min <= r.median);
+    CHECK( r.median <= r.max);
+    CHECK( r.min <= r.mean);
+    CHECK( r.mean <= r.max);
+    SECTION( "CSV round trip")
+    {
+        auto results = dg::Benchmark::read_csv( csv);
+        REQUIRE( results.size() == 1);
+        CHECK( results[0].key() == r.key());
+        CHECK( results[0].repetitions == 5);
+    }
+    SECTION( "Compare to baseline")
+    {
+        std::vector<dg::BenchmarkResult> baseline( 2, r);
+        baseline[1].name = "other";
+        std::stringstream out;
+        CHECK( bench.compare( baseline, 0.1, out) == 0);
+        // a 10 times faster baseline means we regressed
+        baseline[0].median = r.median/10.;
+        CHECK( bench.compare( baseline, 0.1, out) == 1);
+        INFO( out.str());
+        CHECK( out.str().find( "REGRESSION") != std::string::npos);
+        // a zero baseline cannot be compared
+        baseline[0].median = 0.;
+        CHECK( bench.compare( baseline, 0.1, out) == 0);
+        CHECK( out.str().find( "invalid baseline") != std::string::npos);
+    }
+    SECTION( "Truncated CSV line")
+    {
+        std::stringstream truncated( "header\nname,params,5,1,1,1,1,0,0\n");
+        CHECK_THROWS_AS( dg::Benchmark::read_csv( truncated), dg::Error);
+    }
+    SECTION( "JSON output")
+    {
+        std::stringstream json;
+        bench.write_json( json);
+        INFO( json.str());
+        CHECK( json.str().find( "\"params\": {\"size\": 1000}") != std::string::npos);
+    }
+}
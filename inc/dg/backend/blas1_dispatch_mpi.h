@@ -6,6 +6,7 @@
 #include "mpi_vector.h"
 #include "tensor_traits.h"
 #include "predicate.h"
+#include "profile.h"
 
 #include <cassert>
 
@@ -100,6 +101,7 @@ std::vector<int64_t> doDot_superacc( int* status, const Vector1& x, const Vector
     std::vector<int64_t> receive(exblas::BIN_COUNT, (int64_t)0);
     //get communicator from MPIVector
     auto comm = get_idx<vector_idx>(x,y).communicator();
+    DG_PROFILE_REGION( "exblas::reduce_mpi");
     MPI_Comm comm_mod, comm_red;
     dg::exblas::mpi_reduce_communicator( comm, &comm_mod, &comm_red);
     exblas::reduce_mpi_cpu( 1, acc.data(), receive.data(), comm, comm_mod, comm_red);
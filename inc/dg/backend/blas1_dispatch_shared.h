@@ -8,6 +8,8 @@
 #include "scalar_categories.h"
 #include "tensor_traits.h"
 #include "predicate.h"
+#include "first_touch.h"
+#include "profile.h"
 
 #include "blas1_serial.h"
 #if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
@@ -25,12 +27,19 @@ namespace detail
 template< class To, class From, class ...Params>
 To doConstruct( const From& from, ThrustVectorTag, ThrustVectorTag, Params&& ...ps)
 {
-    return To( from.begin(), from.end());
+    if constexpr( std::is_same_v<get_execution_policy<To>, OmpTag>)
+    {
+        To t;
+        assign_first_touch( from, t);
+        return t;
+    }
+    else
+        return To( from.begin(), from.end());
 }
 template< class From, class To, class ...Params>
 void doAssign( const From& from, To& to, ThrustVectorTag, ThrustVectorTag, Params&& ...ps)
 {
-    to.assign( from.begin(), from.end());
+    assign_first_touch( from, to);
 }
 template< class To, class From, class ...Params>
 To doConstruct( const From& from, ArrayScalarTag, ArrayScalarTag, Params&& ...ps)
@@ -82,6 +91,17 @@ inline void doDot_fpe( SharedVectorTag, int* status, std::array<T,N>& fpe, Funct
             );
 }
 
+// Bytes per element that a kernel reads and writes for an argument (for dg::profile)
+template<class T>
+constexpr double do_get_memops_bytes()
+{
+    if constexpr( dg::is_scalar_v<std::decay_t<T>>)
+        return 0.;
+    else // output arguments are read and written
+        return ( std::is_const_v<std::remove_reference_t<T>> ? 1. : 2.)
+            *sizeof( get_value_type<T>);
+}
+
 template< class Vector1, class Vector2>
 std::vector<int64_t> doDot_superacc( int* status, const Vector1& x, const Vector2& y, SharedVectorTag)
 {
@@ -97,6 +117,8 @@ std::vector<int64_t> doDot_superacc( int* status, const Vector1& x, const Vector
         "All ContainerType types must have compatible execution policies (AnyPolicy or Same)!");
     //maybe assert size here?
     auto size = get_idx<vector_idx>(x,y).size();
+    DG_PROFILE_TRAFFIC( size*( do_get_memops_bytes<const Vector1&>() +
+        do_get_memops_bytes<const Vector2&>()), 2.*size);
     return dg::blas1::detail::doDot_dispatch( execution_policy(), status, size,
             do_get_pointer_or_reference(x, get_tensor_category<Vector1>()),
             do_get_pointer_or_reference(y, get_tensor_category<Vector2>()));
@@ -112,6 +134,9 @@ inline void doSubroutine( SharedVectorTag, Subroutine f, ContainerType&& x, Cont
             ... &&   dg::has_any_or_same_policy<ContainerTypes, execution_policy>::value),
         "All ContainerType types must have compatible execution policies (AnyPolicy or Same)!");
     constexpr unsigned vector_idx = find_if_v<dg::is_not_scalar_has_not_any_policy, get_value_type<ContainerType>, ContainerType, ContainerTypes...>::value;
+    DG_PROFILE_TRAFFIC( get_idx<vector_idx>( x, xs...).size()*(
+        do_get_memops_bytes<ContainerType>() + ... +
+        do_get_memops_bytes<ContainerTypes>()), 0.);
     doSubroutine_dispatch(
             get_execution_policy<vector_type>(),
             get_idx<vector_idx>( std::forward<ContainerType>(x), std::forward<ContainerTypes>(xs)...).size(),
@@ -124,6 +149,8 @@ inline void doSubroutine( SharedVectorTag, Subroutine f, ContainerType&& x, Cont
 template<class T, class ContainerType, class BinaryOp, class UnaryOp>
 inline T doReduce( SharedVectorTag, const ContainerType& x, T init, BinaryOp op, UnaryOp unary_op)
 {
+    DG_PROFILE_TRAFFIC( x.size()*do_get_memops_bytes<const ContainerType&>(),
+        (double)x.size());
     return doReduce_dispatch( get_execution_policy<ContainerType>(), x.size(),
             thrust::raw_pointer_cast( x.data()), init, op, unary_op);
 }
@@ -194,6 +221,22 @@ auto doKronecker( SharedVectorTag, Functor&& f, const ContainerType& x0, const C
     if constexpr (std::is_same_v<execution_policy, SerialTag>)
     {
         thrust::host_vector<value_type> y( size);
+#ifdef _OPENMP
+        // Host vectors are evaluated in parallel (unless we already are in a
+        // parallel region); every element is computed by exactly one thread
+        // the same way as in the serial loop, so the result is identical
+        if( !omp_in_parallel() && size > dg::blas1::detail::MIN_SIZE)
+        {
+            #pragma omp parallel
+            {
+                dg::blas1::detail::doKronecker_omp(
+                    thrust::raw_pointer_cast( y.data()), size, _equals(), f, sizes,
+                    dg::do_get_pointer_or_reference( x0, get_tensor_category<ContainerType>()),
+                    dg::do_get_pointer_or_reference( xs, get_tensor_category<ContainerTypes>())...);
+            }
+            return y;
+        }
+#endif //_OPENMP
         dg::blas1::kronecker( y, _equals(), std::forward<Functor>(f), x0, xs ...);
         return y;
     }
@@ -175,28 +175,192 @@ inline std::vector<int64_t> doDot_superacc( int* status, const Vector1& x1, cons
 }
 /////////////////////////////////////////////////////////////////////////////////////
 #ifdef _OPENMP
+// A recursive vector is flattenable if it is made of (possibly nested)
+// recursive vectors of shared vectors. Then all (inner vector, index)
+// pairs can be enumerated as one contiguous index range
+template<class T>
+constexpr bool do_is_flattenable( AnyVectorTag) { return false;}
+template<class T>
+constexpr bool do_is_flattenable( SharedVectorTag) { return true;}
+template<class T>
+constexpr bool do_is_flattenable( StdMapTag) { return false;}
+template<class T>
+constexpr bool do_is_flattenable( RecursiveVectorTag)
+{
+    using inner_type = std::decay_t<decltype( std::declval<T&>()[0])>;
+    return do_is_flattenable<inner_type>( get_tensor_category<inner_type>());
+}
+template<class T>
+constexpr bool is_flattenable_v = do_is_flattenable<std::decay_t<T>>( get_tensor_category<T>());
+
+template<class T>
+inline size_t do_flat_size( const T& x, SharedVectorTag) { return x.size();}
+template<class T>
+inline size_t do_flat_size( const T& x, RecursiveVectorTag)
+{
+    size_t size = 0;
+    for( unsigned i=0; i<x.size(); i++)
+        size += do_flat_size( x[i], get_tensor_category<decltype( x[i])>());
+    return size;
+}
+
+template<class T>
+inline T shift_pointer_or_value( T x, size_t i){ return x;}
+template<class T>
+inline T* shift_pointer_or_value( T* x, size_t i){ return x+i;}
+
+// Apply f to the part of the flattened index range [l,r) that lies in the
+// current leaf; offset is the flat index of the first element of the leaf
+template<class Subroutine, class container, class ...Containers>
+inline void doSubroutine_flat( size_t& offset, size_t l, size_t r, Subroutine f, container&& x, Containers&&... xs);
+template<class Subroutine, class container, class ...Containers>
+inline void doSubroutine_flat( SharedVectorTag, size_t& offset, size_t l, size_t r, Subroutine f, container&& x, Containers&&... xs)
+{
+    constexpr unsigned vector_idx = find_if_v<dg::is_not_scalar, container, container, Containers...>::value;
+    size_t size = get_idx<vector_idx>( x, xs...).size();
+    size_t a = std::max( offset, l), b = std::min( offset+size, r);
+    if( a < b)
+        doSubroutine_dispatch( SerialTag(), (int)(b-a), f,
+            shift_pointer_or_value( do_get_pointer_or_reference(
+                std::forward<container>(x), get_tensor_category<container>()), a-offset),
+            shift_pointer_or_value( do_get_pointer_or_reference(
+                std::forward<Containers>(xs), get_tensor_category<Containers>()), a-offset)...);
+    offset += size;
+}
+template<class Subroutine, class container, class ...Containers>
+inline void doSubroutine_flat( RecursiveVectorTag, size_t& offset, size_t l, size_t r, Subroutine f, container&& x, Containers&&... xs)
+{
+    constexpr unsigned vector_idx = find_if_v<dg::is_not_scalar, container, container, Containers...>::value;
+    auto size = get_idx<vector_idx>( x, xs...).size();
+    for( int i=0; i<(int)size; i++)
+    {
+        if( offset >= r)
+            return;
+        doSubroutine_flat( offset, l, r, f,
+            do_get_vector_element(std::forward<container>(x),i,get_tensor_category<container>()),
+            do_get_vector_element(std::forward<Containers>(xs),i,get_tensor_category<Containers>())...);
+    }
+}
+template<class Subroutine, class container, class ...Containers>
+inline void doSubroutine_flat( size_t& offset, size_t l, size_t r, Subroutine f, container&& x, Containers&&... xs)
+{
+    using vector_type = find_if_t<dg::is_not_scalar, container, container, Containers...>;
+    doSubroutine_flat( get_tensor_category<vector_type>(), offset, l, r, f,
+            std::forward<container>(x), std::forward<Containers>(xs)...);
+}
+
+template<class T, class ContainerType, class BinaryOp, class UnaryOp>
+inline void doReduce_flat( SharedVectorTag, size_t& offset, size_t l, size_t r, const ContainerType& x, T& partial, bool& has_value, BinaryOp op, UnaryOp unary_op)
+{
+    size_t a = std::max( offset, l), b = std::min( offset+x.size(), r);
+    auto ptr = thrust::raw_pointer_cast( x.data());
+    for( size_t i=a; i<b; i++)
+    {
+        if( !has_value)
+        {
+            partial = unary_op( ptr[i-offset]);
+            has_value = true;
+        }
+        else
+            partial = op( partial, unary_op( ptr[i-offset]));
+    }
+    offset += x.size();
+}
+template<class T, class ContainerType, class BinaryOp, class UnaryOp>
+inline void doReduce_flat( RecursiveVectorTag, size_t& offset, size_t l, size_t r, const ContainerType& x, T& partial, bool& has_value, BinaryOp op, UnaryOp unary_op)
+{
+    for( unsigned u=0; u<x.size(); u++)
+    {
+        if( offset >= r)
+            return;
+        doReduce_flat( get_tensor_category<decltype( x[u])>(), offset, l, r,
+                x[u], partial, has_value, op, unary_op);
+    }
+}
+
 //omp tag implementation
 template< class size_type, class Subroutine, class container, class ...Containers>
 inline void doSubroutine_dispatch( RecursiveVectorTag, OmpTag, size_type size, Subroutine f, container&& x, Containers&&... xs)
 {
-    //using inner_container = typename std::decay_t<container>::value_type;
-    if( !omp_in_parallel())//to catch recursive calls
+    using vector_type = find_if_t<dg::is_not_scalar, container, container, Containers...>;
+    if constexpr ( is_flattenable_v<vector_type>)
     {
-        #pragma omp parallel
+        // Schedule all (inner vector, index) pairs as one balanced loop:
+        // every thread works on one contiguous part of the flattened range
+        constexpr unsigned vector_idx = find_if_v<dg::is_not_scalar, container, container, Containers...>::value;
+        size_t total = do_flat_size( get_idx<vector_idx>( x, xs...),
+                get_tensor_category<vector_type>());
+        auto flat = [&]()
+        {
+            size_t tid = omp_get_thread_num(), tnum = omp_get_num_threads();
+            size_t l = tid*total/tnum, r = (tid+1)*total/tnum, offset = 0;
+            if( l < r)
+                doSubroutine_flat( offset, l, r, f, x, xs...);
+        };
+        if( !omp_in_parallel())//to catch recursive calls
         {
-            for( int i=0; i<(int)size; i++) {//omp sometimes has problems if loop variable is not int
+            // the flattened loop calls the kernels directly
+            DG_PROFILE_TRAFFIC( total*( do_get_memops_bytes<container>() + ... +
+                do_get_memops_bytes<Containers>()), 0.);
+            #pragma omp parallel
+            {
+                flat();
+            }
+        }
+        else //we are already in a parallel omp region
+            // partition each inner vector separately (s.a. dg::OmpTag)
+            for( int i=0; i<(int)size; i++) {
                 dg::blas1::subroutine( f,
                     do_get_vector_element(std::forward<container>(x),i,get_tensor_category<container>()),
                     do_get_vector_element(std::forward<Containers>(xs),i,get_tensor_category<Containers>())...);
             }
-        }
     }
-    else //we are already in a parallel omp region
-        for( int i=0; i<(int)size; i++) {
-            dg::blas1::subroutine( f,
-                do_get_vector_element(std::forward<container>(x),i,get_tensor_category<container>()),
-                do_get_vector_element(std::forward<Containers>(xs),i,get_tensor_category<Containers>())...);
+    else
+    {
+        //using inner_container = typename std::decay_t<container>::value_type;
+        if( !omp_in_parallel())//to catch recursive calls
+        {
+            #pragma omp parallel
+            {
+                for( int i=0; i<(int)size; i++) {//omp sometimes has problems if loop variable is not int
+                    dg::blas1::subroutine( f,
+                        do_get_vector_element(std::forward<container>(x),i,get_tensor_category<container>()),
+                        do_get_vector_element(std::forward<Containers>(xs),i,get_tensor_category<Containers>())...);
+                }
+            }
         }
+        else //we are already in a parallel omp region
+            for( int i=0; i<(int)size; i++) {
+                dg::blas1::subroutine( f,
+                    do_get_vector_element(std::forward<container>(x),i,get_tensor_category<container>()),
+                    do_get_vector_element(std::forward<Containers>(xs),i,get_tensor_category<Containers>())...);
+            }
+    }
+}
+
+template<class T, class ContainerType, class BinaryOp, class UnaryOp>
+inline T doReduce_dispatch( RecursiveVectorTag, OmpTag, const ContainerType& x, T init, BinaryOp
+        op, UnaryOp unary_op)
+{
+    // Each thread reduces one contiguous part of the flattened range,
+    // the partial results are combined in thread order
+    size_t total = do_flat_size( x, get_tensor_category<ContainerType>());
+    std::vector<T> partial( omp_get_max_threads(), init);
+    std::vector<char> has_value( omp_get_max_threads(), false);
+    #pragma omp parallel
+    {
+        size_t tid = omp_get_thread_num(), tnum = omp_get_num_threads();
+        size_t l = tid*total/tnum, r = (tid+1)*total/tnum, offset = 0;
+        bool has = false;
+        if( l < r)
+            doReduce_flat( get_tensor_category<ContainerType>(), offset, l, r,
+                    x, partial[tid], has, op, unary_op);
+        has_value[tid] = has;
+    }
+    for( unsigned t=0; t<partial.size(); t++)
+        if( has_value[t])
+            init = op( init, partial[t]);
+    return init;
 }
 #endif //_OPENMP
 
@@ -225,6 +389,15 @@ template<class T, class ContainerType, class BinaryOp, class UnaryOp>
 inline T doReduce( RecursiveVectorTag, const ContainerType& x, T init, BinaryOp
         op, UnaryOp unary_op)
 {
+#ifdef _OPENMP
+    if constexpr( std::is_same_v<get_execution_policy<ContainerType>, OmpTag>
+            && is_flattenable_v<ContainerType>)
+    {
+        if( !omp_in_parallel())
+            return doReduce_dispatch( RecursiveVectorTag(), OmpTag(), x, init,
+                    op, unary_op);
+    }
+#endif //_OPENMP
     //reduce sequentially recursively
     for ( unsigned u=0; u<x.size(); u++)
         init = doReduce( get_tensor_category<decltype( x[u])>(), x[u], init, op,
@@ -232,6 +405,98 @@ inline T doReduce( RecursiveVectorTag, const ContainerType& x, T init, BinaryOp
     return init;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+// BlockVectors with identical layout are processed as one contiguous vector
+template<class T>
+constexpr bool is_block_or_scalar_v = std::is_base_of_v<BlockVectorTag,
+    get_tensor_category<T>> || dg::is_scalar<T>::value;
+
+template<class T>
+inline T&& do_get_block_data( T&& v, AnyScalarTag){ return std::forward<T>(v);}
+template<class T>
+inline decltype(auto) do_get_block_data( T&& v, BlockVectorTag){ return v.data();}
+
+template<class T>
+inline bool do_has_layout( const T& v, const std::vector<unsigned>& sizes, AnyScalarTag){ return true;}
+template<class T>
+inline bool do_has_layout( const T& v, const std::vector<unsigned>& sizes, BlockVectorTag){ return v.block_sizes() == sizes;}
+
+template<class container, class ...Containers>
+inline bool have_same_layout( const container& x, const Containers& ...xs)
+{
+    if constexpr( is_block_or_scalar_v<container> && ( is_block_or_scalar_v<Containers> && ...))
+    {
+        constexpr unsigned vector_idx = find_if_v<dg::is_not_scalar, container, container, Containers...>::value;
+        const std::vector<unsigned>& sizes = get_idx<vector_idx>( x, xs...).block_sizes();
+        return do_has_layout( x, sizes, get_tensor_category<container>()) &&
+            ( do_has_layout( xs, sizes, get_tensor_category<Containers>()) && ...);
+    }
+    else
+        return false;
+}
+
+template< class T, size_t N, class Functor, class ContainerType, class ...ContainerTypes>
+inline void doDot_fpe( BlockVectorTag, int* status, std::array<T,N>& fpe, Functor f,
+    const ContainerType& x, const ContainerTypes& ...xs)
+{
+    if constexpr( is_block_or_scalar_v<ContainerType> && ( is_block_or_scalar_v<ContainerTypes> && ...))
+    {
+        if( have_same_layout( x, xs...))
+        {
+            doDot_fpe( status, fpe, f,
+                do_get_block_data( x, get_tensor_category<ContainerType>()),
+                do_get_block_data( xs, get_tensor_category<ContainerTypes>())...);
+            return;
+        }
+    }
+    doDot_fpe( RecursiveVectorTag(), status, fpe, f, x, xs...);
+}
+
+template< class Vector1, class Vector2>
+inline std::vector<int64_t> doDot_superacc( int* status, const Vector1& x1, const Vector2& x2, BlockVectorTag)
+{
+    if constexpr( is_block_or_scalar_v<Vector1> && is_block_or_scalar_v<Vector2>)
+    {
+        if( have_same_layout( x1, x2))
+            return doDot_superacc( status,
+                do_get_block_data( x1, get_tensor_category<Vector1>()),
+                do_get_block_data( x2, get_tensor_category<Vector2>()));
+    }
+    return doDot_superacc( status, x1, x2, RecursiveVectorTag());
+}
+
+template< class Subroutine, class container, class ...Containers>
+inline void doSubroutine( BlockVectorTag, Subroutine f, container&& x, Containers&&... xs)
+{
+    if constexpr( is_block_or_scalar_v<container> && ( is_block_or_scalar_v<Containers> && ...))
+    {
+#ifdef _OPENMP
+        // in a thread team the blocks are partitioned separately (s.a. dg::OmpTag)
+        using vector_type = find_if_t<dg::is_not_scalar, container, container, Containers...>;
+        bool blockwise = std::is_same_v<get_execution_policy<vector_type>, OmpTag>
+            && omp_in_parallel();
+#else
+        bool blockwise = false;
+#endif //_OPENMP
+        if( !blockwise && have_same_layout( x, xs...))
+        {
+            dg::blas1::subroutine( f,
+                do_get_block_data( std::forward<container>(x), get_tensor_category<container>()),
+                do_get_block_data( std::forward<Containers>(xs), get_tensor_category<Containers>())...);
+            return;
+        }
+    }
+    doSubroutine( RecursiveVectorTag(), f, std::forward<container>(x), std::forward<Containers>(xs)...);
+}
+
+template<class T, class ContainerType, class BinaryOp, class UnaryOp>
+inline T doReduce( BlockVectorTag, const ContainerType& x, T init, BinaryOp
+        op, UnaryOp unary_op)
+{
+    return doReduce( get_tensor_category<decltype( x.data())>(), x.data(),
+            init, op, unary_op);
+}
+
 } //namespace detail
 } //namespace blas1
 } //namespace dg
@@ -7,30 +7,39 @@
 #include "blas1_serial.h"
 #include "exblas/exdot_omp.h"
 #include "exblas/fpedot_omp.h"
+#include "exblas/fastdot_omp.h"
 namespace dg
 {
 namespace blas1
 {
 namespace detail
 {
-constexpr int MIN_SIZE=100;//don't parallelize if work is too small
 
 template<class T, size_t N, class Functor, class ...PointerOrValues>
 inline void doDot_fpe_dispatch( OmpTag, int* status, unsigned size, std::array<T,N>& fpe,
     Functor f, PointerOrValues ...xs_ptr)
 {
-    if(size<MIN_SIZE)
+    if(size<MIN_SIZE && !omp_in_parallel())
         exblas::fpedot_cpu<T,N,Functor,PointerOrValues...>( status, size, fpe, f, xs_ptr...);
     else
         exblas::fpedot_omp<T,N,Functor,PointerOrValues...>( status, size, fpe, f, xs_ptr...);
 }
+template<class T, size_t N, class Functor, class ...PointerOrValues>
+inline void doDot_fpe_dispatch( OmpTag, int* status, unsigned size, std::array<T,N>& fpe,
+    FastSum<Functor> f, PointerOrValues ...xs_ptr)
+{
+    if(size<MIN_SIZE && !omp_in_parallel())
+        exblas::fastdot_cpu<T,N,Functor,PointerOrValues...>( status, size, fpe, f.f, xs_ptr...);
+    else
+        exblas::fastdot_omp<T,N,Functor,PointerOrValues...>( status, size, fpe, f.f, xs_ptr...);
+}
 
 template<class PointerOrValue1, class PointerOrValue2>
 inline std::vector<int64_t> doDot_dispatch( OmpTag, int * status, unsigned size,
     PointerOrValue1 x_ptr, PointerOrValue2 y_ptr)
 {
     std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
-    if(size<MIN_SIZE)
+    if(size<MIN_SIZE && !omp_in_parallel())
         exblas::exdot_cpu( size, x_ptr,y_ptr, &h_superacc[0], status);
     else
         exblas::exdot_omp( size, x_ptr,y_ptr, &h_superacc[0], status);
@@ -41,17 +50,19 @@ inline std::vector<int64_t> doDot_dispatch( OmpTag, int* status, unsigned size,
     PointerOrValue1 x_ptr, PointerOrValue2 y_ptr, PointerOrValue3 z_ptr)
 {
     std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
-    if(size<MIN_SIZE)
+    if(size<MIN_SIZE && !omp_in_parallel())
         exblas::exdot_cpu( size, x_ptr,y_ptr,z_ptr, &h_superacc[0], status);
     else
         exblas::exdot_omp( size, x_ptr,y_ptr,z_ptr, &h_superacc[0], status);
     return h_superacc;
 }
 
+// The static schedule assigns the same index range to the same thread in
+// every call with equal size (s.a. dg::OmpTag)
 template< class Subroutine, class PointerOrValue, class ...PointerOrValues>
 inline void doSubroutine_omp( int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
 {
-#pragma omp for nowait
+#pragma omp for schedule(static) nowait
     for( int i=0; i<size; i++)
         //f(x[i], xs[i]...);
         //f(thrust::raw_reference_cast(*(x+i)), thrust::raw_reference_cast(*(xs+i))...);
@@ -78,49 +89,53 @@ inline void doSubroutine_dispatch( OmpTag, int size, Subroutine f, PointerOrValu
 }
 
 template<class T, class Pointer, class BinaryOp, class UnaryOp>
-inline T doReduce_dispatch( OmpTag, int size, Pointer x, T init, BinaryOp op,
+inline T doReduce_dispatch( OmpTag, size_t size, Pointer x, T init, BinaryOp op,
         UnaryOp unary_op)
 {
-    return thrust::transform_reduce(thrust::omp::par, x, x+size, unary_op, init, op);
-}
-template<class F, class G, size_t N, class Pointer, class ...PointerOrValues>
-void doKronecker_omp( Pointer y, size_t size, F f, G g, const std::array<size_t, N>& sizes, PointerOrValues ...xs)
-{
-//#pragma omp for nowait
-//for( unsigned u=0; u<size; u++)
-    unsigned int tid = omp_get_thread_num();
-    unsigned int tnum = omp_get_num_threads();
-    int l = tid * size / tnum;
-    int r = ((tid+1) * size / tnum)  - 1;
-    std::array<size_t, N> current;
-    // Compute initial current
-    current[0] = l%sizes[0];
-    size_t remain = l/sizes[0];
-    for( unsigned k=1; k<N; k++)
+    if( !omp_in_parallel())
+        return thrust::transform_reduce(thrust::omp::par, x, x+size, unary_op, init, op);
+    // Called by all threads of the team: each thread reduces its part, the
+    // partial results are combined in thread order by every thread
+    // The buffers of the thread executing the single region are shared
+    // (they live until after the last barrier)
+    std::vector<T> partial_buffer;
+    std::vector<char> has_value_buffer;
+    std::vector<T>* partial;
+    std::vector<char>* has_value;
+    int tid = omp_get_thread_num(), tnum = omp_get_num_threads();
+    // the implicit barrier guarantees that all threads finished writing x
+    #pragma omp single copyprivate( partial, has_value)
     {
-        current[k] = remain%sizes[k];
-        remain = remain/sizes[k];
+        partial_buffer.assign( tnum, init);
+        has_value_buffer.assign( tnum, false);
+        partial = &partial_buffer;
+        has_value = &has_value_buffer;
     }
-    for(int i = l; i <= r; i++)
+    size_t l = tid*size/tnum, r = (tid+1)*size/tnum;
+    if( l < r)
     {
-        call_host_F( f, g, y, i, &current[0], std::make_index_sequence<N>(), xs ...);
-        // Counting is faster than re-computing modulo operations
-        for( unsigned k=0; k<N; k++)
-        {
-            current[k] ++;
-            if( current[k] == sizes[k])
-                current[k] = 0;
-            else
-                break;
-        }
+        T tmp = unary_op( x[l]);
+        for( size_t i=l+1; i<r; i++)
+            tmp = op( tmp, unary_op( x[i]));
+        (*partial)[tid] = tmp;
+        (*has_value)[tid] = true;
     }
+    #pragma omp barrier
+    for( int t=0; t<tnum; t++)
+        if( (*has_value)[t])
+            init = op( init, (*partial)[t]);
+    #pragma omp barrier
+    return init;
 }
 template<class F, class G, size_t N, class Pointer, class ...PointerOrValues>
 void doKronecker_dispatch( OmpTag, Pointer y, size_t size, F&& f, G&& g, const std::array<size_t, N>& sizes, PointerOrValues ...xs)
 {
     if(omp_in_parallel())
     {
+        // y is partitioned differently than in doSubroutine_omp
+        #pragma omp barrier
         doKronecker_omp( y, size, std::forward<F>(f), std::forward<G>(g), sizes, xs... );
+        #pragma omp barrier
         return;
     }
     if(size>MIN_SIZE)
@@ -1,10 +1,15 @@
 #ifndef _DG_BLAS_SERIAL_
 #define _DG_BLAS_SERIAL_
+#include <utility>
 #include "config.h"
 #include "exceptions.h"
 #include "execution_policy.h"
 #include "exblas/exdot_serial.h"
 #include "exblas/fpedot_serial.h"
+#include "exblas/fastdot_serial.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
 
 namespace dg
 {
@@ -18,6 +23,20 @@ inline void doDot_fpe_dispatch( SerialTag, int * status, unsigned size, std::arr
 {
     exblas::fpedot_cpu<T,N,Functor,PointerOrValues...>( status, size, fpe, f, xs_ptr...);
 }
+// Marks a Functor in doDot_fpe for the fast (non-exact) reduction s.a. dg::blas1::fast_dot
+template<class Functor>
+struct FastSum
+{
+    template<class ...Ts>
+    DG_DEVICE auto operator()( Ts&& ... xs) const{ return f( std::forward<Ts>(xs)...);}
+    Functor f;
+};
+template<class T, size_t N, class Functor, class ...PointerOrValues>
+inline void doDot_fpe_dispatch( SerialTag, int * status, unsigned size, std::array<T,N>& fpe,
+    FastSum<Functor> f, PointerOrValues ...xs_ptr)
+{
+    exblas::fastdot_cpu<T,N,Functor,PointerOrValues...>( status, size, fpe, f.f, xs_ptr...);
+}
 template<class PointerOrValue1, class PointerOrValue2>
 inline std::vector<int64_t> doDot_dispatch( SerialTag, int* status, unsigned size,
     PointerOrValue1 x_ptr, PointerOrValue2 y_ptr)
@@ -96,6 +115,44 @@ void doKronecker_dispatch( dg::SerialTag, Pointer y, size_t size, B&& binary, F&
 }
 
 
+#ifdef _OPENMP
+constexpr int MIN_SIZE=100;//don't parallelize if work is too small
+// Also used for host vectors in dg::kronecker and dg::pullback
+// Call inside a parallel region; each thread computes one contiguous chunk
+template<class F, class G, size_t N, class Pointer, class ...PointerOrValues>
+void doKronecker_omp( Pointer y, size_t size, F f, G g, const std::array<size_t, N>& sizes, PointerOrValues ...xs)
+{
+//#pragma omp for nowait
+//for( unsigned u=0; u<size; u++)
+    unsigned int tid = omp_get_thread_num();
+    unsigned int tnum = omp_get_num_threads();
+    int l = tid * size / tnum;
+    int r = ((tid+1) * size / tnum)  - 1;
+    std::array<size_t, N> current;
+    // Compute initial current
+    current[0] = l%sizes[0];
+    size_t remain = l/sizes[0];
+    for( unsigned k=1; k<N; k++)
+    {
+        current[k] = remain%sizes[k];
+        remain = remain/sizes[k];
+    }
+    for(int i = l; i <= r; i++)
+    {
+        call_host_F( f, g, y, i, &current[0], std::make_index_sequence<N>(), xs ...);
+        // Counting is faster than re-computing modulo operations
+        for( unsigned k=0; k<N; k++)
+        {
+            current[k] ++;
+            if( current[k] == sizes[k])
+                current[k] = 0;
+            else
+                break;
+        }
+    }
+}
+#endif //_OPENMP
+
 }//namespace detail
 }//namespace blas1
 }//namespace dg
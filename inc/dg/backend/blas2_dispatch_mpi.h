@@ -4,6 +4,7 @@
 #include "mpi_matrix.h"
 #include "blas1_dispatch_mpi.h"
 #include "blas2_dispatch_shared.h"
+#include "profile.h"
 
 ///@cond
 namespace dg
@@ -28,6 +29,7 @@ inline std::vector<int64_t> doDot_superacc( int* status, const Vector1& x, const
     std::vector<int64_t> receive(exblas::BIN_COUNT, (int64_t)0);
     //get communicator from MPIVector
     auto comm = get_idx<vector_idx>(x,y).communicator();
+    DG_PROFILE_REGION( "exblas::reduce_mpi");
     MPI_Comm comm_mod, comm_red;
     dg::exblas::mpi_reduce_communicator( comm, &comm_mod, &comm_red);
     exblas::reduce_mpi_cpu( 1, acc.data(), receive.data(), comm, comm_mod, comm_red);
@@ -45,6 +47,7 @@ inline std::vector<int64_t> doDot_superacc( int* status, const Vector1& x, const
         m.data(),
         do_get_data(y, get_tensor_category<Vector2>()));
     std::vector<int64_t> receive(exblas::BIN_COUNT, (int64_t)0);
+    DG_PROFILE_REGION( "exblas::reduce_mpi");
     MPI_Comm comm_mod, comm_red;
     dg::exblas::mpi_reduce_communicator( m.communicator(), &comm_mod, &comm_red);
     exblas::reduce_mpi_cpu( 1, acc.data(), receive.data(), m.communicator(),
@@ -61,6 +61,9 @@ std::vector<int64_t> doDot_superacc( int* status, const Vector1& x,
     static_assert( dg::has_any_or_same_policy<Vector1, execution_policy>::value &&
             dg::has_any_or_same_policy<Vector2, execution_policy>::value,
         "All ContainerType types must have compatible execution policies (AnyPolicy or Same)!");
+    DG_PROFILE_TRAFFIC( m.size()*( dg::blas1::detail::do_get_memops_bytes<const Vector1&>() +
+        dg::blas1::detail::do_get_memops_bytes<const Matrix&>() +
+        dg::blas1::detail::do_get_memops_bytes<const Vector2&>()), 3.*m.size());
 
     return dg::blas1::detail::doDot_dispatch( execution_policy(), status,
         m.size(),
@@ -52,7 +52,10 @@ inline void doParallelFor_dispatch( OmpTag, unsigned size, Stencil f, PointerOrV
 {
     if(omp_in_parallel())
     {
+        // a stencil may read and write outside the thread's index range
+        #pragma omp barrier
         doParallelFor_omp( size, f, x, xs... );
+        #pragma omp barrier
         return;
     }
     if(size>MIN_SIZE)
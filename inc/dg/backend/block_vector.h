@@ -0,0 +1,184 @@
+#pragma once
+
+#include <vector>
+#include <thrust/copy.h>
+#include "vector_categories.h"
+#include "tensor_traits.h"
+#include "view.h"
+
+namespace dg
+{
+
+/**
+ * @brief A recursive vector whose blocks lie in one contiguous chunk of memory
+ *
+ * @ingroup view
+ * The class behaves like a <tt> std::vector<ContainerType> </tt>, i.e. the
+ * bracket operator returns the i-th block (a \c dg::View<ContainerType>) and
+ * the \c size() member returns the number of blocks. However, all blocks are
+ * stored back to back in a single \c ContainerType. This has several advantages
+ * over e.g. <tt> std::array<dg::DVec,2> </tt>:
+ *  - \c dg::blas1 functions, where all vector arguments are \c BlockVector
+ *  (or scalars) of the same layout, reduce to a single call on the
+ *  contiguous data (one kernel launch/parallel region instead of one per block)
+ *  - copying/assigning a \c BlockVector is a single memory copy and reuses
+ *  the existing allocation if the sizes match
+ *  - the whole state can be passed as one pointer e.g. to file output or MPI
+ *
+ * If a \c BlockVector is mixed with other recursive vectors in a \c dg::blas1
+ * function the blocks are processed one after the other just as for
+ * <tt> std::vector </tt>.
+ * @snippet{trimleft} block_vector_t.cpp BlockVector
+ * @note Cannot be used as a target \c to in \c dg::construct or \c dg::assign;
+ * use the constructors instead
+ * @attention Copying or swapping a \c BlockVector updates its views but any
+ * view of a block that the user holds becomes invalid if the underlying
+ * memory is reallocated
+ * @tparam ContainerType \c TensorTraits exists for this class and the
+ * \c tensor_category derives from \c ThrustVectorTag
+ */
+template<class ContainerType>
+struct BlockVector
+{
+    using container_type = ContainerType; //!< the type of the contiguous data
+    using value_type = View<ContainerType>; //!< the type of a block
+    ///@brief Empty vector with no blocks
+    BlockVector() = default;
+    /**
+     * @brief Allocate \c num_blocks blocks of equal size and initialize each with \c copyable
+     *
+     * @param copyable the value and size of each block
+     * @param num_blocks the number of blocks
+     */
+    BlockVector( const ContainerType& copyable, unsigned num_blocks) :
+        m_sizes( num_blocks, copyable.size())
+    {
+        m_data.resize( copyable.size()*num_blocks);
+        update_views();
+        for( unsigned i=0; i<num_blocks; i++)
+            thrust::copy( copyable.begin(), copyable.end(), m_views[i].begin());
+    }
+    /**
+     * @brief Allocate blocks of the given sizes and copy values
+     *
+     * @param blocks the i-th block is initialized with a copy of \c blocks[i]
+     * (the blocks may have different sizes)
+     * @tparam RecursiveVector e.g. <tt> std::vector<ContainerType> </tt> or
+     * <tt> std::array<ContainerType,N> </tt>
+     */
+    template<class RecursiveVector, class = std::enable_if_t<
+        !std::is_same_v<std::decay_t<RecursiveVector>, BlockVector>>>
+    explicit BlockVector( const RecursiveVector& blocks)
+    {
+        unsigned total = 0;
+        for( unsigned i=0; i<blocks.size(); i++)
+        {
+            m_sizes.push_back( blocks[i].size());
+            total += blocks[i].size();
+        }
+        m_data.resize( total);
+        update_views();
+        for( unsigned i=0; i<blocks.size(); i++)
+            thrust::copy( blocks[i].begin(), blocks[i].end(), m_views[i].begin());
+    }
+    ///@brief Deep copy (the views point into the new data)
+    ///@param src source
+    BlockVector( const BlockVector& src) : m_data( src.m_data),
+        m_sizes( src.m_sizes)
+    {
+        update_views();
+    }
+    ///@brief Take ownership of the data of \c src
+    ///@param src source (is empty on output)
+    BlockVector( BlockVector&& src)
+    {
+        swap( src);
+    }
+    /**
+     * @brief Deep copy
+     *
+     * If the total size of \c src equals the one of \c this no memory is
+     * allocated and the assignment is a single memory copy
+     * @param src source
+     * @return *this
+     */
+    BlockVector& operator=( const BlockVector& src)
+    {
+        if( this == &src)
+            return *this;
+        if( m_data.size() == src.m_data.size())
+            thrust::copy( src.m_data.begin(), src.m_data.end(), m_data.begin());
+        else
+            m_data = src.m_data;
+        m_sizes = src.m_sizes;
+        update_views();
+        return *this;
+    }
+    ///@brief Take ownership of the data of \c src
+    ///@param src source (contains the old data of \c this on output)
+    ///@return *this
+    BlockVector& operator=( BlockVector&& src)
+    {
+        swap( src);
+        return *this;
+    }
+    ///@brief Swap data and views
+    ///@param src the vector to swap with
+    void swap( BlockVector& src)
+    {
+        m_data.swap( src.m_data);
+        m_sizes.swap( src.m_sizes);
+        update_views();
+        src.update_views();
+    }
+
+    ///@brief The number of blocks
+    ///@return number of blocks
+    unsigned size() const { return m_views.size();}
+    ///@brief Access a block
+    ///@param i block index
+    ///@return a view of the i-th block
+    value_type& operator[]( unsigned i) { return m_views[i];}
+    ///@copydoc operator[]()
+    const value_type& operator[]( unsigned i) const { return m_views[i];}
+    /**
+     * @brief The contiguous data of all blocks
+     *
+     * @attention Do not resize the returned container
+     * @return the data of all blocks back to back
+     */
+    ContainerType& data() { return m_data;}
+    ///@copydoc data()
+    const ContainerType& data() const { return m_data;}
+    ///@brief The sizes of each block
+    ///@return the size of each block
+    const std::vector<unsigned>& block_sizes() const { return m_sizes;}
+    private:
+    void update_views()
+    {
+        m_views.resize( m_sizes.size());
+        auto ptr = thrust::raw_pointer_cast( m_data.data());
+        for( unsigned i=0; i<m_sizes.size(); i++)
+        {
+            m_views[i].construct( ptr, m_sizes[i]);
+            ptr += m_sizes[i];
+        }
+    }
+    ContainerType m_data;
+    std::vector<unsigned> m_sizes;
+    std::vector<value_type> m_views;
+};
+
+/**
+ * @brief A BlockVector is recursive with the value_type and execution_policy of the underlying container
+ * @ingroup traits
+ */
+template<class ContainerType>
+struct TensorTraits< BlockVector<ContainerType>>
+{
+    using value_type = get_value_type<ContainerType>;
+    using tensor_category = BlockVectorTag;
+    using execution_policy = get_execution_policy<ContainerType>;
+};
+
+}//namespace dg
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <array>
+
+#include "block_vector.h"
+#include "typedefs.h"
+#include "../blas1.h"
+
+#include "catch2/catch_all.hpp"
+
+
+TEST_CASE( "The BlockVector class")
+{
+    SECTION( "BlockVector")
+    {
+        //! [BlockVector]
+        dg::DVec v( 100, 2.);
+        // 2 blocks of size 100 in one contiguous vector
+        dg::BlockVector<dg::DVec> x( v, 2), y( x);
+        CHECK( x.size() == 2);
+        CHECK( x.data().size() == 200);
+        // the blocks can be used like any other vector
+        dg::blas1::plus( y[1], 1.);
+        // a single call on 200 elements
+        dg::blas1::axpby( 2., x, 1., y);
+        CHECK( y.data()[0] == 6.);
+        CHECK( y.data()[150] == 7.);
+        //! [BlockVector]
+    }
+    SECTION( "Copy and assignment")
+    {
+        dg::BlockVector<dg::DVec> x( dg::DVec( 10, 3.), 3), y;
+        y = x;
+        CHECK( y.size() == 3);
+        dg::blas1::copy( 4., y[2]);
+        // x is not changed and the blocks of y point into y's data
+        CHECK( x.data()[25] == 3.);
+        CHECK( y.data()[25] == 4.);
+        auto ptr = thrust::raw_pointer_cast( y.data().data());
+        y = x; // no reallocation
+        CHECK( thrust::raw_pointer_cast( y.data().data()) == ptr);
+        CHECK( thrust::raw_pointer_cast( y[1].data()) == ptr + 10);
+        CHECK( y.data()[25] == 3.);
+        dg::BlockVector<dg::DVec> z( std::move( y));
+        CHECK( thrust::raw_pointer_cast( z[0].data()) == ptr);
+        CHECK( y.size() == 0);
+    }
+    SECTION( "Blocks of different size and mixed recursive vectors")
+    {
+        std::array<dg::DVec,3> arr = { dg::DVec( 7, 1.), dg::DVec( 1000, 2.),
+            dg::DVec( 13, 3.)};
+        dg::BlockVector<dg::DVec> x( arr), y( x);
+        CHECK( x.block_sizes() == std::vector<unsigned>{7,1000,13});
+        CHECK( x[2].size() == 13);
+        dg::blas1::axpby( 2., x, 1., y);
+        double sum = dg::blas1::reduce( y, 0., thrust::plus<double>());
+        CHECK( sum == 7*3.+1000*6.+13*9.);
+        // the contiguous dot product is the same as the blockwise one
+        double dot = dg::blas1::dot( x, y);
+        double dot_arr = dg::blas1::dot( arr, y);
+        CHECK( dot == 7*3.+1000*12.+13*27.);
+        CHECK( dot == dot_arr);
+        // Mixing with std::array works block by block
+        dg::blas1::axpby( 1., arr, -1., y);
+        CHECK( dg::blas1::reduce( y, 0., thrust::plus<double>()) == -sum/3.*2.);
+    }
+}
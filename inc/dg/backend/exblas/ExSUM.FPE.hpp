@@ -51,6 +51,7 @@ struct FPExpansionTraits
 template<typename T, int N, typename TRAITS=FPExpansionTraits<false,false> >
 struct FPExpansionVect
 {
+    using value_type = T; //!< \c double, \c cpu::Vec8d or \c vcl::Vec8d
     /**
      * Constructor
      * \param sa superaccumulator
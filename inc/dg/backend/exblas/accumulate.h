@@ -16,8 +16,10 @@
  *        Matthias Wiesenberger -- mattwi@fysik.dtu.dk
  */
 #pragma once
+#include <array>
 #include "config.h"
 #include "mylibm.hpp"
+#include "vec8d.h"
 //this file has a direct correspondance to gpu code accumulate.cuh
 
 namespace dg
@@ -28,35 +30,42 @@ namespace cpu {
 ///////////////////////////////////////////////////////////////////////////
 //********* Here, the change from float to double happens ***************//
 ///////////////////////////////////////////////////////////////////////////
-#ifndef _WITHOUT_VCL
-inline vcl::Vec8d make_vcl_vec8d( double x, int i){
-    return vcl::Vec8d(x);
+// Vec is either vcl::Vec8d or cpu::Vec8d
+template<class Vec>
+inline Vec make_vec8d( double x, int i){
+    return Vec(x);
 }
-inline vcl::Vec8d make_vcl_vec8d( const double* x, int i){
-    return vcl::Vec8d().load( x+i);
+template<class Vec>
+inline Vec make_vec8d( const double* x, int i){
+    return Vec().load( x+i);
 }
-inline vcl::Vec8d make_vcl_vec8d( double x, int i, int num){
-    return vcl::Vec8d(x);
+template<class Vec>
+inline Vec make_vec8d( double x, int i, int num){
+    return Vec(x).cutoff( num);
 }
-inline vcl::Vec8d make_vcl_vec8d( const double* x, int i, int num){
-    return vcl::Vec8d().load_partial( num, x+i);
+template<class Vec>
+inline Vec make_vec8d( const double* x, int i, int num){
+    return Vec().load_partial( num, x+i);
 }
-inline vcl::Vec8d make_vcl_vec8d( float x, int i){
-    return vcl::Vec8d((double)x);
+template<class Vec>
+inline Vec make_vec8d( float x, int i){
+    return Vec((double)x);
 }
-inline vcl::Vec8d make_vcl_vec8d( const float* x, int i){
-    return vcl::Vec8d( x[i], x[i+1], x[i+2], x[i+3], x[i+4], x[i+5], x[i+6], x[i+7]);
+template<class Vec>
+inline Vec make_vec8d( const float* x, int i){
+    return Vec( x[i], x[i+1], x[i+2], x[i+3], x[i+4], x[i+5], x[i+6], x[i+7]);
 }
-inline vcl::Vec8d make_vcl_vec8d( float x, int i, int num){
-    return vcl::Vec8d((double)x);
+template<class Vec>
+inline Vec make_vec8d( float x, int i, int num){
+    return Vec((double)x).cutoff( num);
 }
-inline vcl::Vec8d make_vcl_vec8d( const float* x, int i, int num){
+template<class Vec>
+inline Vec make_vec8d( const float* x, int i, int num){
     double tmp[8];
     for(int j=0; j<num; j++)
         tmp[j] = (double)x[i+j];
-    return vcl::Vec8d().load_partial( num, tmp);
+    return Vec().load_partial( num, tmp);
 }
-#endif//_WITHOUT_VCL
 template<class T>
 inline T get_element( T x, int i){
 	return x;
@@ -249,6 +258,17 @@ inline void Accumulate( int64_t* accumulator, vcl::Vec8d x) {
     }
 }
 #endif //_WITHOUT_VCL
+/**
+* @brief Accumulate the 8 elements of a portable vector to the superaccumulator
+*
+* @param accumulator a pointer to at least \c BIN_COUNT 64 bit integers on the CPU (representing the superaccumulator)
+* @param x the doubles to add to the superaccumulator
+*/
+inline void Accumulate( int64_t* accumulator, const Vec8d& x) {
+    for(unsigned int j = 0; j != 8; ++j) {
+        exblas::cpu::Accumulate(accumulator, x[j]);
+    }
+}
 ////////////////////////////////////////////////////////////////////////////////
 // Normalize functions
 ////////////////////////////////////////////////////////////////////////////////
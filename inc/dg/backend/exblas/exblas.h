@@ -2,6 +2,7 @@
 
 #include "exdot_serial.h"
 #include "fpedot_serial.h"
+#include "fastdot_serial.h"
 #include "thrust/device_vector.h"
 #if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
 #include "exdot_cuda.cuh" // accumulate.cuh , config.h, mylibm.cuh
@@ -9,6 +10,7 @@
 #elif THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP
 #include "exdot_omp.h" //accumulate.h, mylibm.hpp
 #include "fpedot_omp.h"
+#include "fastdot_omp.h"
 #endif
 
 #ifdef MPI_VERSION
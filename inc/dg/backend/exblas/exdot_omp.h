@@ -21,6 +21,7 @@
 #include <cstdio>
 #include <cmath>
 #include <iostream>
+#include <type_traits>
 
 #include "accumulate.h"
 #include "ExSUM.FPE.hpp"
@@ -91,156 +92,184 @@ inline void Reduction(unsigned int tid, unsigned int tnum, std::vector<int32_t>&
     }
 }
 
+/**
+ * \brief Execute the per thread accumulation and reduction
+ *
+ * Either in a new parallel region or, if called by all threads of an
+ * enclosing parallel region, with the existing thread team (s.a. dg::OmpTag).
+ * In the latter case every thread receives the result in \c h_superacc
+ * \param thread_work <tt> void thread_work( tid, tnum, acc, ready, linesize, error)</tt>
+ */
+template<class ThreadWork>
+void ExDOTFPE_team( ThreadWork thread_work, int64_t* h_superacc, bool* err)
+{
+    int const linesize = 16;    // * sizeof(int32_t)
+    if( !omp_in_parallel())
+    {
+        int maxthreads = omp_get_max_threads();
+        std::vector<int64_t> acc(maxthreads*BIN_COUNT,0);
+        std::vector<int32_t> ready(maxthreads * linesize);
+        std::vector<char> error( maxthreads, false);
+        #pragma omp parallel
+        {
+            thread_work( omp_get_thread_num(), omp_get_num_threads(), acc,
+                ready, linesize, error);
+        }
+        for( int i=IMIN; i<=IMAX; i++)
+            h_superacc[i] = acc[i];
+        for ( int i=0; i<maxthreads; i++)
+            if( error[i]) *err = true;
+        return;
+    }
+    // The buffers are shared by the team
+    struct Buffer{
+        std::vector<int64_t> acc;
+        std::vector<int32_t> ready;
+        std::vector<char> error;
+    };
+    // The buffer of the thread executing the single region is shared
+    // (it lives until after the last barrier)
+    Buffer buffer;
+    Buffer* buf;
+    unsigned int tnum = omp_get_num_threads();
+    // the implicit barrier guarantees that all threads finished writing the input
+    #pragma omp single copyprivate(buf)
+    {
+        buffer.acc.assign( tnum*BIN_COUNT, 0);
+        buffer.ready.assign( tnum*linesize, 0);
+        buffer.error.assign( tnum, false);
+        buf = &buffer;
+    }
+    thread_work( omp_get_thread_num(), tnum, buf->acc, buf->ready, linesize,
+        buf->error);
+    #pragma omp barrier
+    for( int i=IMIN; i<=IMAX; i++)
+        h_superacc[i] = buf->acc[i];
+    for ( unsigned i=0; i<tnum; i++)
+        if( buf->error[i]) *err = true;
+    #pragma omp barrier
+}
+
 template<typename CACHE, typename PointerOrValue1, typename PointerOrValue2>
 void ExDOTFPE(int N, PointerOrValue1 a, PointerOrValue2 b, int64_t* h_superacc, bool* err) {
     // OpenMP sum+reduction
-    int const linesize = 16;    // * sizeof(int32_t)
-    int maxthreads = omp_get_max_threads();
-    std::vector<int64_t> acc(maxthreads*BIN_COUNT,0);
-    std::vector<int32_t> ready(maxthreads * linesize);
-    std::vector<bool> error( maxthreads, false);
-
-    #pragma omp parallel
+    auto thread_work = [&]( unsigned int tid, unsigned int tnum,
+        std::vector<int64_t>& acc, std::vector<int32_t>& ready,
+        int const linesize, std::vector<char>& error)
     {
-        unsigned int tid = omp_get_thread_num();
-        unsigned int tnum = omp_get_num_threads();
-
         CACHE cache(&acc[tid*BIN_COUNT]);
         *(int32_t volatile *)(&ready[tid * linesize]) = 0;  // Race here, who cares?
 
-#ifndef _WITHOUT_VCL
-        int l = ((tid * int64_t(N)) / tnum) & ~7ul; // & ~7ul == round down to multiple of 8
-        int r = ((((tid+1) * int64_t(N)) / tnum) & ~7ul) - 1;
+        using Vec = typename CACHE::value_type;
+        if constexpr( std::is_same_v<Vec, double>)
+        {
+            int l = ((tid * int64_t(N)) / tnum);
+            int r = ((((tid+1) * int64_t(N)) / tnum) ) - 1;
+            for(int i = l; i <= r; i++) {
+                //double r1;
+                //double x = TwoProductFMA(get_element(a,i),get_element(b,i),r1);
+                double x = (double)get_element(a,i)*(double)get_element(b,i);
+                if( !std::isfinite(x) ) error[tid] = true;
+                cache.Accumulate(x);
+                //cache.Accumulate(r1);
+            }
+        }
+        else // vcl::Vec8d or cpu::Vec8d
+        {
+            int l = ((tid * int64_t(N)) / tnum) & ~7ul; // & ~7ul == round down to multiple of 8
+            int r = ((((tid+1) * int64_t(N)) / tnum) & ~7ul) - 1;
 
-        for(int i = l; i < r; i+=8) {
+            for(int i = l; i < r; i+=8) {
 #ifndef _MSC_VER
-            asm ("# myloop");
+                asm ("# myloop");
 #endif
-            //vcl::Vec8d r1 ;
-            //vcl::Vec8d x  = TwoProductFMA(make_vcl_vec8d(a,i), make_vcl_vec8d(b,i), r1);
-            vcl::Vec8d x  = make_vcl_vec8d(a,i)*make_vcl_vec8d(b,i);
-            //MW: check sanity of input
-            vcl::Vec8db finite = vcl::is_finite( x);
-            if( !vcl::horizontal_and( finite) ) error[tid] = true;
+                //Vec r1 ;
+                //Vec x  = TwoProductFMA(make_vec8d<Vec>(a,i), make_vec8d<Vec>(b,i), r1);
+                Vec x  = make_vec8d<Vec>(a,i)*make_vec8d<Vec>(b,i);
+                //MW: check sanity of input
+                if( !horizontal_and( is_finite( x)) ) error[tid] = true;
 
-            cache.Accumulate(x);
-            //cache.Accumulate(r1); //MW: exact product but halfs the speed
-        }
-        if( tid+1==tnum && r != N-1) {
-            r+=1;
-            //accumulate remainder
-            //vcl::Vec8d r1;
-            //vcl::Vec8d x  = TwoProductFMA(make_vcl_vec8d(a,r,N-r), make_vcl_vec8d(b,r,N-r), r1);
-            vcl::Vec8d x  = make_vcl_vec8d(a,r,N-r)*make_vcl_vec8d(b,r,N-r);
+                cache.Accumulate(x);
+                //cache.Accumulate(r1); //MW: exact product but halfs the speed
+            }
+            if( tid+1==tnum && r != N-1) {
+                r+=1;
+                //accumulate remainder
+                Vec x  = make_vec8d<Vec>(a,r,N-r)*make_vec8d<Vec>(b,r,N-r);
 
-            //MW: check sanity of input
-            vcl::Vec8db finite = vcl::is_finite( x);
-            if( !vcl::horizontal_and( finite) ) error[tid] = true;
-            cache.Accumulate(x);
-            //cache.Accumulate(r1);
-        }
-#else// _WITHOUT_VCL
-        int l = ((tid * int64_t(N)) / tnum);
-        int r = ((((tid+1) * int64_t(N)) / tnum) ) - 1;
-        for(int i = l; i <= r; i++) {
-            //double r1;
-            //double x = TwoProductFMA(get_element(a,i),get_element(b,i),r1);
-            double x = (double)get_element(a,i)*(double)get_element(b,i);
-            cache.Accumulate(x);
-            //cache.Accumulate(r1);
+                //MW: check sanity of input
+                if( !horizontal_and( is_finite( x)) ) error[tid] = true;
+                cache.Accumulate(x);
+            }
         }
-#endif// _WITHOUT_VCL
         cache.Flush();
         int imin=IMIN, imax=IMAX;
         Normalize(&acc[tid*BIN_COUNT], imin, imax);
 
         Reduction(tid, tnum, ready, acc, linesize);
-    }
-    for( int i=IMIN; i<=IMAX; i++)
-        h_superacc[i] = acc[i];
-    for ( int i=0; i<maxthreads; i++)
-        if( error[i] == true) *err = true;
+    };
+    ExDOTFPE_team( thread_work, h_superacc, err);
 }
 
 template<typename CACHE, typename PointerOrValue1, typename PointerOrValue2, typename PointerOrValue3>
 void ExDOTFPE(int N, PointerOrValue1 a, PointerOrValue2 b, PointerOrValue3 c, int64_t* h_superacc, bool* err) {
     // OpenMP sum+reduction
-    int const linesize = 16;    // * sizeof(int32_t) (MW avoid false sharing?)
-    int maxthreads = omp_get_max_threads();
-    std::vector<int64_t> acc(maxthreads*BIN_COUNT,0);
-    std::vector<int32_t> ready(maxthreads * linesize);
-    std::vector<bool> error( maxthreads, false);
-
-    #pragma omp parallel
+    auto thread_work = [&]( unsigned int tid, unsigned int tnum,
+        std::vector<int64_t>& acc, std::vector<int32_t>& ready,
+        int const linesize, std::vector<char>& error)
     {
-        unsigned int tid = omp_get_thread_num();
-        unsigned int tnum = omp_get_num_threads();
-
         CACHE cache(&acc[tid*BIN_COUNT]);
         *(int32_t volatile *)(&ready[tid * linesize]) = 0;  // Race here, who cares?
 
-#ifndef _WITHOUT_VCL
-        int l = ((tid * int64_t(N)) / tnum) & ~7ul;// & ~7ul == round down to multiple of 8
-        int r = ((((tid+1) * int64_t(N)) / tnum) & ~7ul) - 1;
+        using Vec = typename CACHE::value_type;
+        if constexpr( std::is_same_v<Vec, double>)
+        {
+            int l = ((tid * int64_t(N)) / tnum);
+            int r = ((((tid+1) * int64_t(N)) / tnum) ) - 1;
+            for(int i = l; i <= r; i++) {
+                double x1 = (double)get_element(a,i)*(double)get_element(b,i);
+                double x2 = x1*(double)get_element(c,i);
+                if( !std::isfinite(x2) ) error[tid] = true;
+                cache.Accumulate(x2);
+            }
+        }
+        else // vcl::Vec8d or cpu::Vec8d
+        {
+            int l = ((tid * int64_t(N)) / tnum) & ~7ul;// & ~7ul == round down to multiple of 8
+            int r = ((((tid+1) * int64_t(N)) / tnum) & ~7ul) - 1;
 
-        for(int i = l; i < r; i+=8) {
+            for(int i = l; i < r; i+=8) {
 #ifndef _MSC_VER
-            asm ("# myloop");
+                asm ("# myloop");
 #endif
-            //vcl::Vec8d r1 , r2, cvec = vcl::Vec8d().load(c+i);
-            //vcl::Vec8d x  = TwoProductFMA(vcl::Vec8d().load(a+i), vcl::Vec8d().load(b+i), r1);
-            //vcl::Vec8d x2 = TwoProductFMA(x , cvec, r2);
-            //vcl::Vec8d x1  = vcl::mul_add(vcl::Vec8d().load(a+i),vcl::Vec8d().load(b+i), 0);
-            //vcl::Vec8d x2  = vcl::mul_add( x1                   ,vcl::Vec8d().load(c+i), 0);
-            vcl::Vec8d x1  = make_vcl_vec8d(a,i)*make_vcl_vec8d(b,i);
-            vcl::Vec8d x2  =  x1                *make_vcl_vec8d(c,i);
-            vcl::Vec8db finite = vcl::is_finite( x2);
-            if( !vcl::horizontal_and( finite) ) error[tid] = true;
-            cache.Accumulate(x2);
-            //cache.Accumulate(r2);
-            //x2 = TwoProductFMA(r1, cvec, r2);
-            //cache.Accumulate(x2);
-            //cache.Accumulate(r2);
-        }
-        if( tid+1 == tnum && r != N-1) {
-            r+=1;
-            //accumulate remainder
-            //vcl::Vec8d r1 , r2, cvec = vcl::Vec8d().load_partial(N-r, c+r);
-            //vcl::Vec8d x  = TwoProductFMA(vcl::Vec8d().load_partial(N-r, a+r), vcl::Vec8d().load_partial(N-r,b+r), r1);
-            //vcl::Vec8d x2 = TwoProductFMA(x , cvec, r2);
-            //vcl::Vec8d x1  = vcl::mul_add(vcl::Vec8d().load_partial(N-r, a+r),vcl::Vec8d().load_partial(N-r,b+r), 0);
-            //vcl::Vec8d x2  = vcl::mul_add( x1                   ,vcl::Vec8d().load_partial(N-r,c+r), 0);
-            vcl::Vec8d x1  = make_vcl_vec8d(a,r,N-r)*make_vcl_vec8d(b,r,N-r);
-            vcl::Vec8d x2  =  x1                    *make_vcl_vec8d(c,r,N-r);
-            vcl::Vec8db finite = vcl::is_finite( x2);
-            if( !vcl::horizontal_and( finite) ) error[tid] = true;
-            cache.Accumulate(x2);
-            //cache.Accumulate(r2);
-            //x2 = TwoProductFMA(r1, cvec, r2);
-            //cache.Accumulate(x2);
-            //cache.Accumulate(r2);
-        }
-#else// _WITHOUT_VCL
-        int l = ((tid * int64_t(N)) / tnum);
-        int r = ((((tid+1) * int64_t(N)) / tnum) ) - 1;
-        for(int i = l; i <= r; i++) {
-            //double x1 = a[i]*b[i];
-            //double x2 = x1*c[i];
-            double x1 = (double)get_element(a,i)*(double)get_element(b,i);
-            double x2 = x1*(double)get_element(c,i);
-            cache.Accumulate(x2);
+                //Vec r1 , r2, cvec = make_vec8d<Vec>(c,i);
+                //Vec x  = TwoProductFMA(make_vec8d<Vec>(a,i), make_vec8d<Vec>(b,i), r1);
+                //Vec x2 = TwoProductFMA(x , cvec, r2);
+                Vec x1  = make_vec8d<Vec>(a,i)*make_vec8d<Vec>(b,i);
+                Vec x2  =  x1                 *make_vec8d<Vec>(c,i);
+                if( !horizontal_and( is_finite( x2)) ) error[tid] = true;
+                cache.Accumulate(x2);
+                //cache.Accumulate(r2);
+                //x2 = TwoProductFMA(r1, cvec, r2);
+                //cache.Accumulate(x2);
+                //cache.Accumulate(r2);
+            }
+            if( tid+1 == tnum && r != N-1) {
+                r+=1;
+                //accumulate remainder
+                Vec x1  = make_vec8d<Vec>(a,r,N-r)*make_vec8d<Vec>(b,r,N-r);
+                Vec x2  =  x1                     *make_vec8d<Vec>(c,r,N-r);
+                if( !horizontal_and( is_finite( x2)) ) error[tid] = true;
+                cache.Accumulate(x2);
+            }
         }
-#endif// _WITHOUT_VCL
         cache.Flush();
         int imin=IMIN, imax=IMAX;
         Normalize(&acc[tid*BIN_COUNT], imin, imax);
 
         Reduction(tid, tnum, ready, acc, linesize);
-    }
-    for( int i=IMIN; i<=IMAX; i++)
-        h_superacc[i] = acc[i];
-    for ( int i=0; i<maxthreads; i++)
-        if( error[i] == true) *err = true;
+    };
+    ExDOTFPE_team( thread_work, h_superacc, err);
 }
 }//namespace cpu
 ///@endcond
@@ -256,7 +285,7 @@ void exdot_omp(unsigned size, PointerOrValue1 x1_ptr, PointerOrValue2 x2_ptr, in
 #ifndef _WITHOUT_VCL
     cpu::ExDOTFPE<cpu::FPExpansionVect<vcl::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, h_superacc, &error);
 #else
-    cpu::ExDOTFPE<cpu::FPExpansionVect<double, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, h_superacc, &error);
+    cpu::ExDOTFPE<cpu::FPExpansionVect<cpu::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, h_superacc, &error);
 #endif//_WITHOUT_VCL
     *status = 0;
     if( error ) *status = 1;
@@ -273,7 +302,7 @@ void exdot_omp(unsigned size, PointerOrValue1 x1_ptr, PointerOrValue2 x2_ptr, Po
 #ifndef _WITHOUT_VCL
     cpu::ExDOTFPE<cpu::FPExpansionVect<vcl::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, x3_ptr, h_superacc, &error);
 #else
-    cpu::ExDOTFPE<cpu::FPExpansionVect<double, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, x3_ptr, h_superacc, &error);
+    cpu::ExDOTFPE<cpu::FPExpansionVect<cpu::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, x3_ptr, h_superacc, &error);
 #endif//_WITHOUT_VCL
     *status = 0;
     if( error ) *status = 1;
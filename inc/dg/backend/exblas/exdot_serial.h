@@ -21,6 +21,7 @@
 #include <cstdio>
 #include <cmath>
 #include <iostream>
+#include <type_traits>
 
 #include "accumulate.h"
 #include "ExSUM.FPE.hpp"
@@ -61,92 +62,83 @@ namespace cpu{
 template<typename CACHE, typename PointerOrValue1, typename PointerOrValue2>
 void ExDOTFPE_cpu(int N, PointerOrValue1 a, PointerOrValue2 b, int64_t* acc, bool* error) {
     CACHE cache(acc);
-#ifndef _WITHOUT_VCL
-    int r = (( int64_t(N) ) & ~7ul);
-    for(int i = 0; i < r; i+=8) {
+    using Vec = typename CACHE::value_type;
+    if constexpr( std::is_same_v<Vec, double>)
+    {
+        for(int i = 0; i < N; i++) {
+            //double r1;
+            //double x = TwoProductFMA(get_element(a,i),get_element(b,i),r1);
+            double x = (double)get_element(a,i)*(double)get_element(b,i);
+            if( !std::isfinite(x) ) *error = true;
+            cache.Accumulate(x);
+            //cache.Accumulate(r1);
+        }
+    }
+    else // vcl::Vec8d or cpu::Vec8d
+    {
+        int r = (( int64_t(N) ) & ~7ul);
+        for(int i = 0; i < r; i+=8) {
 #ifndef _MSC_VER
-        asm ("# myloop");
+            asm ("# myloop");
 #endif
-        //vcl::Vec8d r1 ;
-        //vcl::Vec8d x  = TwoProductFMA(make_vcl_vec8d(a,i), make_vcl_vec8d(b,i), r1);
-        //vcl::Vec8d x  = TwoProductFMA(vcl::Vec8d().load(a+i), vcl::Vec8d().load(b+i), r1);
-        vcl::Vec8d x  = make_vcl_vec8d(a,i)* make_vcl_vec8d(b,i);
-        vcl::Vec8db finite = vcl::is_finite( x);
-        if( !vcl::horizontal_and( finite) ) *error = true;
-        cache.Accumulate(x);
-        //cache.Accumulate(r1);
-    }
-    if( r != N) {
-        //accumulate remainder
-        //vcl::Vec8d r1;
-        //vcl::Vec8d x  = TwoProductFMA(make_vcl_vec8d(a,r,N-r), make_vcl_vec8d(b,r,N-r), r1);
-        //vcl::Vec8d x  = TwoProductFMA(vcl::Vec8d().load_partial(N-r, a+r), vcl::Vec8d().load_partial(N-r,b+r), r1);
-        vcl::Vec8d x  = make_vcl_vec8d(a,r,N-r)*make_vcl_vec8d(b,r,N-r);
-        vcl::Vec8db finite = vcl::is_finite( x);
-        if( !vcl::horizontal_and( finite) ) *error = true;
-        cache.Accumulate(x);
-        //cache.Accumulate(r1);
-    }
-#else// _WITHOUT_VCL
-    for(int i = 0; i < N; i++) {
-        //double r1;
-        //double x = TwoProductFMA(get_element(a,i),get_element(b,i),r1);
-        double x = (double)get_element(a,i)*(double)get_element(b,i);
-        if( !std::isfinite(x) ) *error = true;
-        cache.Accumulate(x);
-        //cache.Accumulate(r1);
+            //Vec r1 ;
+            //Vec x  = TwoProductFMA(make_vec8d<Vec>(a,i), make_vec8d<Vec>(b,i), r1);
+            Vec x  = make_vec8d<Vec>(a,i)* make_vec8d<Vec>(b,i);
+            if( !horizontal_and( is_finite( x)) ) *error = true;
+            cache.Accumulate(x);
+            //cache.Accumulate(r1);
+        }
+        if( r != N) {
+            //accumulate remainder
+            Vec x  = make_vec8d<Vec>(a,r,N-r)*make_vec8d<Vec>(b,r,N-r);
+            if( !horizontal_and( is_finite( x)) ) *error = true;
+            cache.Accumulate(x);
+        }
     }
-#endif// _WITHOUT_VCL
     cache.Flush();
 }
 
 template<typename CACHE, typename PointerOrValue1, typename PointerOrValue2, typename PointerOrValue3>
 void ExDOTFPE_cpu(int N, PointerOrValue1 a, PointerOrValue2 b, PointerOrValue3 c, int64_t* acc, bool* error) {
     CACHE cache(acc);
-#ifndef _WITHOUT_VCL
-    int r = (( int64_t(N))  & ~7ul);
-    for(int i = 0; i < r; i+=8) {
+    using Vec = typename CACHE::value_type;
+    if constexpr( std::is_same_v<Vec, double>)
+    {
+        for(int i = 0; i < N; i++) {
+            double x1 = (double)get_element(a,i)*(double)get_element(b,i);
+            double x2 = x1*(double)get_element(c,i);
+            if( !std::isfinite(x2) ) *error = true;
+            cache.Accumulate(x2);
+        }
+    }
+    else // vcl::Vec8d or cpu::Vec8d
+    {
+        int r = (( int64_t(N))  & ~7ul);
+        for(int i = 0; i < r; i+=8) {
 #ifndef _MSC_VER
-        asm ("# myloop");
+            asm ("# myloop");
 #endif
-        //vcl::Vec8d r1 , r2, cvec = vcl::Vec8d().load(c+i);
-        //vcl::Vec8d x  = TwoProductFMA(vcl::Vec8d().load(a+i), vcl::Vec8d().load(b+i), r1);
-        //vcl::Vec8d x2 = TwoProductFMA(x , cvec, r2);
-        //vcl::Vec8d x1  = vcl::mul_add(vcl::Vec8d().load(a+i),vcl::Vec8d().load(b+i), 0);
-        //vcl::Vec8d x2  = vcl::mul_add( x1                   ,vcl::Vec8d().load(c+i), 0);
-        vcl::Vec8d x1  = vcl::mul_add(make_vcl_vec8d(a,i),make_vcl_vec8d(b,i), 0);
-        vcl::Vec8d x2  = vcl::mul_add( x1                ,make_vcl_vec8d(c,i), 0);
-        vcl::Vec8db finite = vcl::is_finite( x2);
-        if( !vcl::horizontal_and( finite) ) *error = true;
-        cache.Accumulate(x2);
-        //cache.Accumulate(r2);
-        //x2 = TwoProductFMA(r1, cvec, r2);
-        //cache.Accumulate(x2);
-        //cache.Accumulate(r2);
-    }
-    if( r != N) {
-        //accumulate remainder
-        //vcl::Vec8d r1 , r2, cvec = vcl::Vec8d().load_partial(N-r, c+r);
-        //vcl::Vec8d x  = TwoProductFMA(vcl::Vec8d().load_partial(N-r, a+r), vcl::Vec8d().load_partial(N-r,b+r), r1);
-        //vcl::Vec8d x2 = TwoProductFMA(x , cvec, r2);
-        vcl::Vec8d x1  = vcl::mul_add(make_vcl_vec8d(a,r,N-r),make_vcl_vec8d(b,r,N-r), 0);
-        vcl::Vec8d x2  = vcl::mul_add( x1                    ,make_vcl_vec8d(c,r,N-r), 0);
-        vcl::Vec8db finite = vcl::is_finite( x2);
-        if( !vcl::horizontal_and( finite) ) *error = true;
-        cache.Accumulate(x2);
-        //cache.Accumulate(r2);
-        //x2 = TwoProductFMA(r1, cvec, r2);
-        //cache.Accumulate(x2);
-        //cache.Accumulate(r2);
-    }
-#else// _WITHOUT_VCL
-    for(int i = 0; i < N; i++) {
-        double x1 = (double)get_element(a,i)*(double)get_element(b,i);
-        double x2 = x1*(double)get_element(c,i);
-        if( !std::isfinite(x2) ) *error = true;
-        cache.Accumulate(x2);
+            //Vec r1 , r2, cvec = make_vec8d<Vec>(c,i);
+            //Vec x  = TwoProductFMA(make_vec8d<Vec>(a,i), make_vec8d<Vec>(b,i), r1);
+            //Vec x2 = TwoProductFMA(x , cvec, r2);
+            // the product is not fused, so the result is the same for all Vec
+            Vec x1  = make_vec8d<Vec>(a,i)*make_vec8d<Vec>(b,i);
+            Vec x2  =  x1                 *make_vec8d<Vec>(c,i);
+            if( !horizontal_and( is_finite( x2)) ) *error = true;
+            cache.Accumulate(x2);
+            //cache.Accumulate(r2);
+            //x2 = TwoProductFMA(r1, cvec, r2);
+            //cache.Accumulate(x2);
+            //cache.Accumulate(r2);
+        }
+        if( r != N) {
+            //accumulate remainder
+            Vec x1  = make_vec8d<Vec>(a,r,N-r)*make_vec8d<Vec>(b,r,N-r);
+            Vec x2  =  x1                     *make_vec8d<Vec>(c,r,N-r);
+            if( !horizontal_and( is_finite( x2)) ) *error = true;
+            cache.Accumulate(x2);
+        }
     }
-#endif// _WITHOUT_VCL
     cache.Flush();
 }
 }//namespace cpu
@@ -217,7 +209,7 @@ void exdot_cpu(unsigned size, PointerOrValue1 x1_ptr, PointerOrValue2 x2_ptr, in
 #ifndef _WITHOUT_VCL
     cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<vcl::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, h_superacc, &error);
 #else
-    cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<double, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, h_superacc, &error);
+    cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<cpu::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, h_superacc, &error);
 #endif//_WITHOUT_VCL
     *status = 0;
     if( error ) *status = 1;
@@ -237,7 +229,7 @@ void exdot_cpu(unsigned size, PointerOrValue1 x1_ptr, PointerOrValue2 x2_ptr, Po
 #ifndef _WITHOUT_VCL
     cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<vcl::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, x3_ptr, h_superacc, &error);
 #else
-    cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<double, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, x3_ptr, h_superacc, &error);
+    cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<cpu::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size,x1_ptr,x2_ptr, x3_ptr, h_superacc, &error);
 #endif//_WITHOUT_VCL
     *status = 0;
     if( error ) *status = 1;
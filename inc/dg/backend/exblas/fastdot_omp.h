@@ -0,0 +1,77 @@
+/**
+ *  @file fastdot_omp.h
+ *  @brief OpenMP version of fastdot
+ */
+#pragma once
+#include <array>
+#include <vector>
+
+#include <omp.h>
+#include "fastdot_serial.h"
+
+namespace dg
+{
+namespace exblas{
+
+/*!@brief OpenMP version of fast reproducible general dot product
+ *
+ * Each thread computes the sums of a contiguous range of blocks,
+ * which are then combined in the same tree as in \c fastdot_cpu. The
+ * result is thus binary identical to \c fastdot_cpu for any number of threads.
+ * @copydetails fastdot_cpu
+*/
+template<class T, size_t N, class Functor, class ...PointerOrValues>
+void fastdot_omp(int * status, unsigned size, std::array<T,N>& fpe, Functor f, PointerOrValues ...xs_ptr)
+{
+    static_assert( N >= 2, "FPE for fastdot must have at least 2 elements");
+    unsigned num_blocks = (size + cpu::FASTDOT_BLOCK - 1)/cpu::FASTDOT_BLOCK;
+    auto thread_work = [&]( std::vector<std::array<T,2>>& blocks)
+    {
+        #pragma omp for schedule(static) nowait
+        for( unsigned b=0; b<num_blocks; b++)
+            blocks[b] = cpu::FastDotBlock<T>( b*cpu::FASTDOT_BLOCK,
+                std::min( (b+1)*cpu::FASTDOT_BLOCK, size), f, xs_ptr...);
+    };
+    auto result = [&]( const std::array<T,2>& sum)
+    {
+        fpe[0] = sum[0];
+        fpe[1] = sum[1];
+        for( unsigned i=2; i<N; i++)
+            fpe[i] = T(0);
+    };
+    if( !omp_in_parallel())
+    {
+        std::vector<std::array<T,2>> blocks( num_blocks);
+        #pragma omp parallel
+        {
+            thread_work( blocks);
+        }//omp parallel
+        result( cpu::FastDotTree( blocks));
+        return;
+    }
+    // Called by all threads of an enclosing parallel region (s.a. dg::OmpTag):
+    // the buffer is shared by the team and every thread receives the result
+    using Buffer = std::pair<std::vector<std::array<T,2>>, std::array<T,2>>;
+    Buffer* buf;
+    // the implicit barrier guarantees that all threads finished writing the input
+    #pragma omp single copyprivate(buf)
+    {
+        buf = new Buffer( std::vector<std::array<T,2>>(num_blocks),
+            std::array<T,2>{T(0),T(0)});
+    }
+    thread_work( buf->first);
+    #pragma omp barrier
+    #pragma omp single
+    {
+        buf->second = cpu::FastDotTree( buf->first);
+    }
+    result( buf->second);
+    #pragma omp barrier
+    #pragma omp single nowait
+    {
+        delete buf;
+    }
+}
+
+}//namespace exblas
+} //namespace dg
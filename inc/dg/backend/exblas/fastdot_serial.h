@@ -0,0 +1,126 @@
+/**
+ *  @file fastdot_serial.h
+ *  @brief Serial version of fastdot
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include "accumulate.h"
+
+namespace dg
+{
+namespace exblas{
+///@cond
+namespace cpu{
+
+static constexpr unsigned FASTDOT_BLOCK = 1024; //# elements per block
+static constexpr unsigned FASTDOT_LANES = 8; //# independent partial sums per block
+
+// a + b for two (sum, error) pairs
+template<class T>
+inline std::array<T,2> FastDotAdd( const std::array<T,2>& a, const std::array<T,2>& b)
+{
+    T e;
+    T s = KnuthTwoSum( a[0], b[0], e);
+    return {s, a[1] + b[1] + e};
+}
+
+// Compensated sum of f(xs[i]...) for i in [begin, end) with end-begin <= FASTDOT_BLOCK
+// Element i is summed into lane i%FASTDOT_LANES (the lanes vectorize)
+// and the lanes are combined in a fixed pairwise tree
+template<class T, class Functor, class ...PointerOrValues>
+inline std::array<T,2> FastDotBlock( unsigned begin, unsigned end, Functor f, PointerOrValues ...xs_ptr)
+{
+    T s[FASTDOT_LANES], c[FASTDOT_LANES];
+    for( unsigned k=0; k<FASTDOT_LANES; k++)
+        s[k] = c[k] = T(0);
+    unsigned i = begin;
+    for( ; i+FASTDOT_LANES <= end; i+=FASTDOT_LANES)
+    {
+        for( unsigned k=0; k<FASTDOT_LANES; k++)
+        {
+            T e;
+            s[k] = KnuthTwoSum( s[k], T(f( get_element( xs_ptr, i+k)...)), e);
+            c[k] += e;
+        }
+    }
+    for( unsigned k=0; i<end; i++, k++)
+    {
+        T e;
+        s[k] = KnuthTwoSum( s[k], T(f( get_element( xs_ptr, i)...)), e);
+        c[k] += e;
+    }
+    for( unsigned w=1; w<FASTDOT_LANES; w*=2)
+        for( unsigned k=0; k<FASTDOT_LANES; k+=2*w)
+        {
+            T e;
+            s[k] = KnuthTwoSum( s[k], s[k+w], e);
+            c[k] += c[k+w] + e;
+        }
+    return {s[0], c[0]};
+}
+
+// Combine the block results in a fixed pairwise tree (overwrites blocks)
+template<class T>
+inline std::array<T,2> FastDotTree( std::vector<std::array<T,2>>& blocks)
+{
+    if( blocks.empty())
+        return {T(0), T(0)};
+    unsigned n = blocks.size();
+    while( n > 1)
+    {
+        for( unsigned u=0; u<n/2; u++)
+            blocks[u] = FastDotAdd( blocks[2*u], blocks[2*u+1]);
+        if( n%2 == 1)
+            blocks[n/2] = blocks[n-1];
+        n = (n+1)/2;
+    }
+    return blocks[0];
+}
+}//namespace cpu
+///@endcond
+
+/*!@brief serial version of fast reproducible general dot product
+ *
+ * Computes the reduction \f[ \sum_{i=0}^{N-1} f(x_{0i}, x_{1i}, ... )\f]
+ * with compensated summation in a fixed pairwise shape: the elements are
+ * summed in blocks of 1024 (with 8 interleaved partial sums per block) and the
+ * block sums are combined in a binary tree. The shape depends only on the
+ * size of the arrays and not on the number of threads, so the result is
+ * binary reproducible for a given size, but it is not the exactly rounded sum.
+ * The error is that of a compensated sum i.e. the relative error is of order
+ * machine precision plus the condition number of the sum times machine
+ * precision squared.
+ * @tparam T the return type of \c Functor.
+ * @tparam N size of the floating point expansion (at least 2)
+ * @tparam Functor a Functor
+ * @tparam PointerOrValues must be one of <tt> T, T&&, T&, const T&, T* or const T* </tt>, where \c T is a scalar type. If it is a pointer type,
+ *  then we iterate through the pointed data from 0 to \c size, else we consider the value constant in every iteration.
+ * @param status unused (kept for the same interface as \c fpedot_cpu)
+ * @param size size of the arrays to sum
+ * @param fpe the sum in \c fpe[0] and the error in \c fpe[1] (write-only)
+ * @param f the functor
+ * @param xs_ptr the input arrays to sum
+ * @sa \c exblas::cpu::Round  to convert the FPE into a double precision number
+*/
+template<class T, size_t N, class Functor, class ...PointerOrValues>
+void fastdot_cpu(int * status, unsigned size, std::array<T,N>& fpe, Functor f, PointerOrValues ...xs_ptr)
+{
+    static_assert( N >= 2, "FPE for fastdot must have at least 2 elements");
+    unsigned num_blocks = (size + cpu::FASTDOT_BLOCK - 1)/cpu::FASTDOT_BLOCK;
+    std::vector<std::array<T,2>> blocks( num_blocks);
+    for( unsigned b=0; b<num_blocks; b++)
+        blocks[b] = cpu::FastDotBlock<T>( b*cpu::FASTDOT_BLOCK,
+            std::min( (b+1)*cpu::FASTDOT_BLOCK, size), f, xs_ptr...);
+    std::array<T,2> result = cpu::FastDotTree( blocks);
+    fpe[0] = result[0];
+    fpe[1] = result[1];
+    for( unsigned i=2; i<N; i++)
+        fpe[i] = T(0);
+}
+
+
+}//namespace exblas
+} //namespace dg
@@ -16,6 +16,9 @@
 #include <cstdio>
 #include <cmath>
 #include <iostream>
+#include <array>
+#include <vector>
+#include <utility>
 
 #include <omp.h>
 #include "accumulate.h"
@@ -64,13 +67,9 @@ template<class T, size_t N, class Functor, class ...PointerOrValues>
 void fpedot_omp(int * status, unsigned size, std::array<T,N>& fpe, Functor f, PointerOrValues ...xs_ptr)
 {
     // OpenMP sum+reduction
-    int maxthreads = omp_get_max_threads();
-    std::vector<std::array<T, N>> acc(maxthreads);
-    std::vector<int> status_i( maxthreads, 0);
-    #pragma omp parallel
+    auto thread_work = [&]( unsigned int tid, unsigned int tnum,
+        std::vector<std::array<T,N>>& acc, std::vector<int>& status_i)
     {
-        unsigned int tid = omp_get_thread_num();
-        unsigned int tnum = omp_get_num_threads();
         std::array<T,N> & myacc = acc[tid];
         int l = tid * size / tnum;
         int r = ((tid+1) * size / tnum)  - 1;
@@ -83,17 +82,52 @@ void fpedot_omp(int * status, unsigned size, std::array<T,N>& fpe, Functor f, Po
             // std::isfinite does not work for complex
             //if( !std::isfinite(res) ) *status = 1;
         }
-        cpu::Reduction<T,N>( tid, tnum, acc, status);
-    }//omp parallel
-    for( uint i=0; i<N; i++)
-        fpe[i] = acc[0][i];
-    for( int i=0; i<maxthreads; i++)
+        cpu::Reduction<T,N>( tid, tnum, acc, &status_i[tid]);
+    };
+    auto result = [&]( const std::vector<std::array<T,N>>& acc,
+        const std::vector<int>& status_i)
     {
-        if( status_i[i] == 2) *status = 2;
-        if( status_i[i] == 1) *status = 1;
+        for( uint i=0; i<N; i++)
+            fpe[i] = acc[0][i];
+        for( unsigned i=0; i<status_i.size(); i++)
+        {
+            if( status_i[i] == 2) *status = 2;
+            if( status_i[i] == 1) *status = 1;
+        }
+    };
+    if( !omp_in_parallel())
+    {
+        int maxthreads = omp_get_max_threads();
+        std::vector<std::array<T, N>> acc(maxthreads);
+        std::vector<int> status_i( maxthreads, 0);
+        #pragma omp parallel
+        {
+            thread_work( omp_get_thread_num(), omp_get_num_threads(), acc,
+                status_i);
+        }//omp parallel
+        result( acc, status_i);
+        return;
     }
+    // Called by all threads of an enclosing parallel region (s.a. dg::OmpTag):
+    // the buffers are shared by the team and every thread receives the result
+    using Buffer = std::pair<std::vector<std::array<T,N>>, std::vector<int>>;
+    // The buffer of the thread executing the single region is shared
+    // (it lives until after the last barrier)
+    Buffer buffer;
+    Buffer* buf;
+    unsigned int tnum = omp_get_num_threads();
+    // the implicit barrier guarantees that all threads finished writing the input
+    #pragma omp single copyprivate(buf)
+    {
+        buffer.first.resize( tnum);
+        buffer.second.assign( tnum, 0);
+        buf = &buffer;
+    }
+    thread_work( omp_get_thread_num(), tnum, buf->first, buf->second);
+    #pragma omp barrier
+    result( buf->first, buf->second);
+    #pragma omp barrier
 }
 
-
 }//namespace exblas
 } //namespace dg
@@ -182,11 +182,10 @@ inline bool horizontal_or(vcl::Vec8d const & a) {
     return vcl::horizontal_or( p);
     //return !_mm512_testz_pd(p, p);
 }
-#else
+#endif//_WITHOUT_VCL
 inline bool horizontal_or( const double & a){
     return a!= 0;
 }
-#endif//_WITHOUT_VCL
 
 
 }//namespace cpu
@@ -0,0 +1,146 @@
+/**
+ *  @file vec8d.h
+ *  @brief Portable vector of 8 doubles for the floating point expansions
+ *
+ *  Used instead of \c vcl::Vec8d when the vector class library is not
+ *  available (\c _WITHOUT_VCL). All operations are written as loops over
+ *  the 8 lanes that the compiler vectorizes for the available instruction
+ *  set (SSE, AVX2, AVX-512 or NEON). Since each lane is computed with
+ *  the same IEEE operations as the scalar code the results are bitwise
+ *  identical to the \c vcl::Vec8d and the scalar version.
+ */
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _OPENMP
+#define EXBLAS_SIMD _Pragma("omp simd")
+#else
+#define EXBLAS_SIMD
+#endif//_OPENMP
+
+namespace dg
+{
+namespace exblas{
+namespace cpu{
+///@cond
+
+// The result of a comparison of two Vec8d
+struct Vec8db
+{
+    bool v[8];
+};
+
+// Same interface as the (parts of) vcl::Vec8d that we use
+struct Vec8d
+{
+    Vec8d() = default;
+    Vec8d( double x){
+        EXBLAS_SIMD
+        for( int k=0; k<8; k++)
+            v[k] = x;
+    }
+    Vec8d( double x0, double x1, double x2, double x3,
+           double x4, double x5, double x6, double x7)
+        : v{x0,x1,x2,x3,x4,x5,x6,x7}{}
+    Vec8d& load( const double* p){
+        EXBLAS_SIMD
+        for( int k=0; k<8; k++)
+            v[k] = p[k];
+        return *this;
+    }
+    Vec8d& load_a( const double* p){ return load(p);}
+    // load the first n elements and set the rest to zero
+    Vec8d& load_partial( int n, const double* p){
+        for( int k=0; k<8; k++)
+            v[k] = k < n ? p[k] : 0.;
+        return *this;
+    }
+    // set all but the first n elements to zero
+    Vec8d& cutoff( int n){
+        for( int k=n; k<8; k++)
+            v[k] = 0.;
+        return *this;
+    }
+    void store( double* p) const{
+        EXBLAS_SIMD
+        for( int k=0; k<8; k++)
+            p[k] = v[k];
+    }
+    void store_a( double* p) const{ store(p);}
+    double operator[]( int k) const{ return v[k];}
+    double v[8];
+};
+
+inline Vec8d operator+( const Vec8d& a, const Vec8d& b){
+    Vec8d r;
+    EXBLAS_SIMD
+    for( int k=0; k<8; k++)
+        r.v[k] = a.v[k] + b.v[k];
+    return r;
+}
+inline Vec8d operator-( const Vec8d& a, const Vec8d& b){
+    Vec8d r;
+    EXBLAS_SIMD
+    for( int k=0; k<8; k++)
+        r.v[k] = a.v[k] - b.v[k];
+    return r;
+}
+inline Vec8d operator*( const Vec8d& a, const Vec8d& b){
+    Vec8d r;
+    EXBLAS_SIMD
+    for( int k=0; k<8; k++)
+        r.v[k] = a.v[k] * b.v[k];
+    return r;
+}
+inline Vec8d abs( const Vec8d& a){
+    Vec8d r;
+    EXBLAS_SIMD
+    for( int k=0; k<8; k++)
+        r.v[k] = std::fabs( a.v[k]);
+    return r;
+}
+inline Vec8db operator<( const Vec8d& a, const Vec8d& b){
+    Vec8db r;
+    EXBLAS_SIMD
+    for( int k=0; k<8; k++)
+        r.v[k] = a.v[k] < b.v[k];
+    return r;
+}
+inline Vec8db is_finite( const Vec8d& a){
+    Vec8db r;
+    EXBLAS_SIMD
+    for( int k=0; k<8; k++)
+        r.v[k] = a.v[k] - a.v[k] == 0; // false for Inf and NaN
+    return r;
+}
+inline bool horizontal_and( const Vec8db& a){
+    bool r = true;
+    for( int k=0; k<8; k++)
+        r &= a.v[k];
+    return r;
+}
+inline bool horizontal_or( const Vec8db& a){
+    bool r = false;
+    for( int k=0; k<8; k++)
+        r |= a.v[k];
+    return r;
+}
+// true if any element is non-zero (on the bits without sign bit such that
+// it vectorizes)
+inline bool horizontal_or( const Vec8d& a){
+    uint64_t r = 0;
+    EXBLAS_SIMD
+    for( int k=0; k<8; k++)
+    {
+        uint64_t u;
+        std::memcpy( &u, &a.v[k], 8);
+        r |= u << 1;
+    }
+    return r != 0;
+}
+///@endcond
+}//namespace cpu
+}//namespace exblas
+} //namespace dg
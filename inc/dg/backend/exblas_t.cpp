@@ -0,0 +1,188 @@
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "exblas/exblas.h"
+
+#include "catch2/catch_all.hpp"
+
+// The floating point expansion of the exact dot product exists in a
+// scalar version and with 8 wide vectors (vcl::Vec8d if available and the
+// portable cpu::Vec8d). All versions must give bitwise identical results.
+
+template<class Vec, class ...PointerOrValues>
+double exdot( int size, PointerOrValues ... xs)
+{
+    using namespace dg::exblas;
+    std::vector<int64_t> acc( BIN_COUNT, 0);
+    bool error = false;
+    cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<Vec, 8, cpu::FPExpansionTraits<true>
+        > >( size, xs..., &acc[0], &error);
+    CHECK( !error);
+    return cpu::Round( &acc[0]);
+}
+
+TEST_CASE( "Exact dot product is bitwise equal across vector types")
+{
+    using namespace dg::exblas;
+    // numbers of vastly different magnitude and sign
+    std::mt19937 gen( 42);
+    std::uniform_real_distribution<double> mantissa( -1., 1.);
+    std::uniform_int_distribution<int> exponent( -40, 40);
+    // not a multiple of 8 such that the remainder is tested
+    const unsigned size = 1003;
+    std::vector<double> x( size), y( size), w( size);
+    std::vector<float> f( size);
+    for( unsigned i=0; i<size; i++)
+    {
+        x[i] = std::ldexp( mantissa( gen), exponent( gen));
+        y[i] = std::ldexp( mantissa( gen), exponent( gen));
+        w[i] = std::ldexp( mantissa( gen), exponent( gen)/4);
+        f[i] = (float)mantissa( gen);
+    }
+    // Reference: accumulate every product directly into the superaccumulator
+    std::vector<int64_t> acc2( BIN_COUNT, 0), acc3( BIN_COUNT, 0);
+    for( unsigned i=0; i<size; i++)
+    {
+        cpu::Accumulate( &acc2[0], x[i]*y[i]);
+        cpu::Accumulate( &acc3[0], (x[i]*w[i])*y[i]);
+    }
+    udouble ref2, ref3;
+    ref2.d = cpu::Round( &acc2[0]);
+    ref3.d = cpu::Round( &acc3[0]);
+    INFO( "Reference "<<ref2.d<<" "<<ref3.d);
+    udouble res;
+    SECTION( "Scalar expansion")
+    {
+        res.d = exdot<double>( size, &x[0], &y[0]);
+        CHECK( res.i == ref2.i);
+        res.d = exdot<double>( size, &x[0], &w[0], &y[0]);
+        CHECK( res.i == ref3.i);
+    }
+    SECTION( "Portable vector expansion")
+    {
+        res.d = exdot<cpu::Vec8d>( size, &x[0], &y[0]);
+        CHECK( res.i == ref2.i);
+        res.d = exdot<cpu::Vec8d>( size, &x[0], &w[0], &y[0]);
+        CHECK( res.i == ref3.i);
+    }
+#ifndef _WITHOUT_VCL
+    SECTION( "VCL vector expansion")
+    {
+        res.d = exdot<vcl::Vec8d>( size, &x[0], &y[0]);
+        CHECK( res.i == ref2.i);
+        res.d = exdot<vcl::Vec8d>( size, &x[0], &w[0], &y[0]);
+        CHECK( res.i == ref3.i);
+    }
+#endif //_WITHOUT_VCL
+    SECTION( "Default version")
+    {
+        std::vector<int64_t> acc( BIN_COUNT);
+        int status = 0;
+        exdot_cpu( size, &x[0], &y[0], &acc[0], &status);
+        CHECK( status == 0);
+        res.d = cpu::Round( &acc[0]);
+        CHECK( res.i == ref2.i);
+        exdot_cpu( size, &x[0], &w[0], &y[0], &acc[0], &status);
+        CHECK( status == 0);
+        res.d = cpu::Round( &acc[0]);
+        CHECK( res.i == ref3.i);
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP
+        for( int threads : {1, 3, 4})
+        {
+            INFO( "Number of threads "<<threads);
+            omp_set_num_threads( threads);
+            exdot_omp( size, &x[0], &y[0], &acc[0], &status);
+            CHECK( status == 0);
+            res.d = cpu::Round( &acc[0]);
+            CHECK( res.i == ref2.i);
+            exdot_omp( size, &x[0], &w[0], &y[0], &acc[0], &status);
+            CHECK( status == 0);
+            res.d = cpu::Round( &acc[0]);
+            CHECK( res.i == ref3.i);
+        }
+#endif //THRUST_DEVICE_SYSTEM
+    }
+    SECTION( "Floats and constant values")
+    {
+        // the remainder of a constant value must not count 8 times
+        udouble scalar;
+        scalar.d = exdot<double>( size, &f[0], 2.);
+        res.d = exdot<cpu::Vec8d>( size, &f[0], 2.);
+        CHECK( res.i == scalar.i);
+        scalar.d = exdot<double>( size, 3., 2.);
+        res.d = exdot<cpu::Vec8d>( size, 3., 2.);
+        CHECK( res.i == scalar.i);
+        CHECK( res.d == 6.*size);
+    }
+    SECTION( "NaN and Inf are detected")
+    {
+        x[size-1] = std::nan("");
+        std::vector<int64_t> acc( BIN_COUNT);
+        int status = 0;
+        exdot_cpu( size, &x[0], &y[0], &acc[0], &status);
+        CHECK( status == 1);
+        x[size-1] = 1.;
+        x[3] = std::numeric_limits<double>::infinity();
+        exdot_cpu( size, &x[0], &w[0], &y[0], &acc[0], &status);
+        CHECK( status == 1);
+    }
+}
+
+TEST_CASE( "Fast dot product is reproducible")
+{
+    using namespace dg::exblas;
+    std::mt19937 gen( 42);
+    std::uniform_real_distribution<double> dist( -1., 1.);
+    // several blocks and a remainder
+    const unsigned size = 10*1024+13;
+    std::vector<double> x( size), y( size);
+    for( unsigned i=0; i<size; i++)
+    {
+        x[i] = dist( gen);
+        y[i] = dist( gen);
+    }
+    std::vector<int64_t> acc( BIN_COUNT);
+    int status = 0;
+    exdot_cpu( size, &x[0], &y[0], &acc[0], &status);
+    double exact = cpu::Round( &acc[0]);
+    auto product = []( double a, double b){ return a*b;};
+    std::array<double,2> fpe;
+    fastdot_cpu( &status, size, fpe, product, &x[0], &y[0]);
+    udouble ref;
+    ref.d = fpe[0] + fpe[1];
+    INFO( "Exact "<<exact<<" fast "<<ref.d);
+    CHECK( fabs( ref.d - exact) <= 1e-15*fabs(exact));
+    SECTION( "Constant values")
+    {
+        fastdot_cpu( &status, size, fpe, product, 3., &y[0]);
+        double sum = 3.*exdot<double>( size, 1., &y[0]);
+        CHECK( fabs( fpe[0] + fpe[1] - sum) <= 1e-15*fabs(sum));
+        fastdot_cpu( &status, 5, fpe, product, 3., 2.);
+        CHECK( fpe[0] == 30.);
+    }
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP
+    SECTION( "Independent of number of threads")
+    {
+        udouble res;
+        for( int threads : {1, 3, 4})
+        {
+            INFO( "Number of threads "<<threads);
+            omp_set_num_threads( threads);
+            fastdot_omp( &status, size, fpe, product, &x[0], &y[0]);
+            res.d = fpe[0] + fpe[1];
+            CHECK( res.i == ref.i);
+            // called by all threads of a parallel region
+            #pragma omp parallel
+            {
+                std::array<double,2> fpe_t;
+                fastdot_omp( &status, size, fpe_t, product, &x[0], &y[0]);
+                udouble res_t;
+                res_t.d = fpe_t[0] + fpe_t[1];
+                #pragma omp critical
+                CHECK( res_t.i == ref.i);
+            }
+        }
+    }
+#endif //THRUST_DEVICE_SYSTEM
+}
@@ -25,7 +25,49 @@ struct NoPolicyTag{};
  */
 struct SerialTag    : public AnyPolicyTag{};
 struct CudaTag      : public AnyPolicyTag{};//!< CUDA implementation
-struct OmpTag       : public AnyPolicyTag{};//!< OpenMP parallel execution
+/**
+ * @brief OpenMP parallel execution
+ *
+ * By default every \c dg::blas1 and \c dg::blas2 call opens its own
+ * parallel region. Alternatively, the user may open one parallel region
+ * around a sequence of \c dg::blas1 and \c dg::blas2 calls, which all
+ * threads of the team execute:
+ * @code{.cpp}
+#pragma omp parallel
+{
+    // blas functions detect the enclosing region via omp_in_parallel()
+    // and distribute their work among the existing team
+    dg::blas2::symv( derivative, x, y);
+    dg::blas1::axpby( 1., y, -dt, x);
+    double norm = dg::blas1::dot( x, x); // same on all threads
+}
+ * @endcode
+ * This avoids the fork/join overhead of one parallel region per call. In
+ * this mode
+ *  - elementwise \c dg::blas1 functions use a static schedule without barrier, i.e.
+ *  each thread always works on the same part of a vector of given size (which
+ *  is also beneficial on NUMA systems)
+ *  - the inner vectors of recursive vectors are partitioned separately
+ *  - matrix-vector multiplications, stencils, \c dg::blas1::kronecker, dot
+ *  products and reductions synchronize the team before and (if necessary) after
+ *  they execute; the results of dot products and reductions are available on all threads
+ *  .
+ * @attention Only \c dg::blas1 and \c dg::blas2 functions support this mode.
+ * Higher level classes like time steppers and solvers keep non-vector state
+ * (step sizes, counters, swapped buffers) that every thread would update, so
+ * they must be called outside of the parallel region.
+ * @attention The results of \c dg::blas1::dot are exact and thus the same in
+ * both modes. \c dg::blas1::reduce combines the partial results in a different
+ * order, so for non-associative operations (e.g. a floating point sum) the
+ * result may differ in the last bits from the one outside the parallel region.
+ * @attention All threads must call the same \c dg functions with
+ * the same arguments in the same order. Code that accesses vectors elementwise
+ * outside of \c dg functions or accesses the same memory through vectors of different
+ * sizes (e.g. a view of a part of a vector) must synchronize with
+ * <tt> \#pragma omp barrier </tt>. Input/Output and MPI communication must be
+ * done outside of the parallel region or by a single thread.
+ */
+struct OmpTag       : public AnyPolicyTag{};
 
 
 }//namespace dg
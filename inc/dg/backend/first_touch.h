@@ -0,0 +1,59 @@
+#pragma once
+
+#include <thrust/host_vector.h>
+#include <thrust/device_vector.h>
+#include "execution_policy.h"
+#include "tensor_traits.h"
+#include "tensor_traits_thrust.h"
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP
+#include <omp.h>
+#endif
+
+///@cond
+namespace dg
+{
+namespace detail
+{
+/* Assign the content of a contiguous container to a thrust vector
+ *
+ * With the OpenMP device the pages of \c to are placed (first touched) and
+ * written with a static schedule, i.e. by the same thread that later works on
+ * them in the blas1 and EllSparseBlockMat kernels. On NUMA systems this places
+ * each part of the vector in the memory of the socket that uses it.
+ * (thrust::copy from host memory and the vector assign member
+ * write the whole vector from a single thread)
+ * @param from a container with \c data() and \c size() (e.g. host_vector,
+ *  std::vector or device_vector)
+ * @param to (resized if necessary)
+ */
+template<class From, class To>
+void assign_first_touch( const From& from, To& to)
+{
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP
+    if constexpr( std::is_same_v<get_execution_policy<To>, OmpTag>)
+    {
+        if( !omp_in_parallel())
+        {
+            if( to.size() != from.size())
+            {
+                // the thrust OpenMP backend value-initializes new memory in a
+                // parallel loop with the default (static) schedule
+                To tmp( from.size());
+                to.swap( tmp);
+            }
+            auto to_ptr = thrust::raw_pointer_cast( to.data());
+            auto from_ptr = thrust::raw_pointer_cast( from.data());
+            int size = from.size();
+            #pragma omp parallel for schedule(static)
+            for( int i=0; i<size; i++)
+                to_ptr[i] = from_ptr[i];
+            return;
+        }
+    }
+#endif //THRUST_DEVICE_SYSTEM
+    to.assign( from.begin(), from.end());
+}
+
+}//namespace detail
+}//namespace dg
+///@endcond
@@ -9,6 +9,7 @@
 #include "tensor_traits.h"
 #include "memory.h"
 #include "index.h"
+#include "profile.h"
 
 namespace dg{
 
@@ -320,6 +321,7 @@ struct MPIContiguousGather
         bool self_communication = true) const
     {
         // TODO only works if m_recvMsg is non-overlapping
+        DG_PROFILE_REGION( "mpi::gather_init");
         using value_type = dg::get_value_type<ContainerType0>;
         static_assert( std::is_same_v<value_type,
                 get_value_type<ContainerType1>>);
@@ -409,6 +411,7 @@ struct MPIContiguousGather
     template<class ContainerType>
     void global_gather_wait( ContainerType& buffer) const
     {
+        DG_PROFILE_REGION( "mpi::gather_wait");
         using value_type = dg::get_value_type<ContainerType>;
         MPI_Waitall( m_rqst.size(), &m_rqst[0], MPI_STATUSES_IGNORE );
         if constexpr (dg::has_policy_v<ContainerType, dg::CudaTag>
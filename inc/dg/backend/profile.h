@@ -0,0 +1,570 @@
+#pragma once
+
+/*! @file
+ * @brief Scoped profiling regions (enabled with the \c DG_PROFILE macro)
+ */
+
+/**
+ * @addtogroup profiling
+ * @{
+ * @def DG_PROFILE_REGION(name)
+ * @brief Time the enclosing scope as the profiling region \c name
+ *
+ * Expands to a \c dg::profile::Region variable if the macro \c DG_PROFILE
+ * is defined (e.g. compile with \c -DDG_PROFILE) and to nothing otherwise,
+ * i.e. profiling is compiled out entirely by default.
+ * @code{.cpp}
+void rhs( double t, const Vector& y, Vector& yp)
+{
+    DG_PROFILE_REGION( "rhs");
+    {
+        DG_PROFILE_REGION( "rhs::poisson"); // nested in "rhs"
+        ...
+    }
+}
+ * @endcode
+ * @param name a string literal (only the pointer is stored)
+ *
+ * @def DG_PROFILE_TRAFFIC(bytes, flops)
+ * @brief Add memory traffic and floating point operations to the innermost
+ * open profiling region
+ *
+ * Expands to \c dg::profile::add_traffic if \c DG_PROFILE is defined and to
+ * nothing otherwise (the arguments are not evaluated).
+ * @param bytes number of bytes read plus written
+ * @param flops number of floating point operations
+ * @}
+ */
+#ifdef DG_PROFILE
+#define DG_PROFILE_CONCAT_( a, b) a##b
+#define DG_PROFILE_CONCAT( a, b) DG_PROFILE_CONCAT_( a, b)
+#define DG_PROFILE_REGION( name) \
+    dg::profile::Region DG_PROFILE_CONCAT( _dg_profile_region_, __LINE__)( name)
+#define DG_PROFILE_TRAFFIC( bytes, flops) \
+    dg::profile::add_traffic( bytes, flops)
+#else
+#define DG_PROFILE_REGION( name)
+#define DG_PROFILE_TRAFFIC( bytes, flops)
+#endif // DG_PROFILE
+
+#ifdef DG_PROFILE
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "thrust/device_vector.h"
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
+#include <cuda_runtime.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if defined DG_PROFILE_PERF && defined __linux__
+#define DG_PROFILE_HAS_PERF
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dg
+{
+/**
+ * @brief Scoped, hierarchical profiling
+ *
+ * Each thread accumulates the time spent in named, nested regions
+ * (opened with \c DG_PROFILE_REGION) in its own call tree, so there is
+ * neither locking nor any \c MPI_Barrier involved in opening or closing a
+ * region. The library itself defines regions around \c dg::blas1,
+ * \c dg::blas2 and \c dg::exblas kernels, MPI gather operations, \c dg::PCG
+ * and the stages of \c dg::MultigridCG2d.
+ *
+ * At program end a summary table is written to \c std::cout (on rank 0
+ * only) and a trace of the regions in Chrome trace format
+ * (open in \c chrome://tracing or \c https://ui.perfetto.dev) is written to
+ * the file named by the environment variable \c DG_PROFILE_TRACE
+ * (with MPI the rank is appended to the file name).
+ * @note With CUDA kernels execute asynchronously and regions measure host
+ * time only. Define \c DG_PROFILE_SYNC to synchronize the device at the end
+ * of each region.
+ * @note Only the outermost of directly nested regions with the same name
+ * is recorded, such that recursive calls (e.g. blas1 on recursive vectors)
+ * count only once.
+ *
+ * The \c dg::blas1 and \c dg::blas2 kernels report the bytes they move and the
+ * floating point operations they execute (computed from vector sizes and
+ * matrix dimensions, i.e. \c n, \c blocks_per_line or the number of non-zeros).
+ * The summary then contains a second table with the achieved GB/s and
+ * GFlop/s per kernel type, which can be compared to the memory bandwidth
+ * (e.g. from \c stream_b) to see if a kernel runs at the roofline.
+ * Non-const vector arguments count as read and written
+ * (which is what happens on CPUs with write-allocate caches).
+ *
+ * On Linux define \c DG_PROFILE_PERF to additionally read the hardware
+ * counters for cycles, instructions and last level cache misses with
+ * \c perf_event_open for every region (this costs a system call per region and counter
+ * read and requires \c /proc/sys/kernel/perf_event_paranoid \c <= 2).
+ * The kernel table then shows the instructions per cycle and the DRAM
+ * bandwidth estimated from cache misses (64 bytes per miss).
+ * @ingroup profiling
+ */
+namespace profile
+{
+///@cond
+namespace detail
+{
+inline double wall_time()
+{
+    static const auto t0 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+struct Node
+{
+    Node( const char* name_, Node* parent_) : name(name_), parent(parent_){}
+    Node* child( const char* child_name)
+    {
+        for( auto& c : children)
+            if( c->name == child_name || std::strcmp( c->name, child_name) == 0)
+                return c.get();
+        children.push_back( std::make_unique<Node>( child_name, this));
+        return children.back().get();
+    }
+    const char* name;
+    Node* parent;
+    std::vector<std::unique_ptr<Node>> children;
+    unsigned long count = 0;
+    double total = 0., min = 1e300, max = 0.;
+    double bytes = 0., flops = 0.;
+    std::array<double,3> hw = {0.,0.,0.}; // cycles, instructions, cache misses
+};
+
+// Hardware counters of the calling thread
+struct PerfCounters
+{
+#ifdef DG_PROFILE_HAS_PERF
+    PerfCounters()
+    {
+        const unsigned long long config[3] = { PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+        for( unsigned i=0; i<3; i++)
+        {
+            perf_event_attr attr;
+            std::memset( &attr, 0, sizeof( attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof( attr);
+            attr.config = config[i];
+            attr.disabled = ( i == 0);
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            m_fd[i] = syscall( __NR_perf_event_open, &attr, 0, -1,
+                    i == 0 ? -1 : m_fd[0], 0);
+            if( m_fd[i] == -1)
+            {
+                close_all();
+                return;
+            }
+        }
+        ioctl( m_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl( m_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    ~PerfCounters(){ close_all();}
+    bool available() const { return m_fd[0] != -1;}
+    void read( std::array<double,3>& values) const
+    {
+        uint64_t buffer[4] = {0,0,0,0}; // nr, values
+        if( m_fd[0] == -1 ||
+            ::read( m_fd[0], buffer, sizeof( buffer)) != sizeof( buffer))
+            return;
+        for( unsigned i=0; i<3; i++)
+            values[i] = buffer[i+1];
+    }
+    private:
+    void close_all()
+    {
+        for( unsigned i=0; i<3; i++)
+        {
+            if( m_fd[i] != -1)
+                close( m_fd[i]);
+            m_fd[i] = -1;
+        }
+    }
+    int m_fd[3] = {-1,-1,-1};
+#else
+    PerfCounters() = default;
+    bool available() const { return false;}
+    void read( std::array<double,3>&) const{}
+#endif //DG_PROFILE_HAS_PERF
+    PerfCounters( const PerfCounters&) = delete;
+    PerfCounters& operator=( const PerfCounters&) = delete;
+};
+
+struct Event
+{
+    const char* name;
+    double start, duration;
+};
+
+struct ThreadData
+{
+    Node root = Node( "total", nullptr);
+    Node* current = &root;
+    std::vector<Event> events;
+    int tid = 0;
+    PerfCounters perf;
+};
+
+// Collects the data of all threads and reports at program end
+struct Registry
+{
+    static Registry& instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+    std::shared_ptr<ThreadData> add_thread()
+    {
+        std::lock_guard<std::mutex> lock( mutex);
+        if( threads.empty())
+        {
+            wall_time(); // start the clock
+#ifdef MPI_VERSION
+            int init;
+            MPI_Initialized( &init);
+            if( init)
+                MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+#endif //MPI_VERSION
+        }
+        threads.push_back( std::make_shared<ThreadData>());
+        threads.back()->tid = threads.size()-1;
+        return threads.back();
+    }
+    ~Registry();
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadData>> threads;
+    int rank = 0;
+    size_t max_events = 1000000; // per thread
+};
+
+inline ThreadData& thread_data()
+{
+    // the registry shares ownership so the data outlives the thread
+    thread_local std::shared_ptr<ThreadData> data =
+        Registry::instance().add_thread();
+    return *data;
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief RAII profiling region (use \c DG_PROFILE_REGION)
+ *
+ * Opens the region \c name as a child of the currently open region of the
+ * calling thread on construction and closes it on destruction
+ * @ingroup profiling
+ */
+struct Region
+{
+    /// @param name a string literal (only the pointer is stored)
+    explicit Region( const char* name) : m_data( detail::thread_data())
+    {
+        const char* current = m_data.current->name;
+        if( current == name || std::strcmp( current, name) == 0)
+            return; // recursive call
+        m_node = m_data.current->child( name);
+        m_data.current = m_node;
+        m_data.perf.read( m_hw);
+        m_start = detail::wall_time();
+    }
+    ~Region()
+    {
+        if( m_node == nullptr)
+            return;
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA && defined DG_PROFILE_SYNC
+        cudaDeviceSynchronize();
+#endif
+        double duration = detail::wall_time() - m_start;
+        std::array<double,3> hw = m_hw;
+        m_data.perf.read( hw);
+        for( unsigned i=0; i<3; i++)
+            m_node->hw[i] += hw[i] - m_hw[i];
+        m_node->count++;
+        m_node->total += duration;
+        m_node->min = std::min( m_node->min, duration);
+        m_node->max = std::max( m_node->max, duration);
+        if( m_data.events.size() < detail::Registry::instance().max_events)
+            m_data.events.push_back( {m_node->name, m_start, duration});
+        m_data.current = m_node->parent;
+    }
+    Region( const Region&) = delete;
+    Region& operator=( const Region&) = delete;
+    private:
+    detail::ThreadData& m_data;
+    detail::Node* m_node = nullptr;
+    double m_start = 0.;
+    std::array<double,3> m_hw = {0.,0.,0.};
+};
+
+/**
+ * @brief Add memory traffic and floating point operations to the innermost
+ * open region of the calling thread (use \c DG_PROFILE_TRAFFIC)
+ *
+ * Inside an OpenMP thread team (s.a. \c dg::OmpTag) only the master thread
+ * records, since all threads call the kernel on the whole vector.
+ * @param bytes number of bytes read plus written
+ * @param flops number of floating point operations
+ * @ingroup profiling
+ */
+inline void add_traffic( double bytes, double flops)
+{
+#ifdef _OPENMP
+    if( omp_in_parallel() && omp_get_thread_num() != 0)
+        return;
+#endif
+    detail::ThreadData& data = detail::thread_data();
+    data.current->bytes += bytes;
+    data.current->flops += flops;
+}
+
+///@cond
+namespace detail
+{
+struct Entry
+{
+    unsigned depth = 0;
+    unsigned long count = 0;
+    double total = 0., min = 1e300, max = 0., parent_total = 0.;
+    unsigned threads = 0;
+};
+struct Kernel
+{
+    unsigned long count = 0;
+    double time = 0., bytes = 0., flops = 0.;
+    std::array<double,3> hw = {0.,0.,0.};
+};
+// Sum the regions that report traffic by name
+inline void merge_kernels( const Node& node, std::vector<std::string>& order,
+    std::map<std::string, Kernel>& kernels)
+{
+    for( auto& c : node.children)
+    {
+        if( c->bytes > 0 || c->flops > 0)
+        {
+            if( kernels.count( c->name) == 0)
+                order.push_back( c->name);
+            Kernel& k = kernels[c->name];
+            k.count += c->count;
+            k.time += c->total;
+            k.bytes += c->bytes;
+            k.flops += c->flops;
+            for( unsigned i=0; i<3; i++)
+                k.hw[i] += c->hw[i];
+        }
+        merge_kernels( *c, order, kernels);
+    }
+}
+// Merge the trees of all threads by path (in order of first appearance)
+inline void merge( const Node& node, const std::string& path, unsigned depth,
+    double parent_total, std::vector<std::string>& order,
+    std::map<std::string, Entry>& entries)
+{
+    for( auto& c : node.children)
+    {
+        std::string p = path + "/" + c->name;
+        if( entries.count( p) == 0)
+            order.push_back( p);
+        Entry& e = entries[p];
+        e.depth = depth;
+        e.count += c->count;
+        e.total += c->total;
+        e.min = std::min( e.min, c->min);
+        e.max = std::max( e.max, c->max);
+        e.parent_total += parent_total;
+        e.threads ++;
+        merge( *c, p, depth+1, c->total, order, entries);
+    }
+}
+}//namespace detail
+///@endcond
+
+///@cond
+namespace detail
+{
+// take the registry as argument so that its destructor can call them
+inline void summary( Registry& registry, std::ostream& os)
+{
+    std::lock_guard<std::mutex> lock( registry.mutex);
+    double wall = wall_time();
+    std::vector<std::string> order;
+    std::map<std::string, Entry> entries;
+    for( auto& t : registry.threads)
+        merge( t->root, "", 0, wall, order, entries);
+    os << "# dg::profile summary (rank "<<registry.rank<<", "
+       << registry.threads.size()<<" thread(s), wall time "<<wall<<"s)\n";
+    os << std::left<<std::setw( 40)<<"region"<<std::right
+       <<std::setw(10)<<"calls"<<std::setw(12)<<"total[s]"
+       <<std::setw(12)<<"mean[ms]"<<std::setw(12)<<"min[ms]"
+       <<std::setw(12)<<"max[ms]"<<std::setw(8)<<"%"
+       <<std::setw(9)<<"threads"<<"\n";
+    for( auto& p : order)
+    {
+        const Entry& e = entries[p];
+        std::string name = std::string( 2*e.depth, ' ') +
+            p.substr( p.find_last_of( '/')+1);
+        os << std::left<<std::setw( 40)<<name<<std::right
+           << std::setw(10)<<e.count
+           << std::setw(12)<<std::setprecision(4)<<e.total
+           << std::setw(12)<<1e3*e.total/(double)e.count
+           << std::setw(12)<<1e3*e.min
+           << std::setw(12)<<1e3*e.max
+           << std::setw(8)<<std::setprecision(3)
+           << (e.parent_total > 0 ? 100.*e.total/e.parent_total : 0.)
+           << std::setw(9)<<e.threads<<"\n";
+    }
+    std::vector<std::string> kernel_order;
+    std::map<std::string, Kernel> kernels;
+    bool perf = false;
+    for( auto& t : registry.threads)
+    {
+        merge_kernels( t->root, kernel_order, kernels);
+        perf = perf || t->perf.available();
+    }
+    if( kernel_order.empty())
+        return;
+    os << "# dg::profile kernels (traffic computed from vector and matrix sizes)\n";
+    os << std::left<<std::setw( 40)<<"kernel"<<std::right
+       <<std::setw(10)<<"calls"<<std::setw(12)<<"total[s]"
+       <<std::setw(12)<<"GB"<<std::setw(12)<<"GB/s"
+       <<std::setw(12)<<"GFlop/s"<<std::setw(10)<<"Flop/B";
+    if( perf)
+        os <<std::setw(8)<<"IPC"<<std::setw(12)<<"LLC-GB/s";
+    os << "\n";
+    for( auto& name : kernel_order)
+    {
+        const Kernel& k = kernels[name];
+        os << std::left<<std::setw( 40)<<name<<std::right
+           << std::setw(10)<<k.count
+           << std::setw(12)<<std::setprecision(4)<<k.time
+           << std::setw(12)<<k.bytes/1e9
+           << std::setw(12)<<k.bytes/1e9/k.time
+           << std::setw(12)<<k.flops/1e9/k.time
+           << std::setw(10)<<std::setprecision(3)
+           << (k.bytes > 0 ? k.flops/k.bytes : 0.);
+        if( perf)
+            os << std::setw(8)<<(k.hw[0] > 0 ? k.hw[1]/k.hw[0] : 0.)
+               << std::setw(12)<<std::setprecision(4)<<64.*k.hw[2]/1e9/k.time;
+        os << "\n";
+    }
+#ifdef DG_PROFILE_HAS_PERF
+    if( !perf)
+        os << "# perf_event counters unavailable (check /proc/sys/kernel/perf_event_paranoid)\n";
+#endif //DG_PROFILE_HAS_PERF
+}
+
+inline void write_trace( Registry& registry, std::ostream& os)
+{
+    std::lock_guard<std::mutex> lock( registry.mutex);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    os << std::setprecision( 15);
+    for( auto& t : registry.threads)
+        for( auto& e : t->events)
+        {
+            if( !first)
+                os << ",";
+            first = false;
+            os << "\n{\"name\":\""<<e.name<<"\",\"cat\":\"dg\",\"ph\":\"X\","
+               << "\"ts\":"<<1e6*e.start<<",\"dur\":"<<1e6*e.duration
+               << ",\"pid\":"<<registry.rank<<",\"tid\":"<<t->tid<<"}";
+        }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Write a table of all regions recorded so far by the calling process
+ *
+ * Times are summed over all threads. The \c % column is the share of
+ * the parent region's time (or of the wall time since the first region for
+ * top level regions). A second table lists the memory bandwidth and
+ * floating point performance of all regions that report traffic
+ * (summed over all call sites)
+ * @param os output stream
+ * @ingroup profiling
+ */
+inline void summary( std::ostream& os)
+{
+    detail::summary( detail::Registry::instance(), os);
+}
+
+/**
+ * @brief Write all recorded regions in Chrome trace (JSON) format
+ *
+ * Each region call is a complete event (\c "ph":"X") with the MPI rank as
+ * \c pid and the thread number as \c tid. At most one million events per
+ * thread are recorded.
+ * @param os output stream
+ * @ingroup profiling
+ */
+inline void write_trace( std::ostream& os)
+{
+    detail::write_trace( detail::Registry::instance(), os);
+}
+
+/**
+ * @brief Discard all regions recorded so far
+ * @attention Must not be called while regions are open
+ * @ingroup profiling
+ */
+inline void reset()
+{
+    auto& registry = detail::Registry::instance();
+    std::lock_guard<std::mutex> lock( registry.mutex);
+    for( auto& t : registry.threads)
+    {
+        t->root.children.clear();
+        t->current = &t->root;
+        t->events.clear();
+    }
+}
+
+///@cond
+inline detail::Registry::~Registry()
+{
+    if( std::all_of( threads.begin(), threads.end(), []( const auto& t){
+            return t->root.children.empty();}))
+        return;
+    // the mutex is locked in summary and write_trace; do not call
+    // Registry::instance() here since the static is being destroyed
+    if( rank == 0)
+        detail::summary( *this, std::cout);
+    const char* trace = std::getenv( "DG_PROFILE_TRACE");
+    if( trace != nullptr)
+    {
+        std::string filename = trace;
+#ifdef MPI_VERSION
+        filename += "." + std::to_string( rank);
+#endif //MPI_VERSION
+        std::ofstream file( filename);
+        detail::write_trace( *this, file);
+    }
+}
+///@endcond
+
+}//namespace profile
+}//namespace dg
+#endif // DG_PROFILE
@@ -0,0 +1,134 @@
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// profiling is compiled out unless DG_PROFILE is defined
+#define DG_PROFILE
+#include "profile.h"
+#include "../blas1.h"
+
+#include "catch2/catch_all.hpp"
+
+void recursive( unsigned depth)
+{
+    DG_PROFILE_REGION( "recursive");
+    if( depth > 0)
+        recursive( depth-1);
+}
+
+TEST_CASE( "Profiling regions")
+{
+    dg::profile::reset();
+    SECTION( "Nested regions")
+    {
+        //! [profile]
+        for( unsigned u=0; u<3; u++)
+        {
+            DG_PROFILE_REGION( "outer");
+            for( unsigned k=0; k<2; k++)
+            {
+                DG_PROFILE_REGION( "inner");
+            }
+        }
+        std::stringstream ss;
+        dg::profile::summary( ss);
+        //! [profile]
+        INFO( ss.str());
+        std::string line;
+        unsigned outer = 0, inner = 0;
+        while( std::getline( ss, line))
+        {
+            std::stringstream ls( line);
+            std::string name;
+            unsigned long calls;
+            ls >> name >> calls;
+            if( name == "outer")
+            {
+                outer = calls;
+                // children are indented
+                CHECK( line.find( "outer") == 0);
+            }
+            if( name == "inner")
+            {
+                inner = calls;
+                CHECK( line.find( "inner") == 2);
+            }
+        }
+        CHECK( outer == 3);
+        CHECK( inner == 6);
+    }
+    SECTION( "Recursive calls are counted once")
+    {
+        recursive( 5);
+        std::stringstream ss;
+        dg::profile::summary( ss);
+        INFO( ss.str());
+        CHECK( ss.str().find( "  recursive") == std::string::npos);
+    }
+    SECTION( "Chrome trace")
+    {
+        {
+            DG_PROFILE_REGION( "trace");
+        }
+        std::stringstream ss;
+        dg::profile::write_trace( ss);
+        INFO( ss.str());
+        CHECK( ss.str().find( "\"traceEvents\"") != std::string::npos);
+        CHECK( ss.str().find( "{\"name\":\"trace\",\"cat\":\"dg\",\"ph\":\"X\"")
+                != std::string::npos);
+    }
+    SECTION( "Memory traffic")
+    {
+        {
+            DG_PROFILE_REGION( "kernel");
+            DG_PROFILE_TRAFFIC( 8e6, 1e6);
+        }
+        std::stringstream ss;
+        dg::profile::summary( ss);
+        INFO( ss.str());
+        std::string line;
+        bool found = false;
+        while( std::getline( ss, line))
+        {
+            std::stringstream ls( line);
+            std::string name;
+            unsigned long calls;
+            double total, gbytes;
+            ls >> name >> calls >> total >> gbytes;
+            // the kernel table lists the region a second time
+            if( name == "kernel" && !ls.fail() && gbytes == 8e-3)
+                found = true;
+        }
+        CHECK( found);
+    }
+    SECTION( "Memory traffic of recursive vectors")
+    {
+        // e.g. the state vectors of feltor
+        const std::array<thrust::device_vector<double>,2> x{
+            thrust::device_vector<double>( 1000, 1.),
+            thrust::device_vector<double>( 1000, 2.)};
+        std::array<thrust::device_vector<double>,2> y = x;
+        dg::blas1::subroutine( []( double a, double& b){ b += a;}, x, y);
+        std::stringstream ss;
+        dg::profile::summary( ss);
+        INFO( ss.str());
+        std::string line;
+        bool found = false;
+        while( std::getline( ss, line))
+        {
+            std::stringstream ls( line);
+            std::string name;
+            unsigned long calls;
+            double total, gbytes;
+            ls >> name >> calls >> total >> gbytes;
+            // 2000 elements, x is read (8 bytes), y read and written (16 bytes)
+            if( name == "blas1::subroutine" && !ls.fail()
+                && fabs( gbytes - 4.8e-5) < 1e-12)
+                found = true;
+        }
+        CHECK( found);
+    }
+    dg::profile::reset();
+}
@@ -7,6 +7,8 @@
 #include "config.h"
 #include "exceptions.h"
 #include "tensor_traits.h"
+#include "first_touch.h"
+#include "profile.h"
 #include "sparsematrix.h"
 
 namespace dg
@@ -85,7 +87,9 @@ struct EllSparseBlockMat
     EllSparseBlockMat( const EllSparseBlockMat<other_real_type, Other_Vector>& src)
     {
         data = src.data;
-        cols_idx = src.cols_idx, data_idx = src.data_idx;
+        // the index arrays are read row by row in the omp kernels
+        detail::assign_first_touch( src.cols_idx, cols_idx);
+        detail::assign_first_touch( src.data_idx, data_idx);
         num_rows = src.num_rows, num_cols = src.num_cols, blocks_per_line = src.blocks_per_line;
         n = src.n, left_size = src.left_size, right_size = src.right_size;
         right_range = src.right_range;
@@ -107,6 +111,21 @@ struct EllSparseBlockMat
      */
     dg::SparseMatrix<int, real_type, thrust::host_vector> asCuspMatrix() const;
 
+    ///@cond
+    // memory traffic and floating point operations of symv (for dg::profile)
+    template<class value_type>
+    double symv_bytes( value_type beta) const
+    {
+        return sizeof(value_type)*( (double)total_num_cols() +
+                (beta == value_type(0) ? 1. : 2.)*total_num_rows())
+            + sizeof(int)*( (double)cols_idx.size() + data_idx.size())
+            + sizeof(real_type)*(double)data.size();
+    }
+    double symv_flops() const {
+        return 2.*total_num_rows()*n*blocks_per_line;
+    }
+    ///@endcond
+
     /**
     * @brief Apply the matrix to a vector
     *
@@ -120,17 +139,23 @@ struct EllSparseBlockMat
     template<class value_type>
     void symv(SharedVectorTag, SerialTag, value_type alpha, const value_type* RESTRICT x, value_type beta, value_type* RESTRICT y) const
     {
+        DG_PROFILE_REGION( "EllSparseBlockMat::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         launch_multiply_kernel( SerialTag(), alpha, x, beta, y);
     }
     template<class value_type>
     void symv(SharedVectorTag, CudaTag, value_type alpha, const value_type* x, value_type beta, value_type* y) const
     {
+        DG_PROFILE_REGION( "EllSparseBlockMat::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         launch_multiply_kernel( CudaTag(), alpha, x, beta, y);
     }
 #ifdef _OPENMP
     template<class value_type>
     void symv(SharedVectorTag, OmpTag, value_type alpha, const value_type* x, value_type beta, value_type* y) const
     {
+        DG_PROFILE_REGION( "EllSparseBlockMat::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         if( !omp_in_parallel())
         {
             #pragma omp parallel
@@ -139,7 +164,11 @@ struct EllSparseBlockMat
             }
             return;
         }
+        // in a thread team x may have been written by other threads and y
+        // is partitioned differently than in blas1 (s.a. dg::OmpTag)
+        #pragma omp barrier
         launch_multiply_kernel( OmpTag(), alpha, x, beta, y);
+        #pragma omp barrier
     }
 #endif //_OPENMP
 
@@ -293,6 +322,21 @@ struct CooSparseBlockMat
 
 
 
+    ///@cond
+    // memory traffic and floating point operations of symv (for dg::profile)
+    template<class value_type>
+    double symv_bytes( value_type) const
+    {
+        // read x, read and write y in every entry
+        return 3.*sizeof(value_type)*num_entries*n*left_size*right_size
+            + 3.*sizeof(int)*num_entries
+            + sizeof(real_type)*(double)data.size();
+    }
+    double symv_flops() const {
+        return 2.*num_entries*n*n*left_size*right_size;
+    }
+    ///@endcond
+
     /**
     * @brief Apply the matrix to a vector
     *
@@ -305,17 +349,23 @@ struct CooSparseBlockMat
     template<class value_type>
     void symv(SharedVectorTag, SerialTag, value_type alpha, const value_type** x, value_type beta, value_type* RESTRICT y) const
     {
+        DG_PROFILE_REGION( "CooSparseBlockMat::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         launch_multiply_kernel( SerialTag(), alpha, x, beta, y);
     }
     template<class value_type>
     void symv(SharedVectorTag, CudaTag, value_type alpha, const value_type** x, value_type beta, value_type* y) const
     {
+        DG_PROFILE_REGION( "CooSparseBlockMat::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         launch_multiply_kernel( CudaTag(), alpha, x, beta, y);
     }
 #ifdef _OPENMP
     template<class value_type>
     void symv(SharedVectorTag, OmpTag, value_type alpha, const value_type** x, value_type beta, value_type* y) const
     {
+        DG_PROFILE_REGION( "CooSparseBlockMat::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         if( !omp_in_parallel())
         {
             #pragma omp parallel
@@ -324,7 +374,11 @@ struct CooSparseBlockMat
             }
             return;
         }
+        // in a thread team x may have been written by other threads and y
+        // is partitioned differently than in blas1 (s.a. dg::OmpTag)
+        #pragma omp barrier
         launch_multiply_kernel( OmpTag(), alpha, x, beta, y);
+        #pragma omp barrier
     }
 #endif //_OPENMP
 
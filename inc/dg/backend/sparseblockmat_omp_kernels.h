@@ -18,7 +18,7 @@ void ell_omp_multiply_kernel( value_type alpha, value_type beta,
          const value_type * RESTRICT x, value_type * RESTRICT y
          )
 {
-#pragma omp for nowait //manual collapse(2)
+#pragma omp for schedule(static) nowait //manual collapse(2)
 	for( int si = 0; si<left_size*num_rows; si++)
 	{
 		int s = si / num_rows;
@@ -98,7 +98,7 @@ void ell_omp_multiply_kernel( value_type alpha, value_type beta,
         int B = data_idx[blocks_per_line+d];
         dprivate[(k*blocks_per_line+d)*n+q] = data[(B*n+k)*n+q];
     }
-    #pragma omp for nowait
+    #pragma omp for schedule(static) nowait
     for( int s=0; s<left_size; s++)
     {
         for( int i=0; i<1; i++)
@@ -182,7 +182,7 @@ void ell_omp_multiply_kernel( value_type alpha, value_type beta,
     else // not trivial
     {
     value_type xprivate[blocks_per_line*n];
-    #pragma omp for nowait
+    #pragma omp for schedule(static) nowait
     for( int s=0; s<left_size; s++)
     for( int i=0; i<num_rows; i++)
     {
@@ -217,7 +217,7 @@ void ell_omp_multiply_kernel( value_type alpha, value_type beta,
     int J[blocks_per_line];
     if( !( (right_range[1]-right_range[0]) > 100*left_size*num_rows*n )) //typically a derivative in y ( Ny*Nz >~ Nx)
     {
-        #pragma omp for nowait
+        #pragma omp for schedule(static) nowait
         for (int sik = 0; sik < left_size*num_rows*n; sik++)
         {
             int s = sik / (num_rows*n);
@@ -366,7 +366,7 @@ void EllSparseBlockMat<real_type, Vector>::launch_multiply_kernel( OmpTag, value
 template<class real_type, class value_type, template<class> class Vector>
 void coo_omp_multiply_kernel( value_type alpha, const value_type** x, value_type beta, value_type* RESTRICT y, const CooSparseBlockMat<real_type, Vector>& m )
 {
-    #pragma omp for nowait
+    #pragma omp for schedule(static) nowait
 	for (int skj = 0; skj < m.left_size*m.n*m.right_size; skj++)
 	{
 		int s = skj / (m.n*m.right_size);
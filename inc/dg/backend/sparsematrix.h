@@ -10,6 +10,7 @@
 #include "predicate.h"
 #include "exceptions.h"
 #include "config.h"
+#include "profile.h"
 #include "blas2_stencil.h"
 
 #include "sparsematrix_cpu.h"
@@ -302,10 +303,24 @@ struct SparseMatrix
      */
     Vector<Value> & values() { return m_vals;}
 
+    ///@cond
+    // memory traffic and floating point operations of symv (for dg::profile)
+    template<class value_type>
+    double symv_bytes( value_type beta) const
+    {
+        return sizeof(value_type)*( (double)m_num_cols +
+                (beta == value_type(0) ? 1. : 2.)*m_num_rows)
+            + (sizeof(Value) + sizeof( Index))*(double)m_vals.size()
+            + sizeof( Index)*(m_num_rows + 1.);
+    }
+    double symv_flops() const { return 2.*m_vals.size();}
+    ///@endcond
     ///@cond
     template<class value_type>
     void symv(SharedVectorTag, SerialTag, value_type alpha, const value_type* RESTRICT x, value_type beta, value_type* RESTRICT y) const
     {
+        DG_PROFILE_REGION( "SparseMatrix::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         const auto* row_ptr = thrust::raw_pointer_cast( &m_row_offsets[0]);
         const auto* col_ptr = thrust::raw_pointer_cast( &m_cols[0]);
         const auto* val_ptr = thrust::raw_pointer_cast( &m_vals[0]);
@@ -316,6 +331,8 @@ struct SparseMatrix
     template<class value_type>
     void symv(SharedVectorTag, CudaTag, value_type alpha, const value_type* x, value_type beta, value_type* y) const
     {
+        DG_PROFILE_REGION( "SparseMatrix::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         const auto* row_ptr = thrust::raw_pointer_cast( &m_row_offsets[0]);
         const auto* col_ptr = thrust::raw_pointer_cast( &m_cols[0]);
         const auto* val_ptr = thrust::raw_pointer_cast( &m_vals[0]);
@@ -326,6 +343,8 @@ struct SparseMatrix
     template<class value_type>
     void symv(SharedVectorTag, OmpTag, value_type alpha, const value_type* x, value_type beta, value_type* y) const
     {
+        DG_PROFILE_REGION( "SparseMatrix::symv");
+        DG_PROFILE_TRAFFIC( symv_bytes( beta), symv_flops());
         const auto* row_ptr = thrust::raw_pointer_cast( &m_row_offsets[0]);
         const auto* col_ptr = thrust::raw_pointer_cast( &m_cols[0]);
         const auto* val_ptr = thrust::raw_pointer_cast( &m_vals[0]);
@@ -338,45 +357,185 @@ struct SparseMatrix
             }
             return;
         }
+        // in a thread team x may have been written by other threads and y
+        // is partitioned differently than in blas1 (s.a. dg::OmpTag)
+        #pragma omp barrier
         detail::spmv_omp_kernel( m_cache, m_num_rows, m_num_cols,
             m_vals.size(), row_ptr, col_ptr, val_ptr, alpha, beta, x, y);
+        #pragma omp barrier
+    }
+#endif
+    // memory traffic of symm (the matrix is read only once)
+    template<class value_type>
+    double symm_bytes( size_t num_vectors, value_type beta) const
+    {
+        return sizeof(value_type)*num_vectors*( (double)m_num_cols +
+                (beta == value_type(0) ? 1. : 2.)*m_num_rows)
+            + (sizeof(Value) + sizeof( Index))*(double)m_vals.size()
+            + sizeof( Index)*(m_num_rows + 1.);
+    }
+    template<class value_type>
+    void symm(SharedVectorTag, SerialTag, size_t num_vectors, value_type alpha, const value_type* RESTRICT x, size_t ldx, value_type beta, value_type* RESTRICT y, size_t ldy) const
+    {
+        DG_PROFILE_REGION( "SparseMatrix::symm");
+        DG_PROFILE_TRAFFIC( symm_bytes( num_vectors, beta), num_vectors*symv_flops());
+        const auto* row_ptr = thrust::raw_pointer_cast( &m_row_offsets[0]);
+        const auto* col_ptr = thrust::raw_pointer_cast( &m_cols[0]);
+        const auto* val_ptr = thrust::raw_pointer_cast( &m_vals[0]);
+        detail::spmm_cpu_kernel( m_cache, m_num_rows, m_num_cols,
+            m_vals.size(), row_ptr, col_ptr, val_ptr, num_vectors, alpha, beta,
+            x, ldx, y, ldy);
+    }
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
+    template<class value_type>
+    void symm(SharedVectorTag, CudaTag, size_t num_vectors, value_type alpha, const value_type* x, size_t ldx, value_type beta, value_type* y, size_t ldy) const
+    {
+        DG_PROFILE_REGION( "SparseMatrix::symm");
+        DG_PROFILE_TRAFFIC( symm_bytes( num_vectors, beta), num_vectors*symv_flops());
+        const auto* row_ptr = thrust::raw_pointer_cast( &m_row_offsets[0]);
+        const auto* col_ptr = thrust::raw_pointer_cast( &m_cols[0]);
+        const auto* val_ptr = thrust::raw_pointer_cast( &m_vals[0]);
+        detail::spmm_gpu_kernel( m_cache, m_num_rows, m_num_cols,
+            m_vals.size(), row_ptr, col_ptr, val_ptr, num_vectors, alpha, beta,
+            x, ldx, y, ldy);
+    }
+#elif THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP
+    template<class value_type>
+    void symm(SharedVectorTag, OmpTag, size_t num_vectors, value_type alpha, const value_type* x, size_t ldx, value_type beta, value_type* y, size_t ldy) const
+    {
+        DG_PROFILE_REGION( "SparseMatrix::symm");
+        DG_PROFILE_TRAFFIC( symm_bytes( num_vectors, beta), num_vectors*symv_flops());
+        const auto* row_ptr = thrust::raw_pointer_cast( &m_row_offsets[0]);
+        const auto* col_ptr = thrust::raw_pointer_cast( &m_cols[0]);
+        const auto* val_ptr = thrust::raw_pointer_cast( &m_vals[0]);
+        if( !omp_in_parallel())
+        {
+            #pragma omp parallel
+            {
+                detail::spmm_omp_kernel( m_cache, m_num_rows, m_num_cols,
+                    m_vals.size(), row_ptr, col_ptr, val_ptr, num_vectors,
+                    alpha, beta, x, ldx, y, ldy);
+            }
+            return;
+        }
+        #pragma omp barrier
+        detail::spmm_omp_kernel( m_cache, m_num_rows, m_num_cols,
+            m_vals.size(), row_ptr, col_ptr, val_ptr, num_vectors, alpha, beta,
+            x, ldx, y, ldy);
+        #pragma omp barrier
     }
 #endif
     ///@endcond
 
+    /**
+     * @brief Apply the matrix to many vectors at once
+     * \f$ y_k = \alpha M x_k + \beta y_k\f$ for \f$ k = 0,\dots,K-1\f$ (SpMM)
+     *
+     * The vectors are stored one after the other in \c x and \c y, i.e.
+     * vector \c k of \c x occupies the elements <tt>[k*num_cols(), (k+1)*num_cols())</tt>
+     * (the vectors are the columns of a column-major dense matrix). This is
+     * for example the layout of the planes of a 3d vector when \c M is a 2d
+     * matrix.  In contrast to \c K calls to \c dg::blas2::symv the
+     * matrix is read from memory only once. On the host (serial and OpenMP) the
+     * result is binary identical to the one of \c dg::blas2::symv on each
+     * vector.
+     * @snippet{trimleft} sparsematrix_t.cpp symm
+     * @param num_vectors Number of vectors \c K
+     * @param alpha scalar
+     * @param x input of size <tt>num_vectors*num_cols()</tt>
+     * @param beta scalar
+     * @param y output of size <tt>num_vectors*num_rows()</tt> (may not alias \c x)
+     * @tparam ContainerType0 A shared vector type (e.g. \c dg::View) with the same execution policy as the matrix
+     * @tparam ContainerType1 A shared vector type with the same execution policy as the matrix
+     */
+    template<class ContainerType0, class ContainerType1>
+    void symm( unsigned num_vectors, Value alpha, const ContainerType0& x,
+        Value beta, ContainerType1& y) const
+    {
+        static_assert( dg::has_policy_v<ContainerType0, policy> &&
+                       dg::has_policy_v<ContainerType1, policy>,
+                       "Vector types must have same execution policy as the matrix");
+        if( (size_t)x.size() != num_vectors*m_num_cols)
+            throw dg::Error( dg::Message( _ping_) << "Error: x has size "<<x.size()
+                <<" instead of "<<num_vectors<<"x"<<m_num_cols<<"\n");
+        if( (size_t)y.size() != num_vectors*m_num_rows)
+            throw dg::Error( dg::Message( _ping_) << "Error: y has size "<<y.size()
+                <<" instead of "<<num_vectors<<"x"<<m_num_rows<<"\n");
+        if( num_vectors == 0 || m_num_rows == 0)
+            return;
+        const Value* x_ptr = thrust::raw_pointer_cast( x.data());
+        Value* y_ptr = thrust::raw_pointer_cast( y.data());
+        symm( SharedVectorTag(), policy(), num_vectors, alpha, x_ptr, m_num_cols,
+            beta, y_ptr, m_num_rows);
+    }
+
     /**
     * @brief Transposition
     *
-    * The transpose is sorted even if the original is not
+    * The transpose is sorted even if the original is not.
+    * On the host (and in parallel with OpenMP) the transpose is computed with a
+    * counting sort linear in the number of non-zeros, on the GPU with a stable
+    * sort; the result is the same for all execution policies.
     * @return  A newly generated SparseMatrix containing the transpose.
     */
     SparseMatrix transpose() const
     {
-        auto cols = detail::csr2coo(m_row_offsets);
-        // cols are sorted
-
-        // We need to sort now
+        DG_PROFILE_REGION( "SparseMatrix::transpose");
         SparseMatrix<Index,Value,Vector> o;
         o.m_num_rows = m_num_cols;
         o.m_num_cols = m_num_rows;
+        o.m_row_offsets.resize( o.m_num_rows+1, 0);
+        o.m_cols.resize( m_cols.size());
+        o.m_vals.resize( m_vals.size());
+        if( !m_vals.empty())
+            transpose( policy(), o);
+        o.m_cache.forget();
+        return o;
+    }
 
+    ///@cond
+    // Counting sort on the host
+    void transpose( SerialTag, SparseMatrix& o) const
+    {
+        detail::transpose_cpu_kernel( m_num_rows, m_num_cols,
+            thrust::raw_pointer_cast( m_row_offsets.data()),
+            thrust::raw_pointer_cast( m_cols.data()),
+            thrust::raw_pointer_cast( m_vals.data()),
+            thrust::raw_pointer_cast( o.m_row_offsets.data()),
+            thrust::raw_pointer_cast( o.m_cols.data()),
+            thrust::raw_pointer_cast( o.m_vals.data()));
+    }
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
+    // Stable (radix) sort by column index on the device
+    void transpose( CudaTag, SparseMatrix& o) const
+    {
+        auto cols = detail::csr2coo(m_row_offsets);
+        // cols are sorted
         Vector<Index> rows( m_cols.begin(), m_cols.end());
         Vector<Index> p( rows.size()); // permutation
         thrust::sequence( p.begin(), p.end());
 
         thrust::stable_sort_by_key( rows.begin(), rows.end(), p.begin());
-        o.m_row_offsets.resize( o.m_num_rows+1);
         detail::coo2csr_inline( rows, o.m_row_offsets);
         // Repeat sort on cols and vals
-        o.m_cols.resize( cols.size());
-        o.m_vals.resize( m_vals.size());
         // Since cols are sorted o.m_cols will be as well
         thrust::gather( p.begin(), p.end(),   cols.begin(), o.m_cols.begin());
         thrust::gather( p.begin(), p.end(), m_vals.begin(), o.m_vals.begin());
-        o.m_cache.forget();
-        return o;
-
     }
+#elif THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP
+    // Counting sort with thread private counts
+    void transpose( OmpTag, SparseMatrix& o) const
+    {
+        detail::transpose_omp_kernel( m_num_rows, m_num_cols,
+            thrust::raw_pointer_cast( m_row_offsets.data()),
+            thrust::raw_pointer_cast( m_cols.data()),
+            thrust::raw_pointer_cast( m_vals.data()),
+            thrust::raw_pointer_cast( o.m_row_offsets.data()),
+            thrust::raw_pointer_cast( o.m_cols.data()),
+            thrust::raw_pointer_cast( o.m_vals.data()));
+    }
+#endif
+    ///@endcond
 
     //
     // We enable the following only for serial sparse matrices
@@ -217,6 +217,92 @@ void spmv_cpu_kernel(
     }
 }
 
+//y_k = alpha A*x_k + beta y_k for k = 0..num_vectors-1 (SpMM)
+//vector k of x (y) starts at x_ptr + k*ldx (y_ptr + k*ldy)
+//The rows are processed in blocks that stay in cache for all vectors such that
+//A is read from memory only once; the arithmetic in every vector
+//is the same as in spmv_cpu_kernel such that results are bitwise identical
+template<class I, class V, class value_type, class C1, class C2>
+void spmm_cpu_kernel(
+    CSRCache_cpu& cache,
+    size_t A_num_rows, size_t A_num_cols, size_t A_nnz,
+    const I* RESTRICT A_pos , const I* RESTRICT A_idx, const V* RESTRICT  A_val,
+    size_t num_vectors, value_type alpha, value_type beta,
+    const C1* RESTRICT x_ptr, size_t ldx, C2* RESTRICT y_ptr, size_t ldy
+)
+{
+    const int block_size = 1024;
+    const int num_blocks = (A_num_rows + block_size - 1)/block_size;
+//    #pragma omp for nowait
+    for( int b = 0; b < num_blocks; b++)
+    {
+        int begin = b*block_size, end = std::min( (int)A_num_rows, begin + block_size);
+        for( size_t k = 0; k < num_vectors; k++)
+        {
+            const C1* RESTRICT x_k = x_ptr + k*ldx;
+            C2* RESTRICT y_k = y_ptr + k*ldy;
+            if( beta == value_type(1))
+            {
+                for(int i = begin; i < end; i++)
+                {
+                    for (int jj = A_pos[i]; jj < A_pos[i+1]; jj++)
+                    {
+                        int j = A_idx[jj];
+                        y_k[i] = DG_FMA( alpha*A_val[jj], x_k[j], y_k[i]);
+                    }
+                }
+            }
+            else
+            {
+                for(int i = begin; i < end; i++)
+                {
+                    value_type temp = 0;
+                    for (int jj = A_pos[i]; jj < A_pos[i+1]; jj++)
+                    {
+                        int j = A_idx[jj];
+                        temp = DG_FMA( alpha*A_val[jj], x_k[j], temp);
+                    }
+
+                    y_k[i] = DG_FMA( beta, y_k[i], temp);
+                }
+            }
+        }
+    }
+}
+
+
+// B = A^T with a counting sort (O(nnz), no comparison sort)
+// B_pos must have size A_num_cols+1, B_idx and B_val size nnz
+// The entries of a column of A are visited in row order, so B is sorted
+// and equal to a stable sort of A by column indices
+template<class I, class V>
+void transpose_cpu_kernel(
+    size_t A_num_rows, size_t A_num_cols,
+    const I* RESTRICT A_pos , const I* RESTRICT A_idx, const V* RESTRICT A_val,
+          I* RESTRICT B_pos ,       I* RESTRICT B_idx,       V* RESTRICT B_val
+)
+{
+    // 1. count entries per column of A
+    for( size_t j = 0; j <= A_num_cols; j++)
+        B_pos[j] = 0;
+    for( int jj = 0; jj < (int)A_pos[A_num_rows]; jj++)
+        B_pos[A_idx[jj]+1]++;
+    // 2. prefix sum
+    for( size_t j = 0; j < A_num_cols; j++)
+        B_pos[j+1] += B_pos[j];
+    // 3. scatter
+    std::vector<I> next( B_pos, B_pos + A_num_cols);
+    for( int i = 0; i < (int)A_num_rows; i++)
+    {
+        for( int jj = A_pos[i]; jj < A_pos[i+1]; jj++)
+        {
+            int p = next[A_idx[jj]]++;
+            B_idx[p] = i;
+            B_val[p] = A_val[jj];
+        }
+    }
+}
+
 
 
 }// namespace detail
@@ -120,6 +120,8 @@ struct CSRCache_gpu
     {
         if ( m_dBuffer != nullptr)
             cudaFree( m_dBuffer);
+        if ( m_dBufferMM != nullptr)
+            cudaFree( m_dBufferMM);
         if( m_active)
             cusparseDestroySpMat( m_matA);
     }
@@ -129,6 +131,8 @@ struct CSRCache_gpu
         std::swap( m_matA, src.m_matA);
         std::swap( m_dBuffer, src.m_dBuffer);
         std::swap( m_bufferSize, src.m_bufferSize);
+        std::swap( m_dBufferMM, src.m_dBufferMM);
+        std::swap( m_bufferSizeMM, src.m_bufferSizeMM);
     }
     void forget() { m_active = false;}
     bool isUpToDate() const { return m_active;}
@@ -177,12 +181,26 @@ struct CSRCache_gpu
     size_t getBufferSize() { return m_bufferSize;}
     void * getBuffer() { return m_dBuffer;}
     cusparseSpMatDescr_t getSpMat() const { return m_matA;}
+    // The SpMM buffer size depends on the number of vectors, it only grows
+    void * getBufferMM( size_t bufferSize)
+    {
+        if( bufferSize > m_bufferSizeMM)
+        {
+            if ( m_dBufferMM != nullptr)
+                cudaFree( m_dBufferMM);
+            cudaMalloc( &m_dBufferMM, bufferSize);
+            m_bufferSizeMM = bufferSize;
+        }
+        return m_dBufferMM;
+    }
 
     private:
     bool m_active = false;
     cusparseSpMatDescr_t m_matA;
     void * m_dBuffer = nullptr;
     size_t m_bufferSize = 0;
+    void * m_dBufferMM = nullptr;
+    size_t m_bufferSizeMM = 0;
 };
 
 //y = alpha A*x + beta y
@@ -212,5 +230,41 @@ void spmv_gpu_kernel(
     err = cusparseDestroyDnVec( vecY);
 }
 
+//y_k = alpha A*x_k + beta y_k for k = 0..num_vectors-1 (SpMM)
+//vector k of x (y) starts at x_ptr + k*ldx (y_ptr + k*ldy) i.e. column major
+template<class I, class V, class value_type, class C1, class C2>
+void spmm_gpu_kernel(
+    CSRCache_gpu& cache,
+    size_t A_num_rows, size_t A_num_cols, size_t A_nnz,
+    const I* A_pos , const I* A_idx, const V* A_val,
+    size_t num_vectors, value_type alpha, value_type beta,
+    const C1* x_ptr, size_t ldx, C2* y_ptr, size_t ldy
+)
+{
+    CusparseErrorHandle err;
+    cusparseDnMatDescr_t matX;
+    cusparseDnMatDescr_t matY;
+    err = cusparseCreateDnMat( &matX, A_num_cols, num_vectors, ldx,
+        const_cast<C1*>(x_ptr), getCudaDataType<C1>(), CUSPARSE_ORDER_COL);
+    err = cusparseCreateDnMat( &matY, A_num_rows, num_vectors, ldy,
+        y_ptr, getCudaDataType<C2>(), CUSPARSE_ORDER_COL);
+
+    if( not cache.isUpToDate())
+        cache.update<I,V>( A_num_rows, A_num_cols, A_nnz, A_pos, A_idx, A_val);
+
+    size_t bufferSize = 0;
+    err = cusparseSpMM_bufferSize( CusparseHandle::getInstance().handle(),
+        CUSPARSE_OPERATION_NON_TRANSPOSE, CUSPARSE_OPERATION_NON_TRANSPOSE,
+        &alpha, cache.getSpMat(), matX, &beta, matY, getCudaDataType<V>(),
+        CUSPARSE_SPMM_CSR_ALG1, &bufferSize);
+    err = cusparseSpMM( CusparseHandle::getInstance().handle(),
+        CUSPARSE_OPERATION_NON_TRANSPOSE, CUSPARSE_OPERATION_NON_TRANSPOSE,
+        &alpha, cache.getSpMat(), matX, &beta, matY, getCudaDataType<V>(),
+        CUSPARSE_SPMM_CSR_ALG1, cache.getBufferMM( bufferSize));
+
+    err = cusparseDestroyDnMat( matX);
+    err = cusparseDestroyDnMat( matY);
+}
+
 } // namespace detail
 } // namespace dg
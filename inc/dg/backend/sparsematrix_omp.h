@@ -1,10 +1,14 @@
 #pragma once
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+
 namespace dg
 {
 namespace detail
 {
 // !!! Do not edit by hand:
-// 1. copy CSRCache_cpu and spmv_cpu_kernel from sparsematrix_cpu.h
+// 1. copy CSRCache_cpu, spmv_cpu_kernel and spmm_cpu_kernel from sparsematrix_cpu.h
 // 2. uncomment the pragma omp parallel
 // 3. Rename cpu to omp
 
@@ -50,5 +54,127 @@ void spmv_omp_kernel(
     }
 }
 
+//y_k = alpha A*x_k + beta y_k for k = 0..num_vectors-1 (SpMM)
+//vector k of x (y) starts at x_ptr + k*ldx (y_ptr + k*ldy)
+//The rows are processed in blocks that stay in cache for all vectors such that
+//A is read from memory only once; the arithmetic in every vector
+//is the same as in spmv_omp_kernel such that results are bitwise identical
+template<class I, class V, class value_type, class C1, class C2>
+void spmm_omp_kernel(
+    CSRCache_omp& cache,
+    size_t A_num_rows, size_t A_num_cols, size_t A_nnz,
+    const I* RESTRICT A_pos , const I* RESTRICT A_idx, const V* RESTRICT  A_val,
+    size_t num_vectors, value_type alpha, value_type beta,
+    const C1* RESTRICT x_ptr, size_t ldx, C2* RESTRICT y_ptr, size_t ldy
+)
+{
+    const int block_size = 1024;
+    const int num_blocks = (A_num_rows + block_size - 1)/block_size;
+    #pragma omp for nowait
+    for( int b = 0; b < num_blocks; b++)
+    {
+        int begin = b*block_size, end = std::min( (int)A_num_rows, begin + block_size);
+        for( size_t k = 0; k < num_vectors; k++)
+        {
+            const C1* RESTRICT x_k = x_ptr + k*ldx;
+            C2* RESTRICT y_k = y_ptr + k*ldy;
+            if( beta == value_type(1))
+            {
+                for(int i = begin; i < end; i++)
+                {
+                    for (int jj = A_pos[i]; jj < A_pos[i+1]; jj++)
+                    {
+                        int j = A_idx[jj];
+                        y_k[i] = DG_FMA( alpha*A_val[jj], x_k[j], y_k[i]);
+                    }
+                }
+            }
+            else
+            {
+                for(int i = begin; i < end; i++)
+                {
+                    value_type temp = 0;
+                    for (int jj = A_pos[i]; jj < A_pos[i+1]; jj++)
+                    {
+                        int j = A_idx[jj];
+                        temp = DG_FMA( alpha*A_val[jj], x_k[j], temp);
+                    }
+
+                    y_k[i] = DG_FMA( beta, y_k[i], temp);
+                }
+            }
+        }
+    }
+}
+
+// The following is not a copy of sparsematrix_cpu.h
+
+// B = A^T, result is equal to transpose_cpu_kernel
+// Each thread counts the entries per column in a contiguous range of rows of
+// A. The offsets of thread t in column j of B are then the number of entries
+// of threads 0..t-1 in column j, which reproduces the serial order.
+// Needs num_threads*A_num_cols indices of temporary memory, so the number of
+// threads is limited to the mean number of entries per column, which keeps
+// the temporary memory (and the strided scan over it) at most the size of A
+template<class I, class V>
+void transpose_omp_kernel(
+    size_t A_num_rows, size_t A_num_cols,
+    const I* RESTRICT A_pos , const I* RESTRICT A_idx, const V* RESTRICT A_val,
+          I* RESTRICT B_pos ,       I* RESTRICT B_idx,       V* RESTRICT B_val
+)
+{
+    const size_t nnz = A_pos[A_num_rows];
+    const size_t max_threads = std::max<size_t>( 1, std::min<size_t>(
+        omp_get_max_threads(), nnz/std::max<size_t>( A_num_cols, 1)));
+    std::vector<I> count;
+    #pragma omp parallel num_threads( max_threads)
+    {
+        const int tid = omp_get_thread_num();
+        const int num_threads = omp_get_num_threads();
+        #pragma omp single
+        count.assign( (size_t)num_threads*A_num_cols, 0);
+        // implicit barrier
+        const int begin = (size_t)tid*A_num_rows/num_threads;
+        const int end   = (size_t)(tid+1)*A_num_rows/num_threads;
+        I* RESTRICT next = &count[(size_t)tid*A_num_cols];
+        // 1. count entries per column in own rows
+        for( int jj = A_pos[begin]; jj < A_pos[end]; jj++)
+            next[A_idx[jj]]++;
+        #pragma omp barrier
+        // 2. column sizes and offsets of each thread within a column
+        #pragma omp for
+        for( int j = 0; j < (int)A_num_cols; j++)
+        {
+            I sum = 0;
+            for( int t = 0; t < num_threads; t++)
+            {
+                I temp = count[(size_t)t*A_num_cols+j];
+                count[(size_t)t*A_num_cols+j] = sum;
+                sum += temp;
+            }
+            B_pos[j+1] = sum;
+        }
+        // implicit barrier
+        #pragma omp single
+        {
+            B_pos[0] = 0;
+            for( size_t j = 0; j < A_num_cols; j++)
+                B_pos[j+1] += B_pos[j];
+        }
+        // implicit barrier
+        // 3. scatter own rows
+        for( int i = begin; i < end; i++)
+        {
+            for( int jj = A_pos[i]; jj < A_pos[i+1]; jj++)
+            {
+                int j = A_idx[jj];
+                int p = B_pos[j] + next[j]++;
+                B_idx[p] = i;
+                B_val[p] = A_val[jj];
+            }
+        }
+    }
+}
+
 }//namespace detail
 }//namespace dg
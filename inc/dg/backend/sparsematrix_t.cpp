@@ -220,6 +220,47 @@ TEST_CASE( "SpMV on device")
         CHECK( B.row_offsets() == std::vector<int>{ 0,2,3,4,5,7});
         CHECK( B.column_indices() == std::vector<int>{ 0,1,2,1,0,0,2});
         CHECK( B.values() == std::vector<double>{ 1,2,4,5,2,3,1});
+        // all execution policies give the same result
+        dg::SparseMatrix<int,double,thrust::host_vector> hB( dA.transpose());
+        CHECK( hB == B);
+        // Transposing twice sorts the original
+        auto C = B.transpose();
+        CHECK( C.row_offsets() == A.row_offsets());
+        CHECK( C.column_indices() == std::vector<int>{ 0,3,4,0,2,1,4});
+        CHECK( C.values() == std::vector<double>{ 1,2,3,2,5,4,1});
+    }
+    SECTION( "transpose large")
+    {
+        // rows with many entries such that threads share columns
+        unsigned M = 1000, N = 300;
+        std::vector<int> row_offsets(M+1, 0), column_indices;
+        std::vector<double> values;
+        for( unsigned i=0; i<M; i++)
+        {
+            for( unsigned k=0; k<i%7; k++)
+            {
+                column_indices.push_back( (i*13 + k*101) % N);
+                values.push_back( i + 0.5*k);
+            }
+            row_offsets[i+1] = column_indices.size();
+        }
+        dg::SparseMatrix<int,double,thrust::host_vector> L( M, N, row_offsets,
+            column_indices, values);
+        dg::SparseMatrix<int,double,thrust::device_vector> dL( L);
+        auto LT = L.transpose();
+        dg::SparseMatrix<int,double,thrust::host_vector> hLT( dL.transpose());
+        CHECK( hLT == LT);
+        CHECK( LT.row_offsets()[N] == (int)values.size());
+        // y = L^T x == x^T L
+        thrust::host_vector<double> x( M), y( N), z( N, 0.);
+        for( unsigned i=0; i<M; i++)
+            x[i] = 1./(i+1.);
+        dg::blas2::symv( LT, x, y);
+        for( unsigned i=0; i<M; i++)
+            for( int jj=row_offsets[i]; jj<row_offsets[i+1]; jj++)
+                z[column_indices[jj]] += values[jj]*x[i];
+        for( unsigned j=0; j<N; j++)
+            CHECK( fabs( y[j] - z[j]) <= 1e-12*fabs(z[j]));
     }
     SECTION( "gemv")
     {
@@ -234,6 +275,36 @@ TEST_CASE( "SpMV on device")
         CHECK( w[1] == 17);
         CHECK( w[2] == 13);
     }
+    SECTION( "symm")
+    {
+        //![symm]
+        // Apply dA to 3 vectors stored one after the other
+        unsigned num_vectors = 3;
+        thrust::host_vector<double> v(num_vectors*5), w(num_vectors*3, 1.);
+        for( unsigned i=0; i<v.size(); i++)
+            v[i] = double(i+1);
+        thrust::device_vector<double> dv( v), dw( w);
+        // dw_k = dA dv_k + 2 dw_k
+        dA.symm( num_vectors, 1., dv, 2., dw);
+        //![symm]
+        // Same as symv on each vector
+        for( unsigned k=0; k<num_vectors; k++)
+        {
+            thrust::device_vector<double> dvk( dv.begin()+k*5, dv.begin()+(k+1)*5);
+            thrust::device_vector<double> dwk( 3, 1.);
+            dg::blas2::symv( 1., dA, dvk, 2., dwk);
+            for( unsigned i=0; i<3; i++)
+            {
+                INFO( "Vector "<<k<<" row "<<i);
+                CHECK( dw[k*3+i] == dwk[i]);
+            }
+        }
+        w = dw;
+        CHECK( w[0] == 26);
+        CHECK( w[1] == 19);
+        CHECK( w[2] == 15);
+        CHECK_THROWS_AS( dA.symm( 2, 1., dv, 0., dw), dg::Error);
+    }
 }
 
 TEST_CASE("Documentation")
@@ -63,6 +63,15 @@ struct RecursiveVectorTag  : public AnyVectorTag {};
 //struct RecursiveScalarTag : public RecursiveVectorTag {};
 struct ArrayVectorTag  : public RecursiveVectorTag {};
 struct StdMapTag : public RecursiveVectorTag{};
+/**
+ * @brief A recursive vector whose inner vectors lie back to back in one contiguous chunk of memory
+ *
+ * In addition to the \c RecursiveVectorTag requirements we assume
+ *  - \c data() returns the contiguous container (with a \c SharedVectorTag) of all inner vectors
+ *  - \c block_sizes() returns a \c std::vector<unsigned> of the sizes of the inner vectors
+ * @see dg::BlockVector
+ */
+struct BlockVectorTag : public RecursiveVectorTag{};
 
 struct ArrayScalarTag : public SharedVectorTag {};
 /**
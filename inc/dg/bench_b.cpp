@@ -0,0 +1,207 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <thrust/host_vector.h>
+#include <thrust/device_vector.h>
+
+#ifdef WITH_MPI
+#include <mpi.h>
+#include "backend/mpi_init.h"
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "backend/benchmark.h"
+#include "blas.h"
+#include "elliptic.h"
+#include "pcg.h"
+
+// Benchmark harness: sweeps over n, Nx, Ny, Nz and number of OpenMP threads,
+// times each kernel repeatedly (after warm-up) and writes statistics as
+// CSV and/or JSON. A CSV file from a previous run can be given as baseline,
+// in which case regressions are reported and the program returns 1.
+// Parameters are given on the command line, e.g.
+//     ./bench_b --n 3,4 --Nx 64,128 --Ny 64,128 --Nz 1 --threads 1,4 \
+//         --csv new.csv --baseline old.csv --tolerance 0.1
+// The number of MPI processes cannot be changed at runtime, sweep with e.g.
+//     for np in 1 2 4; do mpirun -n $np ./bench_mpib --csv bench$np.csv; done
+// (the number of ranks is part of the parameters of each result)
+
+const double lx = 2.*M_PI;
+const double ly = 2.*M_PI;
+const double lz = 2.*M_PI;
+double function( double x, double y, double z) { return sin(x)*sin(y)*cos(z);}
+
+std::vector<unsigned> parse_list( const std::string& arg)
+{
+    std::vector<unsigned> list;
+    std::stringstream ss( arg);
+    std::string item;
+    while( std::getline( ss, item, ','))
+        list.push_back( std::stoul( item));
+    return list;
+}
+std::vector<std::string> parse_names( const std::string& arg)
+{
+    std::vector<std::string> list;
+    std::stringstream ss( arg);
+    std::string item;
+    while( std::getline( ss, item, ','))
+        list.push_back( item);
+    return list;
+}
+bool contains( const std::vector<std::string>& list, const std::string& name)
+{
+    return std::find( list.begin(), list.end(), name) != list.end();
+}
+
+int main( int argc, char* argv[])
+{
+    int rank = 0, ranks = 1;
+#ifdef WITH_MPI
+    dg::mpi_init( argc, argv);
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+    MPI_Comm_size( MPI_COMM_WORLD, &ranks);
+    MPI_Comm comm = dg::mpi_cart_create( MPI_COMM_WORLD, {0,0,0}, {1,1,1});
+#endif
+    std::vector<unsigned> ns = {3}, Nxs = {128}, Nys = {128}, Nzs = {1};
+    std::vector<unsigned> threads = {0}; // 0 means default
+    std::vector<std::string> suites = {"axpby", "pointwiseDot", "dot", "fast_dot",
+        "dx", "elliptic", "pcg"};
+    unsigned warmup = 2, repetitions = 10;
+    std::string csv, json, baseline;
+    double tolerance = 0.1;
+    for( int i=1; i<argc; i++)
+    {
+        std::string arg = argv[i];
+        if( arg == "--help" || i+1 == argc)
+        {
+            DG_RANK0 std::cout << "Usage: "<<argv[0]<<" [--n 3,4] [--Nx 64,128] "
+                <<"[--Ny 64,128] [--Nz 1] [--threads 1,2,4] "
+                <<"[--suite axpby,pointwiseDot,dot,fast_dot,dx,elliptic,pcg] "
+                <<"[--warmup 2] [--repeat 10] [--csv file] [--json file] "
+                <<"[--baseline file] [--tolerance 0.1]\n";
+            return arg == "--help" ? 0 : -1;
+        }
+        std::string value = argv[++i];
+        if( arg == "--n") ns = parse_list( value);
+        else if( arg == "--Nx") Nxs = parse_list( value);
+        else if( arg == "--Ny") Nys = parse_list( value);
+        else if( arg == "--Nz") Nzs = parse_list( value);
+        else if( arg == "--threads") threads = parse_list( value);
+        else if( arg == "--suite") suites = parse_names( value);
+        else if( arg == "--warmup") warmup = std::stoul( value);
+        else if( arg == "--repeat") repetitions = std::stoul( value);
+        else if( arg == "--csv") csv = value;
+        else if( arg == "--json") json = value;
+        else if( arg == "--baseline") baseline = value;
+        else if( arg == "--tolerance") tolerance = std::stod( value);
+        else
+        {
+            DG_RANK0 std::cerr << "Unknown argument "<<arg<<"\n";
+            return -1;
+        }
+    }
+    dg::Benchmark bench( warmup, repetitions);
+    for( unsigned num_threads : threads)
+    for( unsigned n : ns)
+    for( unsigned Nx : Nxs)
+    for( unsigned Ny : Nys)
+    for( unsigned Nz : Nzs)
+    {
+#ifdef _OPENMP
+        if( num_threads > 0)
+            omp_set_num_threads( num_threads);
+        int used_threads = omp_get_max_threads();
+#else
+        int used_threads = 1;
+#endif
+        std::stringstream params;
+        params << "n="<<n<<";Nx="<<Nx<<";Ny="<<Ny<<";Nz="<<Nz
+               << ";threads="<<used_threads<<";ranks="<<ranks;
+        bench.set_params( params.str());
+
+        dg::x::CartesianGrid3d grid( 0., lx, 0., ly, 0., lz, n, Nx, Ny, Nz,
+            dg::PER, dg::PER, dg::PER
+#ifdef WITH_MPI
+            , comm
+#endif
+            );
+        dg::x::DVec x = dg::construct<dg::x::DVec>( dg::evaluate( function, grid));
+        dg::x::DVec y( x), z( x);
+        const dg::x::DVec w3d = dg::create::weights( grid);
+        double gbytes = (double)grid.size()*sizeof(double)/1e9;
+        auto report = [&]( const dg::BenchmarkResult& r){
+            DG_RANK0 dg::Benchmark::display( r);
+        };
+        if( contains( suites, "axpby"))
+            report( bench.run( "axpby", [&](){
+                dg::blas1::axpby( 1., x, -1., y);}, 3*gbytes));
+        if( contains( suites, "pointwiseDot"))
+            report( bench.run( "pointwiseDot", [&](){
+                dg::blas1::pointwiseDot( 1., x, y, 0., z);}, 3*gbytes));
+        if( contains( suites, "dot"))
+            report( bench.run( "dot", [&](){
+                dg::blas1::dot( x, y);}, 2*gbytes));
+        if( contains( suites, "fast_dot"))
+            report( bench.run( "fast_dot", [&](){
+                dg::blas1::fast_dot( x, y);}, 2*gbytes));
+        if( contains( suites, "dx"))
+        {
+            dg::x::DMatrix dx = dg::create::dx( grid, dg::centered);
+            report( bench.run( "dx", [&](){
+                dg::blas2::symv( dx, x, y);}, 2*gbytes));
+        }
+        if( contains( suites, "elliptic") || contains( suites, "pcg"))
+        {
+            dg::Elliptic<dg::x::CartesianGrid3d, dg::x::DMatrix, dg::x::DVec>
+                lap( grid, dg::forward);
+            if( contains( suites, "elliptic"))
+                report( bench.run( "elliptic", [&](){
+                    dg::blas2::symv( lap, x, y);}));
+            if( contains( suites, "pcg"))
+            {
+                // a fixed number of iterations
+                dg::PCG<dg::x::DVec> pcg( x, 100);
+                pcg.set_throw_on_fail( false);
+                report( bench.run( "pcg100", [&](){
+                    dg::blas1::copy( 0., y);
+                    pcg.solve( lap, y, x, 1., w3d, 1e-15);}));
+            }
+        }
+    }
+    if( rank == 0)
+    {
+        if( !csv.empty())
+        {
+            std::ofstream file( csv);
+            bench.write_csv( file);
+        }
+        if( !json.empty())
+        {
+            std::ofstream file( json);
+            bench.write_json( file);
+        }
+    }
+    int regressions = 0;
+    if( !baseline.empty())
+    {
+        std::ifstream file( baseline);
+        if( !file.good())
+            throw dg::Error( dg::Message(_ping_)<<"Cannot open baseline "<<baseline);
+        std::stringstream out;
+        regressions = bench.compare( dg::Benchmark::read_csv( file), tolerance, out);
+        DG_RANK0 std::cout << "\nComparison to baseline "<<baseline<<"\n"<<out.str();
+        DG_RANK0 std::cout << regressions<<" regression(s) with tolerance "<<tolerance<<"\n";
+    }
+#ifdef WITH_MPI
+    // all ranks measure slightly different times; rank 0 decides
+    MPI_Bcast( &regressions, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Finalize();
+#endif
+    return regressions > 0 ? 1 : 0;
+}
@@ -123,6 +123,29 @@ TEST_CASE( "Solvers")
         CHECK( res < 1e-6);
         //! [lgmres]
     }
+    SECTION( "lgmres recycle" )
+    {
+        INFO("LGMRES SOLVER WITH RECYCLED CORRECTION");
+        // A second, nearby system as in a Newton iteration
+        dg::x::HVec b2 = dg::evaluate( []( double x, double y){ return
+                0.01*cos(x)*sin(y);}, grid);
+        dg::blas1::axpby( 1., b, 1., b2);
+        std::array<unsigned,2> num_iter;
+        for( bool recycle : {false, true})
+        {
+            dg::LGMRES lgmres( x, 30, 4, 10000);
+            lgmres.set_recycle( recycle);
+            dg::blas1::copy( 0., x);
+            lgmres.solve( A, x, b, A.precond(), A.weights(), 1e-6);
+            dg::blas1::copy( 0., x);
+            num_iter[recycle] = lgmres.solve( A, x, b2, A.precond(),
+                    A.weights(), 1e-6);
+            CHECK( lgmres.converged());
+        }
+        INFO( "Second solve took "<<num_iter[0]<<" iterations without and "
+                <<num_iter[1]<<" with recycling");
+        CHECK( num_iter[1] < num_iter[0]);
+    }
     SECTION( "Andersonacc" )
     {
         INFO("ANDERSONACC");
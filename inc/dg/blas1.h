@@ -13,6 +13,8 @@
 #endif
 #include "backend/blas1_dispatch_vector.h"
 #include "backend/blas1_dispatch_map.h"
+#include "backend/block_vector.h"
+#include "backend/profile.h"
 #include "subroutines.h"
 
 /*!@file
@@ -35,6 +37,11 @@ namespace blas1
 ///@cond
 template< class ContainerType, class BinarySubroutine, class Functor, class ContainerType0, class ...ContainerTypes>
 inline void evaluate( ContainerType& y, BinarySubroutine f, Functor g, const ContainerType0& x0, const ContainerTypes& ...xs);
+namespace detail{
+template< class Functor, class ContainerType, class ...ContainerTypes>
+auto doDot_fast( Functor f, const ContainerType& x, const ContainerTypes& ...xs) ->
+    std::invoke_result_t<Functor, dg::get_value_type<ContainerType>, dg::get_value_type<ContainerTypes>...>;
+}//namespace detail
 ///@endcond
 
 ///@addtogroup blas1
@@ -155,6 +162,7 @@ inline auto dot( const ContainerType1& x, const ContainerType2& y)
     if constexpr (std::is_floating_point_v<get_value_type<ContainerType1>> &&
                   std::is_floating_point_v<get_value_type<ContainerType2>>)
     {
+        DG_PROFILE_REGION( "blas1::dot");
         int status = 0;
         std::vector<int64_t> acc = dg::blas1::detail::doDot_superacc( &status,
             x,y);
@@ -169,6 +177,52 @@ inline auto dot( const ContainerType1& x, const ContainerType2& y)
     }
 }
 
+/*! @brief \f$ x^T y\f$ Fast reproducible Euclidean dot product between two vectors
+ *
+ * This routine computes \f[ x^T y = \sum_{i=0}^{N-1} x_i y_i \f]
+ * @copydoc hide_iterations
+ *
+ * For example
+ * @snippet{trimleft} blas1_t.cpp fast_dot
+ * In contrast to \c dg::blas1::dot the sum is not computed exactly but with
+ * compensated summation (a sum and an error term) in a fixed
+ * pairwise/blocked order. This is several times cheaper than the exact
+ * dot product (it has the cost of a plain, memory bound, reduction) and the
+ * relative error is of order machine precision plus the condition number
+ * of the sum times machine precision squared, which is sufficient e.g. for
+ * residual norms in iterative solvers (s.a. \c dg::dot_policy).
+ * @attention if one of the input vectors contains \c Inf or \c NaN or the
+ * product of the input numbers reaches \c Inf or \c Nan then the behaviour
+ * is undefined and the function may throw. See @ref dg::ISNFINITE and @ref
+ * dg::ISNSANE in that case
+ * @note The order of summation does not depend on the number of OpenMP threads,
+ * so the results are **binary reproducible** for a given size of the vectors
+ * (and a given number of MPI processes), but they are not identical to
+ * \c dg::blas1::dot
+ * @attention The fast summation is only used for **float** or **double** input.
+ * All other value types redirect to <tt> dg::blas1::vdot( dg::Product(), x, y);</tt>
+ * @param x Left Container
+ * @param y Right Container may alias x
+ * @return Scalar product as defined above
+ * @note This routine is always executed synchronously due to the
+        implicit memcpy of the result. With mpi the result is broadcasted to all processes.
+ * @copydoc hide_ContainerType
+ */
+template< class ContainerType1, class ContainerType2>
+inline auto fast_dot( const ContainerType1& x, const ContainerType2& y)
+{
+    if constexpr (std::is_floating_point_v<get_value_type<ContainerType1>> &&
+                  std::is_floating_point_v<get_value_type<ContainerType2>>)
+    {
+        DG_PROFILE_REGION( "blas1::fast_dot");
+        return dg::blas1::detail::doDot_fast( dg::Product(), x, y);
+    }
+    else
+    {
+        return dg::blas1::vdot( dg::Product(), x, y);
+    }
+}
+
 
 /*! @brief \f$ f(x_0) \otimes f(x_1) \otimes \dots \otimes f(x_{N-1}) \f$ Custom (transform) reduction
  *
@@ -215,6 +269,7 @@ template< class ContainerType, class OutputType, class BinaryOp, class UnaryOp
 inline OutputType reduce( const ContainerType& x, OutputType zero, BinaryOp
         binary_op, UnaryOp unary_op = UnaryOp())
 {
+    DG_PROFILE_REGION( "blas1::reduce");
     //init must indeed have the same type as the values of Container since op must be associative
     // The generalization would be a transform_reduce combining subroutine and reduce
     return dg::blas1::detail::doReduce(
@@ -634,6 +689,21 @@ inline void doDot_fpe( int* status, std::array<T,N>& fpe, Functor f,
 
 }
 
+// Fast reproducible (non-exact) reduction used by fast_dot
+template< class Functor, class ContainerType, class ...ContainerTypes>
+auto doDot_fast( Functor f, const ContainerType& x, const ContainerTypes& ...xs) ->
+    std::invoke_result_t<Functor, dg::get_value_type<ContainerType>, dg::get_value_type<ContainerTypes>...>
+{
+    using T = std::invoke_result_t<Functor, dg::get_value_type<ContainerType>, dg::get_value_type<ContainerTypes>...>;
+    int status = 0;
+    std::array<T, 2> fpe;
+    doDot_fpe( &status, fpe, FastSum<Functor>{f}, x, xs ...);
+    if( fpe[0] - fpe[0] != T(0) || fpe[1] - fpe[1] != T(0))
+        throw dg::Error(dg::Message(_ping_)<<"dg::blas1::fast_dot (or blas2::fast_dot) failed "
+            <<"since one of the inputs contains NaN or Inf");
+    return T(fpe[0] + fpe[1]);
+}
+
 template< class ContainerType1, class ContainerType2>
 inline std::vector<int64_t> doDot_superacc( int * status, const ContainerType1& x, const ContainerType2& y)
 {
@@ -684,9 +754,42 @@ inline void subroutine( Subroutine f, ContainerType&& x, ContainerTypes&&... xs)
     static_assert( ( dg::is_scalar_or_same_base_category<ContainerType, tensor_category>::value &&
               ... && dg::is_scalar_or_same_base_category<ContainerTypes, tensor_category>::value),
         "All container types must be either Scalar or have compatible Vector categories (AnyVector or Same base class)!");
+    DG_PROFILE_REGION( "blas1::subroutine");
     dg::blas1::detail::doSubroutine(tensor_category(), f, std::forward<ContainerType>(x), std::forward<ContainerTypes>(xs)...);
 }
 
+/**
+ * @brief Deferred \f$ f_0(x_0, x_1, ...), f_1(x_0, x_1, ...), ...\f$; Fuse a chain of subroutines into a single pass
+ *
+ * Returns a function object that, when called with a list of containers,
+ * evaluates all subroutines in order elementwise, i.e. in a single
+ * call to \c dg::blas1::subroutine. Each subroutine selects the arguments it
+ * acts on with \c dg::args. This is equivalent to
+ * a sequence of \c dg::blas1 calls, but needs only one memory pass (and one
+ * parallel region) instead of one for each call.
+ *
+ * For example
+ * @snippet{trimleft} blas1_t.cpp fused
+ *
+ * @param fs the subroutines (typically \c dg::args wrappers of
+ * @ref variadic_subroutines like \c dg::Axpby or \c dg::PointwiseDot)
+ * @return function object with signature <tt> void (ContainerTypes&&... xs)</tt>
+ * @attention All subroutines must act elementwise, i.e. on the same index of all
+ * containers; results of earlier subroutines can thus safely be read by later
+ * subroutines. The same aliasing rules as for \c dg::blas1::subroutine apply.
+ * @sa dg::Fused dg::args
+ */
+template< class Subroutine, class ...Subroutines>
+auto fused( Subroutine f, Subroutines ... fs)
+{
+    return [fuse = dg::Fused<Subroutine, Subroutines...>( f, fs...)](
+            auto&& x, auto&& ... xs)
+    {
+        dg::blas1::subroutine( fuse, std::forward<decltype(x)>(x),
+                std::forward<decltype(xs)>(xs)...);
+    };
+}
+
 /*! @brief \f$ f(g(x_{0i_0},x_{1i_1},...), y_I)\f$ (Kronecker evaluation)
  *
  * This routine elementwise evaluates \f[ f(g(x_{0i_0}, x_{1i_1}, ..., x_{(n-1)i_{n-1}}), y_{((i_{n-1} N_{n-2} +...)N_1+i_1)N_0+i_0}) \f]
@@ -758,6 +861,10 @@ inline void kronecker( ContainerType0& y, BinarySubroutine f, Functor g, const C
  * @param ps additional parameters usable for the transfer operation
  * @note it is possible to assign a \c from_ContainerType to a <tt> std::array<ContainerType, N> </tt>
 (all elements are initialized with from_ContainerType) and also a <tt> std::vector<ContainerType></tt> ( the desired size of the \c std::vector must be provided as an additional parameter)
+ * @note On the OpenMP device the memory of \c to is first touched and
+ * written in parallel with the same static partition as in the \c dg::blas1
+ * functions. On NUMA systems each part of \c to then lies in the memory of the
+ * socket whose threads later work on it (s.a. \c inc/dg/stream_b.cpp)
  * @tparam from_ContainerType must have the same data policy derived from \c AnyVectorTag as \c ContainerType (with the exception of \c std::array and \c std::vector) but can have different execution policy
  * @tparam Params in some cases additional parameters that are necessary to assign objects of Type \c ContainerType
  * @copydoc hide_ContainerType
@@ -783,6 +890,8 @@ inline void assign( const from_ContainerType& from, ContainerType& to, Params&&
  * @return \c from converted to the new format (memory is allocated accordingly)
  * @note it is possible to construct a <tt> std::array<ContainerType, N> </tt>
 (all elements are initialized with from_ContainerType) and also a <tt> std::vector<ContainerType></tt> ( the desired size of the \c std::vector must be provided as an additional parameter) given a \c from_ContainerType
+ * @note On the OpenMP device the memory of the result is first touched in
+ * parallel as in \c dg::assign
  * @tparam from_ContainerType must have the same data policy derived from \c AnyVectorTag as \c ContainerType (with the exception of \c std::array and \c std::vector) but can have different execution policy
  * @tparam Params in some cases additional parameters that are necessary to construct objects of Type \c ContainerType
  * @copydoc hide_ContainerType
@@ -810,6 +919,11 @@ inline ContainerType construct( const from_ContainerType& from, Params&& ... ps)
  * the resulting vector is exactly compatible in a call to
  * <tt> dg::kronecker( result, dg::equals(), f, x0, xs...); </tt>
  *
+ * If compiled with OpenMP the host version (\c dg::SerialTag) is
+ * computed in parallel outside of parallel regions, with results identical to
+ * the serial loop. This makes \c dg::evaluate of expensive functors on large
+ * grids parallel.
+ *
  * The MPI distributed version of this function is implemented as
  * @code{.cpp}
  * MPI_Comm comm_kron = dg::mpi_cart_kron( x0.communicator(), xs.communicator()...);
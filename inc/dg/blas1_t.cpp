@@ -319,8 +319,63 @@ TEST_CASE("blas1")
         INFO( "2*2+ 3*3 = " << result( w22) <<" (13)");
         CHECK( equal_rec( w22[0], value_type(13)));
         CHECK( equal_rec( w22[1], value_type(13)));
+
+        // Inner vectors of different sizes and nested reduction
+        std::vector<dg::DVec> u1 = { dg::DVec( 7, 1.), dg::DVec( 1000, 2.),
+            dg::DVec( 13, 3.)}, u2( u1);
+        dg::blas1::axpby( 2., u1, 1., u2);
+        CHECK( u2[0] == dg::DVec( 7, 3.));
+        CHECK( u2[1] == dg::DVec( 1000, 6.));
+        CHECK( u2[2] == dg::DVec( 13, 9.));
+        double sum = dg::blas1::reduce( u2, 0., thrust::plus<double>());
+        CHECK( sum == 7*3.+1000*6.+13*9.);
+        double max = dg::blas1::reduce( w22, -1e308, thrust::maximum<double>());
+        CHECK( max == 13.);
+    }
+}
+
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP && !defined(WITH_MPI)
+TEST_CASE( "OpenMP thread team")
+{
+    // blas1 functions called by all threads of an enclosing parallel region
+    // give the same results as called outside (dot is exact and max does
+    // not depend on the order of combination, unlike a floating point sum)
+    thrust::host_vector<double> h( 10007);
+    for( unsigned i=0; i<h.size(); i++)
+        h[i] = sin( 0.01*i);
+    dg::DVec x( h), y( h), ref_y( h);
+    std::array<dg::DVec,2> w{x, y}, ref_w{x, y};
+    dg::blas1::axpby( 2., x, 3., ref_y);
+    dg::blas1::pointwiseDot( ref_y, x, ref_y);
+    double ref_dot = dg::blas1::dot( ref_y, x);
+    double ref_max = dg::blas1::reduce( ref_y, -1e308, thrust::maximum<double>());
+    dg::blas1::axpby( 1., ref_w, 1., ref_w);
+    double ref_wdot = dg::blas1::dot( ref_w, ref_w);
+    std::vector<double> dots( omp_get_max_threads(), 0),
+        maxs( omp_get_max_threads(), 0), wdots( omp_get_max_threads(), 0);
+    int num_threads = 1;
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num();
+        #pragma omp master
+        num_threads = omp_get_num_threads();
+        dg::blas1::axpby( 2., x, 3., y);
+        dg::blas1::pointwiseDot( y, x, y);
+        dots[tid] = dg::blas1::dot( y, x);
+        maxs[tid] = dg::blas1::reduce( y, -1e308, thrust::maximum<double>());
+        dg::blas1::axpby( 1., w, 1., w);
+        wdots[tid] = dg::blas1::dot( w, w);
+    }
+    CHECK( y == ref_y);
+    CHECK( w == ref_w);
+    for( int i=0; i<num_threads; i++)
+    {
+        CHECK( dots[i] == ref_dot);
+        CHECK( maxs[i] == ref_max);
+        CHECK( wdots[i] == ref_wdot);
     }
 }
+#endif // THRUST_DEVICE_SYSTEM
 
 TEST_CASE( "Complex algebra")
 {
@@ -391,8 +446,14 @@ TEST_CASE( "Blas1 documentation")
         // Result is of complex type
         CHECK( cresult == thrust::complex<double>{200,0});
         //! [cdot]
-
-
+    }
+    SECTION( "fast_dot")
+    {
+        //! [fast_dot]
+        dg::DVec two( 100,2.0), three(100,3.0);
+        double result = dg::blas1::fast_dot(two, three);
+        CHECK( result == 600.0); //100*(2*3)
+        //! [fast_dot]
     }
     SECTION( "reduce")
     {
@@ -540,6 +601,21 @@ TEST_CASE( "Blas1 documentation")
         CHECK( four == dg::HVec( 100, 21.)); // 7*2+3+4
         //! [subroutine]
     }
+    SECTION( "fused")
+    {
+        //! [fused]
+        dg::DVec two( 100,2), three( 100,3), y(100), z(100);
+        // y = 2*two + 3; z = y*three; y = y/z in a single pass
+        dg::blas1::fused(
+            dg::args<0,1>( dg::Axpby( 2., 0.)),
+            dg::args<1>( dg::Plus( 3.)),
+            dg::args<1,2,3>( dg::PointwiseDot( 1., 0.)),
+            dg::args<3,1>( dg::PointwiseDivide( 1., 0.))
+        )( two, y, three, z);
+        CHECK( z == dg::DVec( 100, 21.)); // (2*2+3)*3
+        CHECK( y == dg::DVec( 100, 1./3.)); // 7/21
+        //! [fused]
+    }
     SECTION( "kronecker")
     {
         //! [kronecker]
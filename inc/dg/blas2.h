@@ -12,6 +12,7 @@
 #include "backend/blas2_dispatch_mpi.h"
 #endif //MPI_VERSION
 #include "backend/blas2_dispatch_vector.h"
+#include "backend/profile.h"
 
 
 /*!@file
@@ -97,6 +98,7 @@ inline auto dot( const ContainerType1& x, const MatrixType& m, const ContainerTy
                   std::is_floating_point_v<get_value_type<MatrixType>>   &&
                   std::is_floating_point_v<get_value_type<ContainerType2>>)
     {
+        DG_PROFILE_REGION( "blas2::dot");
         int status = 0;
         std::vector<int64_t> acc = dg::blas2::detail::doDot_superacc( &status,
             x,m,y);
@@ -132,6 +134,63 @@ inline get_value_type<MatrixType> dot( const MatrixType& m, const ContainerType&
 {
     return dg::blas2::dot( x, m, x);
 }
+
+/*! @brief \f$ x^T M y\f$; Fast reproducible general dot product
+ *
+ * Same as \c dg::blas2::dot( x, m, y) but the sum is computed with the fast
+ * compensated summation of \c dg::blas1::fast_dot instead of the exact
+ * (superaccumulator) sum. The result is binary reproducible for a given size
+ * of the vectors (independent of the number of threads) but not identical to
+ * \c dg::blas2::dot.
+ * For example
+ * @snippet{trimleft} blas_t.cpp fast_dot
+ * @attention The fast summation is only used for **float** or **double**
+ * input.  All other value types redirect to <tt>dg::blas1::vdot(
+ * dg::Product(), x, m, y);</tt>
+ *
+ * @param x Left input
+ * @param m The diagonal Matrix.
+ * @param y Right input (may alias \c x)
+ * @return Generalized scalar product
+ * @note This routine is always executed synchronously due to the
+    implicit memcpy of the result. With mpi the result is broadcasted to all
+    processes.
+ * @tparam MatrixType \c MatrixType has to have a category derived from \c
+ * AnyVectorTag and must be compatible with the \c ContainerTypes
+ * @sa \c dg::dot_policy
+ * @copydoc hide_ContainerType
+ */
+template< class ContainerType1, class MatrixType, class ContainerType2>
+inline auto fast_dot( const ContainerType1& x, const MatrixType& m, const ContainerType2& y)
+{
+    if constexpr (std::is_floating_point_v<get_value_type<ContainerType1>> &&
+                  std::is_floating_point_v<get_value_type<MatrixType>>   &&
+                  std::is_floating_point_v<get_value_type<ContainerType2>>)
+    {
+        DG_PROFILE_REGION( "blas2::fast_dot");
+        return dg::blas1::detail::doDot_fast( dg::Product(), x, m, y);
+    }
+    else
+    {
+        return dg::blas1::vdot( dg::Product(), x, m, y);
+    }
+}
+
+/*! @brief \f$ x^T M x\f$; Fast reproducible general dot product
+ *
+ * Alias for \c dg::blas2::fast_dot( x,m,x)
+ * @param m The diagonal Matrix
+ * @param x Right input
+ * @return Generalized scalar product
+ * @tparam MatrixType \c MatrixType has to have a category derived from \c
+ * AnyVectorTag and must be compatible with the \c ContainerTypes
+ * @copydoc hide_ContainerType
+ */
+template< class MatrixType, class ContainerType>
+inline get_value_type<MatrixType> fast_dot( const MatrixType& m, const ContainerType& x)
+{
+    return dg::blas2::fast_dot( x, m, x);
+}
 ///@cond
 namespace detail{
 //resolve tags in two stages: first the matrix and then the container type
@@ -290,6 +349,7 @@ inline void symv( get_value_type<ContainerType1> alpha,
         dg::blas1::scal( y, beta);
         return;
     }
+    DG_PROFILE_REGION( "blas2::symv");
     dg::blas2::detail::doSymv( alpha, std::forward<MatrixType>(M), x, beta, y, get_tensor_category<MatrixType>());
 }
 
@@ -326,6 +386,7 @@ inline void symv( MatrixType&& M,
                   const ContainerType1& x,
                   ContainerType2& y)
 {
+    DG_PROFILE_REGION( "blas2::symv");
     dg::blas2::detail::doSymv( std::forward<MatrixType>(M), x, y, get_tensor_category<MatrixType>());
 }
 /*! @brief Alias for \c blas2::symv \f$ y = \alpha M x + \beta y \f$;
@@ -457,6 +518,7 @@ inline void stencil(
                   const ContainerType1& x,
                   ContainerType2& y)
 {
+    DG_PROFILE_REGION( "blas2::stencil");
     dg::blas2::detail::doStencil( f, std::forward<MatrixType>(M), x, y, get_tensor_category<MatrixType>());
 }
 /**
@@ -188,6 +188,14 @@ TEST_CASE( "Blas2 documentation")
         CHECK( result == 25200); //100*(2*42*3)
         //! [dot]
     }
+    SECTION( "fast_dot")
+    {
+        //! [fast_dot]
+        dg::DVec two( 100,2), three(100,3);
+        double result = dg::blas2::fast_dot(two, 42., three);
+        CHECK( result == 25200); //100*(2*42*3)
+        //! [fast_dot]
+    }
     SECTION( "parallel_for")
     {
         //! [parallel_for]
@@ -176,9 +176,9 @@ class ChebyshevIteration
         else
         {
             dg::blas2::symv( std::forward<MatrixType1>(P), b, x);
+            dg::blas1::scal( x, 1./theta);
             if( num_iter == 1) return;
             dg::blas1::scal( m_xm1, 0.);
-            dg::blas1::scal( x, 1./theta);
         }
         for ( unsigned k=1; k<num_iter; k++)
         {
@@ -34,6 +34,7 @@
  *        @defgroup densematrix Dense matrix formats
  *        @defgroup view Vector view
  *        @defgroup typedefs Typedefs for Vectors and Matrices
+ *        @defgroup profiling Profiling regions
  *    @}
  *    @brief \#include <mpi.h> before any other dg header file
  * @}
@@ -24,6 +24,30 @@ namespace dg
 // and geometryX_elliptic_b and geometryX_refined_elliptic_b
 
 
+///@cond
+namespace detail
+{
+template<class real_type>
+std::true_type is_product_geometry( const aRealProductGeometry3d<real_type>*);
+#ifdef MPI_VERSION
+template<class real_type>
+std::true_type is_product_geometry( const aRealProductMPIGeometry3d<real_type>*);
+#endif
+std::false_type is_product_geometry( const void*);
+
+// The metric of a product geometry does not depend on z, so we store only one
+// plane, which the dg::tensor functions broadcast to all planes
+template<class Geometry>
+auto elliptic_metric( const Geometry& g)
+{
+    if constexpr( decltype( is_product_geometry( &g))::value)
+        return g.plane_metric();
+    else
+        return g.metric();
+}
+}//namespace detail
+///@endcond
+
 /*!
  * @class hide_note_jump
  *
@@ -292,8 +316,9 @@ class Elliptic2d
         dg::assign( dg::create::volume(g),        m_weights);
         dg::assign( dg::evaluate( dg::one, g),    m_precond);
         m_temp = m_tempx = m_tempy = m_weights;
-        m_chi=g.metric();
-        m_sigma = m_vol = dg::tensor::volume(m_chi);
+        m_chi=detail::elliptic_metric(g);
+        dg::assign( dg::tensor::volume(g.metric()), m_vol);
+        m_sigma = m_vol;
     }
 
     ///@copydoc hide_construct
@@ -341,6 +366,9 @@ class Elliptic2d
      *
      * @param tau The new tensor part in \f$\chi\f$ (must be positive definite)
      * @note the 3d parts in \c tau will be ignored for 2d computations
+     * @note \c tau may hold the values of a single plane only, which are
+     * then broadcast to all planes (cf. \c dg::tensor::multiply2d); this is
+     * what the constructor does with the metric of a product geometry
      * @tparam ContainerType0 must be usable in \c dg::assign to \c Container
      */
     template<class ContainerType0>
@@ -620,8 +648,9 @@ class Elliptic3d
         dg::assign( dg::create::volume(g),        m_weights);
         dg::assign( dg::evaluate( dg::one, g),    m_precond);
         m_temp = m_tempx = m_tempy = m_tempz = m_weights;
-        m_chi=g.metric();
-        m_sigma = m_vol = dg::tensor::volume(m_chi);
+        m_chi=detail::elliptic_metric(g);
+        dg::assign( dg::tensor::volume(g.metric()), m_vol);
+        m_sigma = m_vol;
     }
     ///@copydoc hide_construct
     template<class ...Params>
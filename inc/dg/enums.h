@@ -182,5 +182,12 @@ enum class coo3d : char
     z = 'z', //!< z direction
 };
 
+///@brief Summation algorithm for the scalar products in iterative solvers
+enum class dot_policy
+{
+    exact, //!< \c dg::blas2::dot: exactly rounded and binary reproducible
+    fast //!< \c dg::blas2::fast_dot: compensated sum in fixed order; reproducible for a given size
+};
+
 ///@}
 }//namespace dg
@@ -1,5 +1,7 @@
 #pragma once
+#include <limits>
 #include "pcg.h"
+#include "lgmres.h"
 
 namespace dg{
 ///@cond
@@ -150,4 +152,214 @@ struct DefaultSolver
     bool m_benchmark = true;
 };
 
+/*!@brief Jacobian-free Newton-Krylov solver for solving \f$ (y-\alpha\hat I(t,y)) = \rho\f$
+ *
+ * for given t, alpha and rho and general (nonlinear, non-self-adjoint)
+ * \f$ \hat I\f$. We apply Newton's method to
+ * \f$ F(y) := y - \alpha \hat I(t,y) - \rho = 0\f$, where in each
+ * Newton iteration the linear system \f$ J \delta = F(y_k)\f$ is solved
+ * inexactly with the right preconditioned \c dg::LGMRES method.
+ * The Jacobian \f$ J = 1 - \alpha \partial \hat I/\partial y\f$ is never
+ * formed; instead the Jacobian-vector products are approximated by
+ * finite differences
+ * \f[ Jv \approx v - \alpha\frac{\hat I(t, y + hv) - \hat I(t,y)}{h},
+ * \quad h = \sqrt{\epsilon_{\mathrm{mach}}}\frac{1+||y||}{||v||}\f]
+ * The relative accuracy \f$ \eta_k\f$ of the linear solves (the forcing
+ * term) is chosen adaptively according to choice 2 of
+ * <a href="https://doi.org/10.1137/0917003">Eisenstat and Walker, Choosing
+ * the Forcing Terms in an Inexact Newton Method, SIAM J. Sci. Comput. 17(1),
+ * 16-32 (1996)</a>
+ * \f[ \eta_k = 0.9 \left(\frac{||F(y_k)||}{||F(y_{k-1})||}\right)^2\f]
+ * with the usual safeguards. The Newton step is globalized with a
+ * backtracking line search on \f$ ||F||\f$. The augmentation vectors of \c
+ * dg::LGMRES are kept between linear solves (see \c
+ * dg::LGMRES::set_recycle) such that the Krylov information of the previous
+ * Newton iteration or the previous implicit stage is reused.
+ *
+ * The iteration stops if \f$ ||F(y)||_W < a_{\mathrm{tol}} +
+ * r_{\mathrm{tol}} ||\rho||_W\f$. The initial guess is \f$ \rho\f$.
+ * @note Per Newton iteration one evaluation of \f$ \hat I\f$ per line
+ * search step plus one evaluation per Krylov iteration is needed
+ * @note If \f$ \hat I\f$ is linear and self-adjoint \c dg::DefaultSolver is
+ * faster
+ *
+ * @copydoc hide_ContainerType
+ * @sa ARKStep DIRKStep ImExMultistep ImplicitMultistep
+ * @ingroup invert
+ */
+template<class ContainerType>
+struct NewtonKrylovSolver
+{
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>;//!< value type of vectors
+    ///No memory allocation
+    NewtonKrylovSolver(){}
+    /*!
+    * @tparam Implicit The implicit part of the right hand side.
+    * Has signature <tt> void operator()(value_type, const ContainerType&, ContainerType&)</tt>
+    * The first argument is the time, the second is the input vector, which the
+    * functor may \b not override, and the third is the output,
+    * i.e. y' = I(t, y) translates to I(t, y, y').  The two ContainerType
+    * arguments never alias each other in calls to the functor.
+    * @param im The implicit part of the differential equation.
+    * Stored as a \c std::function.
+    * @attention make sure that im lives throughout the lifetime of this
+    * object, else we'll get a dangling reference
+    * @param weights Define the norm for the stopping criterion and the scalar
+    * product in \c dg::LGMRES (also used as copyable)
+    * @param rtol relative accuracy
+    * @param atol absolute accuracy
+    * @param max_newton maximum number of Newton iterations
+    * @param max_inner forwarded to constructor of \c dg::LGMRES
+    * @param max_outer forwarded to constructor of \c dg::LGMRES (number of
+    * recycled vectors)
+    * @param max_restarts forwarded to constructor of \c dg::LGMRES
+    */
+    template<class Implicit>
+    NewtonKrylovSolver( Implicit& im, const ContainerType& weights,
+            value_type rtol, value_type atol, unsigned max_newton = 20,
+            unsigned max_inner = 20, unsigned max_outer = 3,
+            unsigned max_restarts = 10):
+        m_lgmres( weights, max_inner, max_outer, max_restarts),
+        m_weights( weights), m_f( weights), m_iy( weights), m_dx( weights),
+        m_ytrial( weights), m_rtol( rtol), m_atol( atol),
+        m_max_newton( max_newton)
+    {
+        m_im = [&im = im]( value_type t, const ContainerType& y, ContainerType&
+                yp) mutable
+        {
+            im( t, y, yp);
+        };
+        m_precond = []( value_type alpha, const ContainerType& x,
+                ContainerType& y)
+        {
+            dg::blas1::copy( x, y);
+        };
+        m_lgmres.set_recycle( true);
+        m_lgmres.set_throw_on_fail( false);
+    }
+    ///@copydoc hide_construct
+    template<class ...Params>
+    void construct( Params&& ...ps)
+    {
+        //construct and swap
+        *this = NewtonKrylovSolver( std::forward<Params>( ps)...);
+    }
+    ///@brief Set or unset performance timings during iterations
+    ///@param benchmark If true, additional output will be written to \c std::cout during solution
+    void set_benchmark( bool benchmark){ m_benchmark = benchmark;}
+    /**
+     * @brief Set a right preconditioner for the linear solves
+     *
+     * @param precond an approximation to the inverse of the Jacobian \f$
+     * (1-\alpha \partial \hat I/\partial y)^{-1}\f$ called as \c
+     * precond( alpha, x, y) where \c x is the input and \c y the output
+     * (per default the identity)
+     */
+    void set_preconditioner( std::function<void( value_type, const
+                ContainerType&, ContainerType&)> precond)
+    {
+        m_precond = precond;
+    }
+    ///@brief Return an object of same size as the object used for construction
+    ///@return A copyable object; what it contains is undefined, its size is important
+    const ContainerType& copyable()const{ return m_f;}
+    ///@brief Number of Newton iterations in the last solve
+    unsigned get_newton_iterations() const{ return m_newton;}
+    ///@brief Number of Krylov iterations (summed over all Newton iterations) in the last solve
+    unsigned get_krylov_iterations() const{ return m_krylov;}
+
+    void operator()( value_type alpha, value_type time, ContainerType& y, const
+            ContainerType& ys)
+    {
+#ifdef MPI_VERSION
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif//MPI
+        Timer ti;
+        if(m_benchmark) ti.tic();
+        dg::blas1::copy( ys, y); // take rhs as initial guess
+        const value_type tol = m_atol + m_rtol*sqrt( dg::blas2::dot( m_weights, ys));
+        const value_type sqrt_eps = sqrt( std::numeric_limits<value_type>::epsilon());
+        // F(y) = y - alpha I(t,y) - ys
+        m_im( time, y, m_iy);
+        dg::blas1::evaluate( m_f, dg::equals(), dg::PairSum(), 1., y, -alpha,
+                m_iy, -1., ys);
+        value_type nrmF = sqrt( dg::blas2::dot( m_weights, m_f));
+        value_type eta = 0.5;
+        m_newton = m_krylov = 0;
+        auto jacobian = [&]( const ContainerType& v, ContainerType& Jv)
+        {
+            value_type nrmv = sqrt( dg::blas2::dot( m_weights, v));
+            if( nrmv == 0)
+            {
+                dg::blas1::copy( 0., Jv);
+                return;
+            }
+            value_type h = sqrt_eps*(1.+sqrt( dg::blas2::dot( m_weights, y)))/nrmv;
+            dg::blas1::axpby( 1., y, h, v, m_ytrial);
+            m_im( time, m_ytrial, Jv);
+            dg::blas1::evaluate( Jv, dg::equals(), dg::PairSum(), 1., v,
+                    -alpha/h, Jv, alpha/h, m_iy);
+        };
+        auto precond = [&]( const ContainerType& x, ContainerType& px)
+        {
+            m_precond( alpha, x, px);
+        };
+        while( nrmF > tol && m_newton < m_max_newton)
+        {
+            // never solve more accurately than needed to reach tol
+            eta = std::max( eta, 0.5*tol/nrmF);
+            dg::blas1::copy( 0., m_dx);
+            m_krylov += m_lgmres.solve( jacobian, m_dx, m_f, precond, m_weights,
+                    eta, 0.);
+            // backtracking line search y_{k+1} = y_k - lambda dx
+            value_type lambda = 1., nrmF_new = nrmF;
+            for( unsigned l=0; l<m_max_linesearch; l++)
+            {
+                dg::blas1::axpby( 1., y, -lambda, m_dx, m_ytrial);
+                m_im( time, m_ytrial, m_iy);
+                dg::blas1::evaluate( m_f, dg::equals(), dg::PairSum(), 1.,
+                        m_ytrial, -alpha, m_iy, -1., ys);
+                nrmF_new = sqrt( dg::blas2::dot( m_weights, m_f));
+                if( nrmF_new <= (1.-1e-4*lambda)*nrmF)
+                    break;
+                lambda *= 0.5;
+            }
+            using std::swap;
+            swap( y, m_ytrial);
+            // Eisenstat-Walker choice 2 with safeguards
+            value_type eta_old = eta;
+            eta = 0.9*(nrmF_new*nrmF_new)/(nrmF*nrmF);
+            if( 0.9*eta_old*eta_old > 0.1)
+                eta = std::max( eta, 0.9*eta_old*eta_old);
+            eta = std::min( eta, (value_type)0.9);
+            nrmF = nrmF_new;
+            m_newton++;
+        }
+        if( m_benchmark)
+        {
+            ti.toc();
+            DG_RANK0 std::cout << "# of Newton iterations time solver: "
+                <<m_newton<<"/"<<m_max_newton<<" with "<<m_krylov
+                <<" Krylov iterations took "<<ti.diff()<<"s\n";
+        }
+        if( nrmF > tol)
+            throw dg::Fail( m_rtol, Message(_ping_)
+                <<"After "<<m_newton<<" Newton iterations with residual "
+                <<nrmF<<" and atol "<<m_atol);
+    }
+    private:
+    std::function<void( value_type, const ContainerType&, ContainerType&)>
+        m_im;
+    std::function<void( value_type, const ContainerType&, ContainerType&)>
+        m_precond;
+    dg::LGMRES<ContainerType> m_lgmres;
+    ContainerType m_weights, m_f, m_iy, m_dx, m_ytrial;
+    value_type m_rtol, m_atol;
+    unsigned m_max_newton, m_max_linesearch = 10;
+    unsigned m_newton = 0, m_krylov = 0;
+    bool m_benchmark = true;
+};
+
 }//namespace dg
@@ -102,3 +102,65 @@ TEST_CASE( "Default solver interface")
     CHECK( abs( res.i - 4503686873653514213) < 2);
 }
 
+
+TEST_CASE( "Newton Krylov solver")
+{
+#ifdef WITH_MPI
+    MPI_Comm comm = dg::mpi_cart_create( MPI_COMM_WORLD, {0,0}, {0,1});
+#endif
+    const double lx = M_PI;
+    const double ly = 2.*M_PI;
+    const dg::bc bcx = dg::DIR;
+    const dg::bc bcy = dg::PER;
+
+    unsigned n = 3, Nx = 48, Ny = 48;
+	dg::x::CartesianGrid2d grid( 0, lx, 0, ly, n, Nx, Ny, bcx, bcy
+#ifdef WITH_MPI
+    , comm
+#endif
+    );
+    dg::x::DVec w2d = dg::create::weights( grid);
+    Diffusion<dg::x::CartesianGrid2d, dg::x::DMatrix, dg::x::DVec> diff( grid, nu, order);
+    const dg::x::DVec solution = dg::evaluate( sol, grid);
+    const double norm = dg::blas2::dot( w2d, solution);
+    dg::x::DVec x = dg::evaluate( initial, grid), error( solution);
+    SECTION( "Linear implicit part")
+    {
+        const dg::x::DVec b = dg::evaluate( rhs, grid);
+        dg::NewtonKrylovSolver<dg::x::DVec> solver( diff, w2d, 1e-10, 1e-10);
+        solver.set_benchmark(false);
+        solver( alpha, 1., x, b);
+        INFO( "Newton iterations "<<solver.get_newton_iterations()
+            <<" Krylov iterations "<<solver.get_krylov_iterations());
+        dg::blas1::axpby( 1.,x,-1., solution, error);
+        double err = sqrt( dg::blas2::dot( w2d, error)/norm);
+        INFO( " Error "<<err);
+        CHECK( err < 1e-6);
+    }
+    SECTION( "Nonlinear implicit part")
+    {
+        // I(y) = Diffusion(y) - y^3
+        auto nonlinear = [&]( double t, const dg::x::DVec& y, dg::x::DVec& yp)
+        {
+            diff( t, y, yp);
+            dg::blas1::evaluate( yp, dg::plus_equals(), []DG_DEVICE( double y)
+                    { return -y*y*y;}, y);
+        };
+        dg::x::DVec b = dg::evaluate( []( double x, double y){
+                return rhs(x,y) + alpha*sol(x,y)*sol(x,y)*sol(x,y);}, grid);
+        dg::NewtonKrylovSolver<dg::x::DVec> solver( nonlinear, w2d, 1e-10, 1e-10);
+        solver.set_benchmark(false);
+        // Solve twice to exercise the recycled Krylov vectors
+        for( unsigned u=0; u<2; u++)
+        {
+            solver( alpha, 1., x, b);
+            INFO( "Newton iterations "<<solver.get_newton_iterations()
+                <<" Krylov iterations "<<solver.get_krylov_iterations());
+            dg::blas1::axpby( 1.,x,-1., solution, error);
+            double err = sqrt( dg::blas2::dot( w2d, error)/norm);
+            INFO( " Error "<<err);
+            CHECK( err < 1e-6);
+            CHECK( solver.get_newton_iterations() < 10);
+        }
+    }
+}
@@ -69,6 +69,7 @@ class LGMRES
     LGMRES( const ContainerType& copyable, unsigned max_inner, unsigned max_outer, unsigned max_restarts):
         m_tmp(copyable),
         m_dx(copyable),
+        m_total(copyable),
         m_residual( copyable),
         m_maxRestarts( max_restarts),
         m_inner_m( max_inner),
@@ -112,6 +113,26 @@ class LGMRES
     void set_throw_on_fail( bool throw_on_fail){
         m_throw_on_fail = throw_on_fail;
     }
+    /**
+     * @brief Keep the augmentation vectors between calls to \c solve
+     *
+     * Per default each call to \c solve starts with an empty set of
+     * augmentation vectors (the approximations to the error of previous
+     * restart cycles). If \c recycle is true the vectors of the last call,
+     * together with the total correction that call computed, are kept and
+     * used to augment the Krylov space of the first cycle of the next call
+     * (where they are used first, so even solves that converge within the
+     * first cycle profit). This is worth it if a sequence of similar systems is solved (e.g.
+     * in a Newton iteration). The matrix-vector products of the recycled
+     * vectors are recomputed with the new matrix at the beginning of a solve
+     * (which costs at most \c max_outer matrix-vector products).
+     * @param recycle If true, recycle augmentation vectors
+     * @note the default value is false
+     */
+    void set_recycle( bool recycle){
+        m_recycle = recycle;
+        m_stored = 0;
+    }
     ///@brief Return an object of same size as the object used for construction
     ///@return A copyable object; what it contains is undefined, its size is important
     const ContainerType& copyable()const{ return m_tmp;}
@@ -155,13 +176,21 @@ class LGMRES
     void Update(Preconditioner&& P, ContainerType &dx, ContainerType0 &x,
             unsigned dimension, const std::vector<std::vector<value_type>> &H,
             std::vector<value_type> &s, const std::vector<const ContainerType*> &W);
+    // shift the augmentation vectors and put dx in front
+    void store_outer( const ContainerType& dx)
+    {
+        std::rotate(m_outer_w.rbegin(),m_outer_w.rbegin()+1,m_outer_w.rend());
+        std::rotate(m_outer_Az.rbegin(),m_outer_Az.rbegin()+1,m_outer_Az.rend());
+        dg::blas1::copy(dx,m_outer_w[0]);
+    }
     std::vector<std::array<value_type,2>> m_givens;
     std::vector<std::vector<value_type>> m_H, m_HH;
-    ContainerType m_tmp, m_dx, m_residual;
+    ContainerType m_tmp, m_dx, m_total, m_residual;
     std::vector<ContainerType> m_V, m_outer_w, m_outer_Az;
     std::vector<value_type> m_s;
     unsigned m_maxRestarts, m_inner_m, m_outer_k, m_krylovDimension;
-    bool m_converged = true, m_throw_on_fail = true;
+    unsigned m_stored = 0;
+    bool m_converged = true, m_throw_on_fail = true, m_recycle = false;
 };
 ///@cond
 
@@ -218,6 +247,10 @@ unsigned LGMRES< ContainerType>::solve( Matrix&& A, ContainerType0& x, const Con
     m_Vptr.assign(m_krylovDimension+1,nullptr);
     for( unsigned i=0; i<m_krylovDimension+1; i++)
         m_Vptr[i] = &m_V[i];
+    if( !m_recycle)
+        m_stored = 0;
+    else
+        dg::blas1::copy( 0., m_total);
     do
 	{
         dg::blas2::gemv(std::forward<Matrix>(A),x,m_residual);
@@ -226,6 +259,16 @@ unsigned LGMRES< ContainerType>::solve( Matrix&& A, ContainerType0& x, const Con
         counter ++;
         if( rho < tol) //if x happens to be the solution
             return counter;
+        if( restartCycle == 0 && m_recycle)
+        {
+            // The matrix may have changed since the last solve
+            for( unsigned i=0; i<m_stored; i++)
+            {
+                dg::blas2::gemv(std::forward<Preconditioner>(P),m_outer_w[i],m_tmp);
+                dg::blas2::gemv(std::forward<Matrix>(A),m_tmp,m_outer_Az[i]);
+                counter++;
+            }
+        }
         // The first vector in the Krylov subspace is the normalized residual.
         dg::blas1::axpby(1.0/rho,m_residual,0.,m_V[0]);
 
@@ -233,17 +276,21 @@ unsigned LGMRES< ContainerType>::solve( Matrix&& A, ContainerType0& x, const Con
         for(unsigned lupe=1;lupe<=m_krylovDimension;++lupe)
 			m_s[lupe] = 0.0;
 
+        // Recycled vectors come first in the first cycle such that they are
+        // used even if the solve converges before the Krylov space is full
+        const bool outer_first = restartCycle == 0 && m_recycle;
+        const unsigned outer_w_count = m_stored;
+        const unsigned outer_begin = outer_first ? 0 : m_krylovDimension-outer_w_count;
 		// Go through and generate the pre-determined number of vectors for the Krylov subspace.
 		for( unsigned iteration=0;iteration<m_krylovDimension;++iteration)
 		{
-            unsigned outer_w_count = std::min(restartCycle,m_outer_k);
-            if(iteration < m_krylovDimension-outer_w_count){
+            if( iteration < outer_begin || iteration >= outer_begin+outer_w_count){
                 m_W[iteration] = &m_V[iteration];
                 dg::blas2::gemv(std::forward<Preconditioner>(P),*m_W[iteration],m_tmp);
                 dg::blas2::gemv(std::forward<Matrix>(A),m_tmp,m_V[iteration+1]);
                 counter++;
-            } else if( iteration < m_krylovDimension){ // size of W
-                unsigned w_idx = iteration - (m_krylovDimension - outer_w_count);
+            } else { // size of W
+                unsigned w_idx = iteration - outer_begin;
                 m_W[iteration] = &m_outer_w[w_idx];
                 dg::blas1::copy( m_outer_Az[w_idx], m_V[iteration+1]);
             }
@@ -317,18 +364,23 @@ unsigned LGMRES< ContainerType>::solve( Matrix&& A, ContainerType0& x, const Con
             if( rho < tol)
 			{
                 Update(std::forward<Preconditioner>(P),m_dx,x,iteration,m_H,m_s,m_W);
+                // keep the total correction of this solve for the next one
+                // (its matrix-vector product is recomputed there)
+                if( m_recycle && m_outer_k > 0)
+                {
+                    dg::blas1::axpby( 1., m_dx, 1., m_total);
+                    store_outer( m_total);
+                    m_stored = std::min( m_stored+1, m_outer_k);
+                }
                 return counter;
             }
         }
         Update(std::forward<Preconditioner>(P),m_dx,x,m_krylovDimension-1,m_H,m_s,m_W);
-        if( m_outer_k > 1)
-        {
-            std::rotate(m_outer_w.rbegin(),m_outer_w.rbegin()+1,m_outer_w.rend());
-            std::rotate(m_outer_Az.rbegin(),m_outer_Az.rbegin()+1,m_outer_Az.rend());
-        }
+        if( m_recycle)
+            dg::blas1::axpby( 1., m_dx, 1., m_total);
         if( m_outer_k > 0)
         {
-            dg::blas1::copy(m_dx,m_outer_w[0]);
+            store_outer( m_dx);
             // compute A P dx
             std::vector<value_type> coeffs( m_krylovDimension+1, 0.);
             for( unsigned i=0; i<m_krylovDimension+1; i++)
@@ -338,6 +390,7 @@ unsigned LGMRES< ContainerType>::solve( Matrix&& A, ContainerType0& x, const Con
                     coeffs[i] = DG_FMA( m_HH[i][k],m_s[k], coeffs[i]);
             }
             dg::blas2::gemv( dg::asDenseMatrix( m_Vptr), coeffs, m_outer_Az[0]);
+            m_stored = std::min( m_stored+1, m_outer_k);
         }
 
         restartCycle ++;
@@ -9,6 +9,7 @@
 #include "chebyshev.h"
 #include "eve.h"
 #include "backend/timer.h"
+#include "backend/profile.h"
 #ifdef MPI_VERSION
 #include "topology/mpi_projection.h"
 #endif
@@ -198,6 +199,7 @@ void nested_iterations(
     std::vector<MatrixType0>& ops, ContainerType0& x, const ContainerType1& b,
     std::vector<MatrixType1>& inverse_ops, NestedGrids& nested_grids)
 {
+    DG_PROFILE_REGION( "multigrid::nested_iterations");
     NestedGrids& nested = nested_grids;
     // compute residual r = b - A x
     dg::apply(ops[0], x, nested.r(0));
@@ -492,6 +494,10 @@ void fmg_solve(
 * @note The preconditioner and weights for the \c dg::PCG solver are taken from the
 * \c precond() and \c weights() method in the \c MatrixType class
 *
+* Alternatively, the \c solve methods can use a single symmetric multigrid V-
+* or W-cycle as the preconditioner of a \c dg::PCG solve on the finest grid
+* (see \c set_solver_type)
+*
 * @snippet elliptic2d_b.cpp multigrid
 * @copydoc hide_geometry_matrix_container
 * @sa \c Extrapolation to generate an initial guess
@@ -573,6 +579,19 @@ struct MultigridCG2d
      * @param new_max new maximum number of iterations allowed at stage 0
     */
     void set_max_iter(unsigned new_max){ m_pcg[0].set_max(new_max);}
+    /**
+     * @brief Set the algorithm for the scalar products of the PCG solver at a stage
+     *
+     * Since the (exact) dot product is the main performance bottleneck on the
+     * coarse grids it can pay off to use \c dg::dot_policy::fast there
+     * while keeping \c dg::dot_policy::exact on the fine grid.
+     * @param stage the stage (must be smaller than \c num_stages())
+     * @param policy new policy for the \c dg::PCG solver at \c stage
+     * @sa \c dg::PCG::set_dot_policy
+    */
+    void set_dot_policy( unsigned stage, dg::dot_policy policy){
+        m_pcg.at(stage).set_dot_policy( policy);
+    }
     /**
      *@brief Set or unset performance timings during iterations
      *@param benchmark If true, additional output will be written to \c std::cout during solution
@@ -585,6 +604,74 @@ struct MultigridCG2d
         m_message = message;
     }
 
+    /**
+     * @brief Choose between nested iterations and multigrid preconditioned CG
+     *
+     * In the "nested" mode (the default) the \c solve methods use \c
+     * dg::nested_iterations with a full \c dg::PCG solve on every stage.
+     * In the "vcycle" and "wcycle" modes the \c solve methods solve the
+     * equation on the finest grid with \c dg::PCG, where the preconditioner
+     * is one symmetric multigrid V-cycle (or W-cycle) in correction scheme with
+     * zero initial guess:
+     * - Smooth \f$ f(x^h) = b^h\f$ with \c num_smooth smoothing steps and initial guess 0
+     * - Project the residual \f$ b^{2h} = P(b^h - f(x^h))\f$
+     * - Recursively call the cycle (once for V, twice for W) or solve \f$ f(x^{2h}) = b^{2h}\f$ with PCG on the coarsest grid
+     * - Correct \f$ x^h = x^h + I x^{2h}\f$
+     * - Smooth \f$ f(x^h) = b^h\f$ with \c num_smooth smoothing steps
+     * .
+     * Since pre- and post-smoother are the same polynomial in \f$ PA\f$ and
+     * the projection is the adjoint of the interpolation in the weighted scalar
+     * product the cycle is a self-adjoint operator if the equation on the
+     * coarsest grid is solved exactly. The PCG solve on the coarsest grid to a
+     * relative accuracy makes the cycle slightly nonlinear, i.e. an inexact
+     * preconditioner. The outer PCG converges as with the exact cycle as long
+     * as this perturbation stays well below the accuracy of the outer solve,
+     * which is why the coarse accuracy is at most \f$ 10^{-2}\f$ times the
+     * outer accuracy.
+     * The smoothers need an estimate of the largest Eigenvalue \f$\lambda_\max\f$ of
+     * \f$ PA\f$ on each stage, which is computed with \c dg::EVE (to a relative
+     * accuracy of 1e-2) at the beginning of each \c solve call.
+     * @param type One of "nested", "vcycle" or "wcycle"
+     * @param smoother One of "chebyshev" (Chebyshev iteration on the
+     * interval \f$ [0.1, 1.1]\lambda_\max\f$) or "jacobi" (damped Jacobi
+     * iteration \f$ x \leftarrow x + \frac{4}{3\lambda_\max} P(b-Ax)\f$
+     * with the operator's \c precond() as the inverse diagonal)
+     * @param num_smooth number of pre- and post-smoothing steps (matrix
+     * applications) on each stage (3 is a good start)
+     * @note In the cycle modes \c eps[0] is the accuracy of the outer PCG
+     * and \c <tt>min(eps[stages-1], 1e-2*eps[0])</tt> the relative accuracy of
+     * the solve on the coarsest grid, all other values are ignored
+     * @note For \c stages==1 all modes are equivalent to a single PCG solve
+     * @note The \c ops[u] need to provide \c precond() and \c weights() methods
+     */
+    void set_solver_type( std::string type, std::string smoother = "chebyshev", unsigned num_smooth = 3)
+    {
+        if( type == "nested")
+            m_gamma = 0;
+        else if( type == "vcycle")
+            m_gamma = 1;
+        else if( type == "wcycle")
+            m_gamma = 2;
+        else
+            throw Error( Message(_ping_)<<"Multigrid type "<<type<<" not recognized! Use nested, vcycle or wcycle");
+        if( smoother != "chebyshev" && smoother != "jacobi")
+            throw Error( Message(_ping_)<<"Multigrid smoother "<<smoother<<" not recognized! Use chebyshev or jacobi");
+        m_smoother = smoother;
+        m_num_smooth = num_smooth;
+        if( m_gamma != 0 && m_cheby.size() != m_stages)
+        {
+            m_cheby.resize( m_stages);
+            m_eve.resize( m_stages);
+            m_ev.resize( m_stages, 1.);
+            for( unsigned u=0; u<m_stages; u++)
+            {
+                m_cheby[u].construct( m_nested.x(u));
+                m_eve[u].construct( m_nested.x(u), 20);
+                m_eve[u].set_throw_on_fail( false);
+            }
+        }
+    }
+
     ///@brief Return an object of same size as the object used for construction on the finest grid
     ///@return A copyable object; what it contains is undefined, its size is important
     const Container& copyable() const {return m_nested.copyable();}
@@ -630,6 +717,8 @@ struct MultigridCG2d
         int rank;
         MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 #endif //MPI
+        if( m_gamma != 0 && m_stages > 1)
+            return cycle_solve( ops, x, b, eps);
         std::vector<unsigned> number(m_stages);
         std::vector<std::function<void( const ContainerType1&, ContainerType0&)> >
             multi_inv_pol(m_stages);
@@ -638,17 +727,22 @@ struct MultigridCG2d
             multi_inv_pol[u] = [&, u, &pcg = m_pcg[u], &pol = ops[u]](
             const auto& y, auto& x)
             {
+                DG_PROFILE_REGION( "multigrid::stage");
+                // dg::Timer synchronizes all MPI processes
                 dg::Timer t;
-                t.tic();
+                if( m_benchmark)
+                    t.tic();
                 if ( u == 0)
                     number[u] = pcg.solve( pol, x, y, pol.precond(),
                             pol.weights(), eps[u], 1, 1);
                 else
                     number[u] = pcg.solve( pol, x, y, pol.precond(),
                             pol.weights(), eps[u], 1, 10);
-                t.toc();
                 if( m_benchmark)
+                {
+                    t.toc();
                     DG_RANK0 std::cout << "# `"<<m_message<<"` stage: " << u << ", iter: " << number[u] << ", took "<<t.diff()<<"s\n";
+                }
             };
         }
         nested_iterations( ops, x, b, multi_inv_pol, m_nested);
@@ -657,11 +751,127 @@ struct MultigridCG2d
     }
 
   private:
+    template<class MatrixType, class ContainerType0, class ContainerType1>
+    std::vector<unsigned> cycle_solve( std::vector<MatrixType>& ops, ContainerType0&  x, const ContainerType1& b, const std::vector<value_type>& eps)
+    {
+#ifdef MPI_VERSION
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif //MPI
+        std::vector<unsigned> number(m_stages, m_num_smooth);
+        number[m_stages-1] = 0;
+        bool ev_ready = false;
+        // keep the inexact coarse solve well below the outer accuracy
+        const value_type eps_coarse = std::min( eps[m_stages-1], (value_type)1e-2*eps[0]);
+        auto precond = [&]( const auto& r, auto& z)
+        {
+            if( !ev_ready)
+            {
+                // the first residual is a good right hand side for EVE
+                dg::blas1::copy( r, m_nested.r(0));
+                for( unsigned u=0; u<m_stages-1; u++)
+                {
+                    if( u > 0)
+                        dg::blas2::symv( m_nested.projection(u-1),
+                                m_nested.r(u-1), m_nested.r(u));
+                    dg::blas1::copy( 0., m_nested.x(u));
+                    m_eve[u].solve( ops[u], m_nested.x(u), m_nested.r(u),
+                        ops[u].precond(), ops[u].weights(), m_ev[u], 1e-2);
+                }
+                ev_ready = true;
+            }
+            dg::blas1::copy( r, m_nested.b(0));
+            cycle( ops, 0, true, eps_coarse, number[m_stages-1]);
+            dg::blas1::copy( m_nested.x(0), z);
+        };
+        DG_PROFILE_REGION( "multigrid::cycle_solve");
+        dg::Timer t;
+        if( m_benchmark)
+            t.tic();
+        number[0] = m_pcg[0].solve( ops[0], x, b, precond, ops[0].weights(),
+                eps[0], 1, 1);
+        if( m_benchmark)
+        {
+            t.toc();
+            DG_RANK0 std::cout << "# `"<<m_message<<"` multigrid PCG iter: "
+                << number[0] << ", coarse iter: "<<number[m_stages-1]
+                <<", took "<<t.diff()<<"s\n";
+        }
+        return number;
+    }
+    // x(p) READ-write, b(p) READ only, r(p) scratch
+    template<class MatrixType>
+    void smooth( MatrixType& op, unsigned p, bool x_is_zero)
+    {
+        DG_PROFILE_REGION( "multigrid::smooth");
+        if( m_smoother == "chebyshev")
+        {
+            m_cheby[p].solve( op, m_nested.x(p), m_nested.b(p), op.precond(),
+                0.1*m_ev[p], 1.1*m_ev[p], m_num_smooth, x_is_zero);
+            return;
+        }
+        value_type omega = 4./3./m_ev[p];
+        unsigned k = 0;
+        if( x_is_zero && m_num_smooth > 0)
+        {
+            dg::blas1::pointwiseDot( omega, op.precond(), m_nested.b(p), 0.,
+                    m_nested.x(p));
+            k = 1;
+        }
+        for( ; k<m_num_smooth; k++)
+        {
+            dg::apply( op, m_nested.x(p), m_nested.r(p));
+            dg::blas1::axpby( 1., m_nested.b(p), -1., m_nested.r(p));
+            dg::blas1::pointwiseDot( omega, op.precond(), m_nested.r(p), 1.,
+                    m_nested.x(p));
+        }
+    }
+    // Linear (correction scheme) multigrid cycle beginning on grid p < stages-1
+    // x[p]    READ-write, initial guess on input (unless x_is_zero), solution on output
+    // b[p]    READ only, right hand side on current stage
+    // r[p]    write only, residuum on current stage
+    // x[p+1], b[p+1], r[p+1] write only
+    template<class MatrixType>
+    void cycle( std::vector<MatrixType>& ops, unsigned p, bool x_is_zero,
+        value_type eps_coarse, unsigned& number_coarse)
+    {
+        smooth( ops[p], p, x_is_zero);
+        dg::apply( ops[p], m_nested.x(p), m_nested.r(p));
+        dg::blas1::axpby( 1., m_nested.b(p), -1., m_nested.r(p));
+        dg::blas2::symv( m_nested.projection(p), m_nested.r(p), m_nested.b(p+1));
+        if( p+1 == m_stages-1)
+        {
+            dg::blas1::copy( 0., m_nested.x(p+1));
+            // no absolute tolerance: the preconditioner should not depend
+            // on the norm of the residual
+            try{
+                number_coarse = m_pcg[p+1].solve( ops[p+1], m_nested.x(p+1),
+                    m_nested.b(p+1), ops[p+1].precond(), ops[p+1].weights(),
+                    eps_coarse, 0, 10);
+            }catch( dg::Error& err){
+                err.append_line( dg::Message(_ping_)<<"ERROR on coarsest stage "<<p+1<<" of multigrid cycle");
+                throw;
+            }
+        }
+        else
+        {
+            for( unsigned u=0; u<m_gamma; u++)
+                cycle( ops, p+1, u==0, eps_coarse, number_coarse);
+        }
+        dg::blas2::symv( 1., m_nested.interpolation(p), m_nested.x(p+1), 1.,
+                m_nested.x(p));
+        smooth( ops[p], p, false);
+    }
     dg::NestedGrids<Geometry, Matrix, Container> m_nested;
     std::vector< PCG<Container> > m_pcg;
     unsigned m_stages;
     bool m_benchmark = true;
     std::string m_message = "Nested Iterations";
+    unsigned m_gamma = 0, m_num_smooth = 3;
+    std::string m_smoother = "chebyshev";
+    std::vector< ChebyshevIteration<Container> > m_cheby;
+    std::vector< EVE<Container> > m_eve;
+    std::vector< value_type> m_ev;
 
 };
 ///@}
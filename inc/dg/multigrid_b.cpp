@@ -174,6 +174,23 @@ int main()
     std::cout << " Error of nested iterations "<<err<<"\n";
     std::cout << "Took "<<t.diff()<<"s\n\n";
     ////////////////////////////////////////////////////
+    for( std::string type : {"vcycle", "wcycle"})
+    for( std::string smoother : {"chebyshev", "jacobi"})
+    {
+        std::cout << "MULTIGRID "<<type<<" PCG WITH "<<smoother<<" SMOOTHER:\n";
+        multigrid.set_solver_type( type, smoother, nu1);
+        x = dg::evaluate( initial, grid);
+        t.tic();
+        multigrid.solve( multi_pol, x, b, {eps,eps,eps} );
+        t.toc();
+        error = solution;
+        dg::blas1::axpby( 1.,x,-1., solution, error);
+        err = sqrt( dg::blas2::dot( w2d, error)/norm);
+        std::cout << " Error of multigrid PCG "<<err<<"\n";
+        std::cout << "Took "<<t.diff()<<"s\n\n";
+    }
+    multigrid.set_solver_type( "nested");
+    ////////////////////////////////////////////////////
     std::cout << "MULTIGRID NESTED ITERATIONS WITH CHEBYSHEV SOLVE:\n";
     x = dg::evaluate( initial, grid);
     t.tic();
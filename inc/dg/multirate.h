@@ -0,0 +1,176 @@
+#pragma once
+
+#include <tuple>
+#include "runge_kutta.h"
+
+/*! @file
+ * @brief Multirate explicit ODE-integrators
+ */
+
+namespace dg{
+
+///@addtogroup time
+///@{
+
+/**
+* @brief Multirate infinitesimal step (MIS) for equations with fast and slow time scales
+* \f$ \dot u = F(t,u) + S(t,u)\f$
+*
+* The slow part \f$ S\f$ is integrated with an explicit (slow) Butcher tableau
+* with coefficients \f$ a_{ij},\ b_j,\ c_i\f$ and large step \f$\Delta t\f$
+* while in each slow stage the fast part \f$ F\f$ is integrated
+* with \c m substeps of an explicit (fast) Runge-Kutta method
+* (\f$ a_{sj} := b_j\f$, \f$ c_s := 1\f$, \f$ Y_0 = u^n\f$):
+* \f[
+\begin{align}
+    K_j &= S\left(t^n + c_j\Delta t, Y_j\right) \\
+    \dot v_i(\tau) &= F\left( t^n + c_{i-1}\Delta t + \tau, v_i(\tau)\right)
+    + \frac{1}{c_i-c_{i-1}}\sum_{j=0}^{i-1} (a_{ij} - a_{i-1,j}) K_j, \quad v_i(0) = Y_{i-1} \\
+    Y_i &= v_i\left( (c_i - c_{i-1}) \Delta t\right), \quad i=1,\dots,s \\
+    u^{n+1} &= Y_s
+ \end{align}
+\f]
+* If \f$ c_i = c_{i-1}\f$ the fast integration is skipped and
+* \f$ Y_i = Y_{i-1} + \Delta t \sum_{j=0}^{i-1} (a_{ij} - a_{i-1,j}) K_j\f$.
+* If \f$ F=0\f$ the method reduces to the slow Runge-Kutta method.
+* The method is taken from
+* <a href="https://doi.org/10.1007/s10543-009-0248-5">Wensch, Knoth, Galant, Multirate infinitesimal step methods for atmospheric flow simulation, BIT Numer Math 49, 449-473 (2009)</a>
+* and is a special case of the MRI-GARK methods by
+* <a href="https://doi.org/10.1137/18M1205492">Sandu, A Class of Multirate Infinitesimal GARK Methods, SIAM J. Numer. Anal. 57(5), 2300-2327 (2019)</a>
+*
+* The typical use is a right hand side where the slow part is expensive
+* (e.g. contains an elliptic solve) and the fast part is cheap (e.g. parallel
+* dynamics). The slow part is evaluated only once per slow stage.
+* @note The method is second order accurate if both the slow and the fast
+* tableau are at least second order (even if the slow tableau is of higher order)
+* @attention The slow tableau must be explicit with \f$ c_0 = 0\f$ and
+* non-decreasing \f$ 0 \leq c_i\leq 1\f$
+* @note Uses only \c dg::blas1 routines to integrate one step.
+* @copydoc hide_ContainerType
+*/
+template<class ContainerType>
+struct MultirateStep
+{
+    using value_type = get_value_type<ContainerType>;//!< the value type of the time variable (float or double)
+    using container_type = ContainerType; //!< the type of the vector class in use
+    ///@brief No memory allocation
+    MultirateStep() = default;
+    /**
+    * @brief Reserve internal workspace for the integration
+    *
+    * @param slow_tableau Tableau, name or identifier that \c ConvertsToButcherTableau
+    * (e.g. "Kutta-3-3")
+    * @param fast_tableau Tableau, name or identifier that \c ConvertsToButcherTableau
+    * (e.g. "Runge-Kutta-4-4")
+    * @param copyable vector of the size that is later used in \c step (
+     it does not matter what values \c copyable contains, but its size is important;
+     the \c step method can only be called with vectors of the same size)
+    * @param num_substeps The number of fast steps \c m per slow stage
+    */
+    MultirateStep( ConvertsToButcherTableau<value_type> slow_tableau,
+            ConvertsToButcherTableau<value_type> fast_tableau,
+            const ContainerType& copyable, unsigned num_substeps):
+        m_rk( slow_tableau), m_fast( fast_tableau, copyable),
+        m_k( m_rk.num_stages(), copyable), m_force( copyable), m_v( copyable),
+        m_substeps( num_substeps)
+    {
+        unsigned s = m_rk.num_stages();
+        if( m_rk.isImplicit() || m_rk.c(0) != 0)
+            throw Error( Message(_ping_)<<"Slow tableau in MultirateStep must be explicit with c_0 = 0!");
+        for( unsigned i=1; i<s; i++)
+            if( m_rk.c(i) < m_rk.c(i-1) || m_rk.c(i) > 1)
+                throw Error( Message(_ping_)<<"Slow tableau in MultirateStep must have non-decreasing c_i in [0,1]!");
+        // the forcing changes from stage to stage
+        m_fast.ignore_fsal();
+    }
+    ///@copydoc hide_construct
+    template<class ...Params>
+    void construct( Params&& ...ps)
+    {
+        //construct and swap
+        *this = MultirateStep( std::forward<Params>( ps)...);
+    }
+    ///@copydoc hide_copyable
+    const ContainerType& copyable()const{ return m_v;}
+    ///@brief Set the number of fast steps per slow stage
+    ///@param num_substeps new number of substeps
+    void set_substeps( unsigned num_substeps){ m_substeps = num_substeps;}
+    ///@brief Get the number of fast steps per slow stage
+    unsigned get_substeps( ) const{ return m_substeps;}
+
+    /**
+    * @brief Advance one (slow) step
+    *
+    * @tparam SlowRHS The slow part of the right hand side
+    * (with the same signature as ExplicitRHS below)
+    * @tparam FastRHS The fast part of the right hand side
+    * (with the same signature as ExplicitRHS below)
+    * @copydoc hide_explicit_rhs
+    * @param ode the <slow rhs, fast rhs> functor.
+    * Typically \c std::tie(slow_rhs, fast_rhs)
+    * @param t0 start time
+    * @param u0 value at \c t0
+    * @param t1 (write only) end time ( equals \c t0+dt on return, may alias \c t0)
+    * @param u1 (write only) contains result on return (may alias u0)
+    * @param dt the slow timestep
+    * @note The slow right hand side is called \c s times, the fast right hand
+    * side \c m times the number of stages of the fast tableau per
+    * slow stage with \f$ c_i\neq c_{i-1}\f$
+    */
+    template<class SlowRHS, class FastRHS>
+    void step( const std::tuple<SlowRHS, FastRHS>& ode, value_type t0, const ContainerType& u0, value_type& t1, ContainerType& u1, value_type dt);
+    ///@brief Global order of the method (at most 2)
+    unsigned order() const {
+        return std::min( 2u, std::min( m_rk.order(), m_fast.order()));
+    }
+    ///@brief Number of slow stages
+    unsigned num_stages() const{
+        return m_rk.num_stages();
+    }
+  private:
+    ButcherTableau<value_type> m_rk;
+    ERKStep<ContainerType> m_fast;
+    std::vector<ContainerType> m_k;
+    ContainerType m_force, m_v;
+    unsigned m_substeps = 1;
+};
+
+///@cond
+template<class ContainerType>
+template<class SlowRHS, class FastRHS>
+void MultirateStep<ContainerType>::step( const std::tuple<SlowRHS, FastRHS>& ode, value_type t0, const ContainerType& u0, value_type& t1, ContainerType& u1, value_type dt)
+{
+    unsigned s = m_rk.num_stages();
+    std::vector<const ContainerType*> kptr = dg::asPointers( m_k);
+    dg::blas1::copy( u0, m_v); // Y_0
+    value_type dc = 0;
+    auto forced = [&]( value_type t, const ContainerType& y, ContainerType& yp)
+    {
+        std::get<1>(ode)( t, y, yp);
+        dg::blas1::axpby( 1./dc, m_force, 1., yp);
+    };
+    for( unsigned i=1; i<=s; i++)
+    {
+        value_type cm1 = m_rk.c(i-1), ci = ( i==s ? 1. : m_rk.c(i));
+        std::get<0>(ode)( DG_FMA( cm1, dt, t0), m_v, m_k[i-1]);
+        std::vector<value_type> coeffs( i);
+        for( unsigned j=0; j<i; j++)
+            coeffs[j] = (i==s ? m_rk.b(j) : m_rk.a(i,j)) - m_rk.a(i-1,j);
+        dc = ci - cm1;
+        if( dc == 0)
+        {
+            dg::blas2::gemv( dt, dg::asDenseMatrix(kptr,i), coeffs, 1., m_v);
+            continue;
+        }
+        dg::blas2::gemv( dg::asDenseMatrix(kptr,i), coeffs, m_force);
+        value_type tau = DG_FMA( cm1, dt, t0), h = dc*dt/(value_type)m_substeps;
+        for( unsigned k=0; k<m_substeps; k++)
+            m_fast.step( forced, tau, m_v, tau, m_v, h);
+    }
+    dg::blas1::copy( m_v, u1);
+    t1 = t0 + dt;
+}
+///@endcond
+///@}
+
+}//namespace dg
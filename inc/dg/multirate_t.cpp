@@ -0,0 +1,66 @@
+#include <iostream>
+#include <iomanip>
+#include <array>
+
+#include "multirate.h"
+
+#include "catch2/catch_all.hpp"
+
+// fast: harmonic oscillation, slow: nonlinear damping and driving
+inline const double omega = 20.;
+static void fast( double t, const std::array<double,2>& y, std::array<double,2>& yp)
+{
+    yp[0] = -omega*y[1];
+    yp[1] =  omega*y[0];
+}
+static void slow( double t, const std::array<double,2>& y, std::array<double,2>& yp)
+{
+    yp[0] = sin(y[1]) + cos(t);
+    yp[1] = -0.5*y[0]*y[0] + sin(t);
+}
+
+TEST_CASE( "Multirate step")
+{
+    const double t_start = 0., t_end = 1.;
+    const std::array<double,2> u0 = {1., 0.5};
+    // reference solution with a fine Runge Kutta method
+    auto full = []( double t, const std::array<double,2>& y, std::array<double,2>& yp)
+    {
+        std::array<double,2> ys;
+        fast( t, y, yp);
+        slow( t, y, ys);
+        dg::blas1::axpby( 1., ys, 1., yp);
+    };
+    std::array<double,2> ref = u0;
+    dg::RungeKutta<std::array<double,2>> rk( "Runge-Kutta-4-4", u0);
+    double t = t_start;
+    const unsigned NREF = 20000;
+    for( unsigned i=0; i<NREF; i++)
+        rk.step( full, t, ref, t, ref, (t_end-t_start)/(double)NREF);
+
+    auto name = GENERATE( as<std::string>{}, "Kutta-3-3", "Midpoint-2-2",
+            "Runge-Kutta-4-4");
+    INFO( "Slow tableau "<<name);
+    std::array<double,2> u1;
+    dg::MultirateStep<std::array<double,2>> mis( name, "Runge-Kutta-4-4", u0, 1);
+    CHECK( mis.order() == 2);
+    std::vector<double> err;
+    for( unsigned N : {8, 16, 32})
+    {
+        // keep the fast step size constant
+        mis.set_substeps( 2560/N);
+        u1 = u0, t = t_start;
+        double dt = (t_end-t_start)/(double)N;
+        for( unsigned i=0; i<N; i++)
+            mis.step( std::tie( slow, fast), t, u1, t, u1, dt);
+        CHECK( dg::is_same( t, t_end, 1e-14));
+        err.push_back( sqrt( (u1[0]-ref[0])*(u1[0]-ref[0]) +
+                             (u1[1]-ref[1])*(u1[1]-ref[1])));
+    }
+    for( unsigned i=0; i<err.size()-1; i++)
+    {
+        double order = log2( err[i]/err[i+1]);
+        INFO( "Error "<<err[i]<<" order "<<order);
+        CHECK( order > 1.7);
+    }
+}
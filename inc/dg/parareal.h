@@ -0,0 +1,371 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "backend/memory.h"
+#include "backend/timer.h"
+#include "backend/typedefs.h"
+#include "ode.h"
+#ifdef MPI_VERSION
+#include "backend/mpi_datatype.h"
+#endif //MPI_VERSION
+
+/*! @file
+ * @brief Parareal parallel-in-time integration
+ */
+namespace dg
+{
+///@cond
+namespace detail
+{
+#ifdef MPI_VERSION
+// Apply an MPI point to point or broadcast routine to all data in x
+template<class ContainerType, class MPIRoutine>
+void doTimeSliceTransfer( ContainerType& x, MPIRoutine routine, bool read, SharedVectorTag)
+{
+    using value_type = get_value_type<ContainerType>;
+    thrust::host_vector<value_type> buffer( x.begin(), x.end());
+    routine( thrust::raw_pointer_cast( buffer.data()), (int)buffer.size(),
+            getMPIDataType<value_type>());
+    if( read)
+        thrust::copy( buffer.begin(), buffer.end(), x.begin());
+}
+template<class ContainerType, class MPIRoutine>
+void doTimeSliceTransfer( ContainerType& x, MPIRoutine routine, bool read, MPIVectorTag)
+{
+    doTimeSliceTransfer( x.data(), routine, read,
+            get_tensor_category<std::decay_t<decltype( x.data())>>());
+}
+template<class ContainerType, class MPIRoutine>
+void doTimeSliceTransfer( ContainerType& x, MPIRoutine routine, bool read, RecursiveVectorTag)
+{
+    for( unsigned i=0; i<x.size(); i++)
+        doTimeSliceTransfer( x[i], routine, read,
+                get_tensor_category<std::decay_t<decltype( x[i])>>());
+}
+template<class ContainerType, class MPIRoutine>
+void timeSliceTransfer( ContainerType& x, MPIRoutine routine, bool read)
+{
+    doTimeSliceTransfer( x, routine, read, get_tensor_category<ContainerType>());
+}
+#endif //MPI_VERSION
+}//namespace detail
+///@endcond
+
+#ifdef MPI_VERSION
+/**
+ * @brief Split a communicator into space and time communicators for \c dg::Parareal
+ *
+ * The ranks in \c comm are divided into \c num_time groups of consecutive
+ * ranks. Each group forms one space communicator (in which e.g. a Cartesian
+ * grid communicator can be created with \c dg::mpi_cart_create) and
+ * integrates one (or several) time slices.
+ * All ranks with the same rank in their space communicator form one time
+ * communicator.
+ * @param comm the communicator to split (e.g. \c MPI_COMM_WORLD)
+ * @param num_time number of time groups; must divide the size of \c comm
+ * @param space_comm (write only) the space communicator of the calling rank
+ * @param time_comm (write only) the time communicator of the calling rank
+ * @ingroup time_utils
+ */
+inline void mpi_split_time( MPI_Comm comm, int num_time, MPI_Comm& space_comm,
+        MPI_Comm& time_comm)
+{
+    int rank, size;
+    MPI_Comm_rank( comm, &rank);
+    MPI_Comm_size( comm, &size);
+    if( num_time <= 0 || size%num_time != 0)
+        throw Error( Message(_ping_)<<"Number of time groups "<<num_time
+                <<" does not divide number of processes "<<size);
+    int space_size = size/num_time;
+    MPI_Comm_split( comm, rank/space_size, rank%space_size, &space_comm);
+    MPI_Comm_split( comm, rank%space_size, rank/space_size, &time_comm);
+}
+#endif //MPI_VERSION
+
+///@addtogroup time
+///@{
+
+/**
+ * @brief Parareal parallel-in-time integration of an ode
+ *
+ * The interval \f$ [t_0, t_1]\f$ is divided into \f$ N\f$ equal time slices
+ * with boundaries \f$ t_n = t_0 + n(t_1-t_0)/N\f$.
+ * Given a cheap coarse propagator \f$ \mathcal G\f$ (e.g. a low order tableau, a
+ * large timestep or a coarser grid) and an accurate fine propagator
+ * \f$ \mathcal F\f$ the Parareal iteration reads
+ * \f[
+ U^{k+1}_{n+1} = \mathcal G(t_{n+1}, t_n, U^{k+1}_n) + \mathcal F(t_{n+1}, t_n, U^k_n)
+ - \mathcal G(t_{n+1}, t_n, U^k_n)
+ \f]
+ * with \f$ U^{k}_0 = u_0\f$ and \f$ U^0_{n+1} = \mathcal G( t_{n+1}, t_n, U_n^0)\f$.
+ * The expensive fine propagations are independent and run in parallel
+ * while the coarse correction is a sequential sweep.
+ * After \f$ k\f$ iterations the first \f$ k\f$ slices equal the serial fine
+ * solution, i.e. the iteration terminates after at most \f$ N\f$ iterations.
+ * The iteration stops when the maximum relative change
+ * \f$ \max_n ||U^{k+1}_n - U^k_n||/ ||U^{k+1}_n||\f$ drops below \c eps.
+ * The method is described in
+ * <a href="https://doi.org/10.1016/S0764-4442(00)01793-6">Lions, Maday, Turinici, A "parareal" in time discretization of PDE's, C. R. Acad. Sci. Paris 332, 661-668 (2001)</a>
+ *
+ * With MPI the time slices are distributed among the ranks of a time
+ * communicator (see \c dg::mpi_split_time) while each group of ranks may
+ * itself be parallel in space. Vectors are passed between time slices via
+ * host buffers. Without MPI (or with a time communicator of size 1) all time
+ * slices are integrated sequentially, which is useful to test convergence
+ * before a parallel run.
+ * @attention The propagators are restarted at the same time from different
+ * values. Steppers that store the last right hand side evaluation
+ * (First Same As Last, see e.g. \c dg::ERKStep::ignore_fsal) must not reuse it
+ * @note One iteration costs one fine and one coarse integration per time slice, so the
+ * speed-up is bounded by \f$ N/K\f$ where \f$ K\f$ is the number of iterations
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerType>
+struct Parareal
+{
+    using value_type = get_value_type<ContainerType>;//!< the value type of the time variable (float or double)
+    using container_type = ContainerType; //!< the type of the vector class in use
+    /// Signature of the coarse and fine propagators \c prop(t0, u0, t1, u1)
+    using propagator_type = std::function<void(value_type, const ContainerType&,
+            value_type, ContainerType&)>;
+    ///@brief No memory allocation
+    Parareal() = default;
+    /**
+     * @brief Allocate memory for the time slices
+     *
+     * @param coarse the coarse propagator integrates from \c t0 to \c t1
+     * @param fine the fine propagator integrates from \c t0 to \c t1
+     * @param copyable vector of the size that is later used in \c integrate
+     * @param num_slices total number of time slices \f$ N\f$ (must be divisible
+     * by the size of the time communicator)
+     * @param max_iter maximum number of Parareal iterations
+     * @note For a coarse propagator on a coarser grid simply project the
+     * initial condition, integrate and interpolate the result within \c coarse,
+     * e.g. with \c dg::create::fast_projection and \c dg::create::fast_interpolation
+     */
+    Parareal( propagator_type coarse, propagator_type fine,
+            const ContainerType& copyable, unsigned num_slices,
+            unsigned max_iter) :
+        m_coarse( coarse), m_fine( fine), m_tmp( copyable), m_diff( copyable),
+        m_end( copyable), m_num_slices( num_slices), m_max_iter( max_iter)
+    {
+        set_slices();
+    }
+    /**
+     * @brief Use two timeloops as coarse and fine propagators
+     *
+     * @param coarse the coarse timeloop (is cloned)
+     * @param fine the fine timeloop (is cloned)
+     * @param copyable vector of the size that is later used in \c integrate
+     * @param num_slices total number of time slices \f$ N\f$ (must be divisible
+     * by the size of the time communicator)
+     * @param max_iter maximum number of Parareal iterations
+     */
+    Parareal( const aTimeloop<ContainerType>& coarse,
+            const aTimeloop<ContainerType>& fine, const ContainerType& copyable,
+            unsigned num_slices, unsigned max_iter) :
+        Parareal( make_propagator( coarse), make_propagator( fine), copyable,
+                num_slices, max_iter)
+    {
+    }
+    ///@copydoc hide_construct
+    template<class ...Params>
+    void construct( Params&& ...ps)
+    {
+        //construct and swap
+        *this = Parareal( std::forward<Params>( ps)...);
+    }
+#ifdef MPI_VERSION
+    /**
+     * @brief Distribute the time slices among the ranks of \c time_comm
+     *
+     * @param time_comm the time communicator, e.g. from \c dg::mpi_split_time
+     * (by default \c MPI_COMM_SELF, i.e. no parallelization in time)
+     */
+    void set_communicator( MPI_Comm time_comm)
+    {
+        m_comm = time_comm;
+        set_slices();
+    }
+#endif //MPI_VERSION
+    ///@copydoc hide_copyable
+    const ContainerType& copyable() const{ return m_tmp;}
+    ///@brief Set or unset performance timings and residuals during iterations
+    ///@param benchmark If true, additional output will be written to \c std::cout
+    void set_benchmark( bool benchmark){ m_benchmark = benchmark;}
+    ///@brief Set the maximum number of Parareal iterations
+    ///@param max_iter New maximum
+    void set_max( unsigned max_iter){ m_max_iter = max_iter;}
+    ///@brief Number of iterations in the last call to \c integrate
+    ///@return number of iterations
+    unsigned get_iterations() const{ return m_residuals.size();}
+    /**
+     * @brief The maximum relative change in each iteration of the last call to \c integrate
+     *
+     * Useful as convergence diagnostics
+     * @return residuals (size is \c get_iterations())
+     */
+    const std::vector<value_type>& get_residuals() const{ return m_residuals;}
+
+    /**
+     * @brief Integrate from \c t0 to \c t1
+     *
+     * @param t0 initial time
+     * @param u0 initial value at \c t0
+     * @param t1 end time
+     * @param u1 (write only) contains the result corresponding to t1 on output.
+     * May alias \c u0. (With MPI all ranks in the time communicator hold the result)
+     * @param eps relative accuracy of the Parareal iteration
+     * @return number of iterations
+     * @attention If the iteration does not converge in the maximum number of
+     * iterations, \c u1 contains the last iterate (no exception is thrown);
+     * check \c get_residuals() for convergence
+     */
+    unsigned integrate( value_type t0, const ContainerType& u0, value_type t1,
+            ContainerType& u1, value_type eps);
+    private:
+    static propagator_type make_propagator( const aTimeloop<ContainerType>& loop)
+    {
+        return [ptr = dg::ClonePtr<aTimeloop<ContainerType>>( loop)](
+            value_type t0, const ContainerType& u0, value_type t1,
+            ContainerType& u1) mutable
+        {
+            ptr->integrate( t0, u0, t1, u1);
+        };
+    }
+    void set_slices()
+    {
+        int size = 1;
+#ifdef MPI_VERSION
+        MPI_Comm_rank( m_comm, &m_rank);
+        MPI_Comm_size( m_comm, &size);
+#endif //MPI_VERSION
+        if( m_num_slices%size != 0)
+            throw Error( Message(_ping_)<<"Number of time slices "<<m_num_slices
+                    <<" not divisible by number of time processes "<<size);
+        m_size = size;
+        unsigned local = m_num_slices/size;
+        m_u.assign( local, m_tmp);
+        m_f.assign( local, m_tmp);
+        m_g.assign( local, m_tmp);
+    }
+    // relative change of u against v; m_diff is overwritten
+    value_type relative_change( const ContainerType& u, const ContainerType& v)
+    {
+        dg::blas1::axpby( 1., u, -1., v, m_diff);
+        value_type norm = sqrt( dg::blas1::dot( u, u));
+        value_type diff = sqrt( dg::blas1::dot( m_diff, m_diff));
+        return norm == 0 ? diff : diff/norm;
+    }
+    void recv_from_previous( ContainerType& x)
+    {
+#ifdef MPI_VERSION
+        detail::timeSliceTransfer( x, [&]( auto* ptr, int count, MPI_Datatype type)
+            { MPI_Recv( ptr, count, type, m_rank-1, m_rank-1, m_comm,
+                    MPI_STATUS_IGNORE);}, true);
+#endif //MPI_VERSION
+    }
+    void send_to_next( ContainerType& x)
+    {
+#ifdef MPI_VERSION
+        detail::timeSliceTransfer( x, [&]( auto* ptr, int count, MPI_Datatype type)
+            { MPI_Send( ptr, count, type, m_rank+1, m_rank, m_comm);}, false);
+#endif //MPI_VERSION
+    }
+    propagator_type m_coarse, m_fine;
+    std::vector<ContainerType> m_u, m_f, m_g; // U_n, F(U_n), G(U_n)
+    ContainerType m_tmp, m_diff, m_end;
+    std::vector<value_type> m_residuals;
+    unsigned m_num_slices = 1, m_max_iter = 1;
+    int m_rank = 0, m_size = 1;
+    bool m_benchmark = false;
+#ifdef MPI_VERSION
+    MPI_Comm m_comm = MPI_COMM_SELF;
+#endif //MPI_VERSION
+};
+///@}
+
+///@cond
+template<class ContainerType>
+unsigned Parareal<ContainerType>::integrate( value_type t0,
+        const ContainerType& u0, value_type t1, ContainerType& u1,
+        value_type eps)
+{
+#ifdef MPI_VERSION
+    int rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+#endif //MPI
+    const unsigned local = m_u.size(), first = m_rank*local;
+    const bool is_first = (m_rank == 0), is_last = ( m_rank == m_size-1);
+    auto time = [&]( unsigned n){
+        return t0 + (t1-t0)*(value_type)n/(value_type)m_num_slices;
+    };
+    dg::Timer t;
+    t.tic();
+    // Initial coarse sweep
+    if( is_first)
+        dg::blas1::copy( u0, m_u[0]);
+    else
+        recv_from_previous( m_u[0]);
+    for( unsigned l=0; l<local; l++)
+    {
+        m_coarse( time( first+l), m_u[l], time( first+l+1), m_g[l]);
+        if( l+1 < local)
+            dg::blas1::copy( m_g[l], m_u[l+1]);
+    }
+    dg::blas1::copy( m_g[local-1], m_end);
+    if( !is_last)
+        send_to_next( m_end);
+    t.toc();
+    if( m_benchmark)
+        DG_RANK0 std::cout << "# Parareal initial coarse sweep took "<<t.diff()<<"s\n";
+    m_residuals.clear();
+    for( unsigned k=1; k<=std::min( m_max_iter, m_num_slices); k++)
+    {
+        t.tic();
+        // Fine propagation is independent for all slices
+        for( unsigned l=0; l<local; l++)
+            m_fine( time( first+l), m_u[l], time( first+l+1), m_f[l]);
+        // Sequential coarse correction sweep
+        value_type error = 0;
+        if( !is_first)
+        {
+            recv_from_previous( m_tmp);
+            error = std::max( error, relative_change( m_tmp, m_u[0]));
+            m_u[0].swap( m_tmp);
+        }
+        for( unsigned l=0; l<local; l++)
+        {
+            m_coarse( time( first+l), m_u[l], time( first+l+1), m_tmp);
+            // U_{n+1} = G(U^{k+1}_n) + F(U^k_n) - G(U^k_n)
+            dg::blas1::axpbypgz( 1., m_tmp, 1., m_f[l], -1., m_g[l]);
+            m_g[l].swap( m_tmp);
+            ContainerType& next = ( l+1 < local) ? m_u[l+1] : m_end;
+            error = std::max( error, relative_change( m_tmp, next));
+            next.swap( m_tmp);
+        }
+        if( !is_last)
+            send_to_next( m_end);
+#ifdef MPI_VERSION
+        MPI_Allreduce( MPI_IN_PLACE, &error, 1, getMPIDataType<value_type>(),
+                MPI_MAX, m_comm);
+#endif //MPI_VERSION
+        m_residuals.push_back( error);
+        t.toc();
+        if( m_benchmark)
+            DG_RANK0 std::cout << "# Parareal iteration "<<k<<" max relative change "
+                      <<error<<" took "<<t.diff()<<"s\n";
+        if( error < eps)
+            break;
+    }
+#ifdef MPI_VERSION
+    detail::timeSliceTransfer( m_end, [&]( auto* ptr, int count, MPI_Datatype type)
+        { MPI_Bcast( ptr, count, type, m_size-1, m_comm);}, true);
+#endif //MPI_VERSION
+    dg::blas1::copy( m_end, u1);
+    return m_residuals.size();
+}
+///@endcond
+
+}//namespace dg
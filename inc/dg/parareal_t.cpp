@@ -0,0 +1,53 @@
+#include <iostream>
+#include <iomanip>
+#include <array>
+
+#include "runge_kutta.h"
+#include "parareal.h"
+
+#include "catch2/catch_all.hpp"
+
+// Driven damped oscillator
+static void rhs( double t, const std::array<double,2>& y, std::array<double,2>& yp)
+{
+    yp[0] = y[1];
+    yp[1] = -4.*y[0] - 0.1*y[1] + cos( t);
+}
+
+TEST_CASE( "Parareal")
+{
+    const double t_start = 0., t_end = 10.;
+    const unsigned num_slices = 20;
+    const std::array<double,2> u0 = {1., 0.};
+    dg::RungeKutta<std::array<double,2>> coarse_rk( "Runge-Kutta-4-4", u0),
+        fine_rk( "Runge-Kutta-4-4", u0);
+    // slices restart from corrected values
+    coarse_rk.ignore_fsal();
+    fine_rk.ignore_fsal();
+    dg::SinglestepTimeloop<std::array<double,2>> coarse( coarse_rk, rhs,
+            (t_end-t_start)/(double)num_slices),
+        fine( fine_rk, rhs, (t_end-t_start)/(double)num_slices/100.);
+    // Serial fine reference solution
+    std::array<double,2> ref;
+    fine.integrate( t_start, u0, t_end, ref);
+    dg::Parareal<std::array<double,2>> parareal( coarse, fine, u0, num_slices,
+            num_slices);
+    std::array<double,2> u1;
+    SECTION( "Converges to fine solution")
+    {
+        unsigned iter = parareal.integrate( t_start, u0, t_end, u1, 1e-10);
+        INFO( "Number of iterations "<<iter);
+        CHECK( iter < num_slices);
+        CHECK( parareal.get_residuals().back() < 1e-10);
+        CHECK( fabs( u1[0] - ref[0]) < 1e-8);
+        CHECK( fabs( u1[1] - ref[1]) < 1e-8);
+    }
+    SECTION( "Exact after N iterations")
+    {
+        // with eps = 0 the iteration runs until all slices are exact
+        parareal.integrate( t_start, u0, t_end, u1, 0.);
+        CHECK( parareal.get_iterations() == num_slices);
+        CHECK( fabs( u1[0] - ref[0]) < 1e-12);
+        CHECK( fabs( u1[1] - ref[1]) < 1e-12);
+    }
+}
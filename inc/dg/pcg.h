@@ -5,10 +5,12 @@
 
 #include "blas.h"
 #include "functors.h"
+#include "enums.h"
 #include "extrapolation.h"
 #include "backend/typedefs.h"
 
 #include "backend/timer.h"
+#include "backend/profile.h"
 
 /*!@file
  * Conjugate gradient class and functions
@@ -87,6 +89,21 @@ class PCG
     void set_throw_on_fail( bool throw_on_fail){
         m_throw_on_fail = throw_on_fail;
     }
+    /**
+     * @brief Choose the algorithm for the scalar products in the solve method
+     *
+     * With \c dg::dot_policy::fast the scalar products are computed with
+     * \c dg::blas2::fast_dot instead of the exact \c dg::blas2::dot, which is
+     * cheaper (especially for small grids) while the number of iterations
+     * is usually the same. The solution is then still binary reproducible for
+     * a given grid size (and number of MPI processes).
+     * @param policy the new policy
+     * @note the default value is \c dg::dot_policy::exact
+     */
+    void set_dot_policy( dg::dot_policy policy){ m_dot_policy = policy;}
+    ///@brief Get the current dot policy
+    ///@return the current policy
+    dg::dot_policy get_dot_policy() const{ return m_dot_policy;}
 
     ///@copydoc hide_construct
     template<class ...Params>
@@ -126,9 +143,17 @@ class PCG
     template< class MatrixType0, class ContainerType0, class ContainerType1, class MatrixType1, class ContainerType2 >
     unsigned solve( MatrixType0&& A, ContainerType0& x, const ContainerType1& b, MatrixType1&& P, const ContainerType2& W, value_type eps = 1e-12, value_type nrmb_correction = 1, int test_frequency = 1);
   private:
+    template<class ContainerType0, class ContainerType1, class ContainerType2>
+    value_type dot( const ContainerType0& x, const ContainerType1& W, const ContainerType2& y) const
+    {
+        if( m_dot_policy == dg::dot_policy::fast)
+            return blas2::fast_dot( x, W, y);
+        return blas2::dot( x, W, y);
+    }
     ContainerType r, p, ap;
     unsigned max_iter;
     bool m_verbose = false, m_throw_on_fail = true;
+    dg::dot_policy m_dot_policy = dg::dot_policy::exact;
 };
 
 ///@cond
@@ -136,9 +161,10 @@ template< class ContainerType>
 template< class Matrix, class ContainerType0, class ContainerType1, class Preconditioner, class ContainerType2>
 unsigned PCG< ContainerType>::solve( Matrix&& A, ContainerType0& x, const ContainerType1& b, Preconditioner&& P, const ContainerType2& W, value_type eps, value_type nrmb_correction, int save_on_dots )
 {
+    DG_PROFILE_REGION( "PCG::solve");
     // self-adjoint: apply PCG algorithm to (P 1/W) (W A) x = (P 1/W) (W b) : P' A' x = P' b'
     // This effectively just replaces all scalar products with the weighted one
-    value_type nrmb = sqrt( blas2::dot( W, b));
+    value_type nrmb = sqrt( dot( b, W, b));
     value_type tol = eps*(nrmb + nrmb_correction);
 #ifdef MPI_VERSION
     int rank;
@@ -156,30 +182,30 @@ unsigned PCG< ContainerType>::solve( Matrix&& A, ContainerType0& x, const Contai
     }
     blas2::symv( std::forward<Matrix>(A),x,r);
     blas1::axpby( 1., b, -1., r);
-    if( sqrt( blas2::dot(W,r) ) < tol) //if x happens to be the solution
+    if( sqrt( dot( r, W, r) ) < tol) //if x happens to be the solution
         return 0;
     blas2::symv( std::forward<Preconditioner>(P), r, p );
-    value_type nrmzr_old = blas2::dot( p,W,r); //and store the scalar product
+    value_type nrmzr_old = dot( p, W, r); //and store the scalar product
     value_type alpha, nrmzr_new;
     for( unsigned i=1; i<max_iter; i++)
     {
         blas2::symv( std::forward<Matrix>(A), p, ap);
-        alpha =  nrmzr_old/blas2::dot( p, W, ap);
+        alpha =  nrmzr_old/dot( p, W, ap);
         blas1::axpby( alpha, p, 1.,x);
         blas1::axpby( -alpha, ap, 1., r);
         if( 0 == i%save_on_dots )
         {
             if( m_verbose)
             {
-                DG_RANK0 std::cout << "# Absolute r*W*r "<<sqrt( blas2::dot(W,r)) <<"\t ";
+                DG_RANK0 std::cout << "# Absolute r*W*r "<<sqrt( dot( r, W, r)) <<"\t ";
                 DG_RANK0 std::cout << "#  < Critical "<<tol <<"\t ";
-                DG_RANK0 std::cout << "# (Relative "<<sqrt( blas2::dot(W,r) )/nrmb << ")\n";
+                DG_RANK0 std::cout << "# (Relative "<<sqrt( dot( r, W, r) )/nrmb << ")\n";
             }
-            if( sqrt( blas2::dot(W,r)) < tol)
+            if( sqrt( dot( r, W, r)) < tol)
                 return i;
         }
         blas2::symv(std::forward<Preconditioner>(P),r,ap);
-        nrmzr_new = blas2::dot( ap, W, r);
+        nrmzr_new = dot( ap, W, r);
         blas1::axpby(1.,ap, nrmzr_new/nrmzr_old, p );
         nrmzr_old=nrmzr_new;
     }
@@ -1,6 +1,8 @@
 
 #include <iostream>
 #include "pcg.h"
+#include "elliptic.h"
+#include "multigrid.h"
 #include "topology/operator.h"
 #include "catch2/catch_all.hpp"
 
@@ -43,5 +45,75 @@ TEST_CASE( "PCG real")
             CHECK( fabs( x[u] - sol[u]) < 1e-12);
         }
     }
+    SECTION( "Exact and fast dot policy")
+    {
+        dg::CartesianGrid2d grid( 0, M_PI, 0, 2.*M_PI, 3, 32, 64, dg::DIR,
+                dg::PER);
+        const dg::HVec b = dg::evaluate( []( double x, double y){
+                return 2.*sin(x)*sin(y);}, grid);
+        const dg::HVec sol = dg::evaluate( []( double x, double y){
+                return sin(x)*sin(y);}, grid);
+        const dg::HVec w2d = dg::create::weights( grid);
+        const double norm = sqrt( dg::blas2::dot( w2d, sol));
+        dg::Elliptic2d<dg::CartesianGrid2d, dg::HMatrix, dg::HVec> A( grid);
+        const std::array<dg::dot_policy,2> policies{ dg::dot_policy::exact,
+            dg::dot_policy::fast};
+        std::array<dg::HVec,2> x;
+        std::array<unsigned,2> num_steps;
+        for( unsigned u=0; u<2; u++)
+        {
+            x[u] = dg::evaluate( dg::zero, grid);
+            dg::PCG pcg( x[u], grid.size());
+            pcg.set_dot_policy( policies[u]);
+            CHECK( pcg.get_dot_policy() == policies[u]);
+            num_steps[u] = pcg.solve( A, x[u], b, A.precond(), A.weights(),
+                    1e-8);
+            dg::HVec error( x[u]);
+            dg::blas1::axpby( 1., sol, -1., error);
+            INFO( "Policy "<<u<<" num steps "<<num_steps[u]<<" rel. error "
+                    <<sqrt( dg::blas2::dot( w2d, error))/norm);
+            CHECK( sqrt( dg::blas2::dot( w2d, error))/norm < 1e-3);
+        }
+        // the dot products differ only by rounding
+        CHECK( std::abs( (int)num_steps[0] - (int)num_steps[1]) <= 1);
+        dg::blas1::axpby( 1., x[0], -1., x[1]);
+        INFO( "Difference exact - fast "<<sqrt( dg::blas2::dot( w2d, x[1]))/norm);
+        CHECK( sqrt( dg::blas2::dot( w2d, x[1]))/norm < 1e-7);
+    }
+    SECTION( "Multigrid with exact and fast dot policy")
+    {
+        dg::CartesianGrid2d grid( 0, M_PI, 0, 2.*M_PI, 3, 32, 64, dg::DIR,
+                dg::PER);
+        const dg::HVec b = dg::evaluate( []( double x, double y){
+                return 2.*sin(x)*sin(y);}, grid);
+        const dg::HVec w2d = dg::create::weights( grid);
+        const unsigned stages = 3;
+        dg::MultigridCG2d<dg::CartesianGrid2d, dg::HMatrix, dg::HVec>
+            multigrid( grid, stages);
+        std::vector<dg::Elliptic2d<dg::CartesianGrid2d, dg::HMatrix,
+            dg::HVec>> multi_pol( stages);
+        for( unsigned k=0; k<stages; k++)
+            multi_pol[k].construct( multigrid.grid(k));
+        std::array<dg::HVec,2> x;
+        std::array<std::vector<unsigned>,2> num_steps;
+        for( unsigned u=0; u<2; u++)
+        {
+            for( unsigned k=0; k<stages; k++)
+                multigrid.set_dot_policy( k, u == 0 ? dg::dot_policy::exact
+                        : dg::dot_policy::fast);
+            x[u] = dg::evaluate( dg::zero, grid);
+            num_steps[u] = multigrid.solve( multi_pol, x[u], b, 1e-8);
+        }
+        for( unsigned k=0; k<stages; k++)
+        {
+            INFO( "Stage "<<k<<" exact "<<num_steps[0][k]<<" fast "
+                    <<num_steps[1][k]);
+            CHECK( std::abs( (int)num_steps[0][k] - (int)num_steps[1][k]) <= 1);
+        }
+        const double norm = sqrt( dg::blas2::dot( w2d, x[0]));
+        dg::blas1::axpby( 1., x[0], -1., x[1]);
+        INFO( "Difference exact - fast "<<sqrt( dg::blas2::dot( w2d, x[1]))/norm);
+        CHECK( sqrt( dg::blas2::dot( w2d, x[1]))/norm < 1e-7);
+    }
 
 }
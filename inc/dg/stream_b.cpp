@@ -0,0 +1,74 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include <thrust/host_vector.h>
+#include <thrust/device_vector.h>
+
+#include "backend/timer.h"
+#include "backend/typedefs.h"
+#include "blas1.h"
+
+// STREAM-like benchmark (Copy, Scale, Add, Triad) with dg::blas1
+// We compare vectors whose memory is first touched by a single thread with
+// vectors that are constructed with dg::construct, which on the OpenMP device
+// first touches memory with the same static partition as the blas1 kernels.
+// On multi-socket (NUMA) nodes the latter should reach the full bandwidth.
+// On the GPU and with one socket both variants should perform equally.
+
+template<class Vector>
+void stream( const std::string& name, Vector& a, Vector& b, Vector& c, int multi)
+{
+    double gbytes = (double)a.size()*sizeof(double)/1e9;
+    dg::Timer t;
+    std::cout << "\n"<<name<<"\n";
+    // warm up
+    dg::blas1::copy( a, c);
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas1::copy( a, c);
+    t.toc();
+    std::cout<<"Copy  (c=a)        "<<t.diff()/multi<<"s\t"<<2*gbytes*multi/t.diff()<<"GB/s\n";
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas1::axpby( 3., c, 0., b);
+    t.toc();
+    std::cout<<"Scale (b=3c)       "<<t.diff()/multi<<"s\t"<<2*gbytes*multi/t.diff()<<"GB/s\n";
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas1::axpbypgz( 1., a, 1., b, 0., c);
+    t.toc();
+    std::cout<<"Add   (c=a+b)      "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas1::axpbypgz( 1., b, 3., c, 0., a);
+    t.toc();
+    std::cout<<"Triad (a=b+3c)     "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+}
+
+int main()
+{
+    std::cout << "This program measures the memory bandwidth of dg::blas1 functions following the STREAM convention (each read and each write count as one memop)\n";
+    std::cout << "Type vector size (1e8) and number of repetitions (20)\n";
+    double size;
+    int multi;
+    std::cin >> size >> multi;
+    unsigned N = (unsigned)size;
+    thrust::host_vector<double> h( N, 1.);
+    std::cout << "Size of vectors is "<<(double)N*sizeof(double)/1e9<<" GB\n";
+    {
+        // single thread first touch (thrust copy from host memory)
+        dg::DVec a, b, c;
+        a.assign( h.begin(), h.end());
+        b.assign( h.begin(), h.end());
+        c.assign( h.begin(), h.end());
+        stream( "Single thread first touch", a, b, c, multi);
+    }
+    {
+        // parallel first touch with the blas1 partition
+        dg::DVec a = dg::construct<dg::DVec>( h),
+            b = dg::construct<dg::DVec>( h), c = dg::construct<dg::DVec>( h);
+        stream( "Parallel first touch (dg::construct)", a, b, c, multi);
+    }
+    return 0;
+}
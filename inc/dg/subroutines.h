@@ -402,6 +402,121 @@ struct Compose
 }//namespace detail
 ///@endcond
 
+///@cond
+namespace detail
+{
+// Pick the I-th argument of a parameter pack
+// (static_cast instead of std::forward since the latter is not a device function)
+template<unsigned I>
+struct PickArgument
+{
+    template<class T0, class ...Ts>
+DG_DEVICE static decltype(auto) get( T0&&, Ts&& ... xs)
+    {
+        return PickArgument<I-1>::get( static_cast<Ts&&>(xs)...);
+    }
+};
+template<>
+struct PickArgument<0>
+{
+    template<class T0, class ...Ts>
+DG_DEVICE static T0&& get( T0&& x0, Ts&& ...)
+    {
+        return static_cast<T0&&>(x0);
+    }
+};
+}//namespace detail
+///@endcond
+
+///@addtogroup variadic_subroutines
+///@{
+/**
+ * @brief \f$ f( x_{I_0}, x_{I_1}, ...)\f$ Apply a subroutine to a selection of arguments
+ *
+ * Building block of \c dg::Fused; use \c dg::args to construct
+ * @tparam Subroutine the subroutine to call
+ * @tparam Is the indices of the arguments that are forwarded to the subroutine
+ */
+template<class Subroutine, unsigned ...Is>
+struct ArgumentSelection
+{
+    ArgumentSelection( Subroutine f): m_f( f){}
+#ifdef __CUDACC__
+#pragma hd_warning_disable
+#endif
+    template<class ...Ts>
+DG_DEVICE void operator()( Ts&& ... xs)
+    {
+        m_f( detail::PickArgument<Is>::get( static_cast<Ts&&>(xs)...)...);
+    }
+    private:
+    Subroutine m_f;
+};
+
+/**
+ * @brief Select the arguments that a subroutine acts on in a \c dg::Fused sequence
+ *
+ * @code{.cpp}
+ * // y = 2x, then w = y*z
+ * dg::blas1::fused( dg::args<0,1>( dg::Axpby( 2., 0.)),
+ *                   dg::args<1,2,3>( dg::PointwiseDot( 1., 0.)))( x, y, z, w);
+ * @endcode
+ * @tparam Is the (zero-based) indices of the arguments in the call of the fused sequence
+ * @param f the subroutine
+ * @return \c dg::ArgumentSelection
+ */
+template<unsigned ...Is, class Subroutine>
+ArgumentSelection<Subroutine, Is...> args( Subroutine f)
+{
+    return ArgumentSelection<Subroutine, Is...>( f);
+}
+
+/**
+ * @brief \f$ f_0(x_0, x_1, ...), f_1( x_0, x_1, ...), ...\f$ Apply a sequence of subroutines elementwise
+ *
+ * All subroutines are called in order on the same element before the next
+ * element is visited. Since all subroutines act elementwise this is
+ * equivalent to calling \c dg::blas1::subroutine for each subroutine in order,
+ * but needs only a single pass through memory.
+ * @sa dg::blas1::fused dg::args
+ * @tparam Subroutines the subroutines that are called in order with all arguments
+ */
+template<class Subroutine, class ...Subroutines>
+struct Fused
+{
+    Fused( Subroutine f, Subroutines ... fs): m_f( f), m_fs( fs...){}
+#ifdef __CUDACC__
+#pragma hd_warning_disable
+#endif
+    template<class ...Ts>
+DG_DEVICE void operator()( Ts&& ... xs)
+    {
+        m_f( xs...);
+        m_fs( xs...);
+    }
+    private:
+    Subroutine m_f;
+    Fused<Subroutines...> m_fs;
+};
+///@cond
+template<class Subroutine>
+struct Fused<Subroutine>
+{
+    Fused( Subroutine f): m_f( f){}
+#ifdef __CUDACC__
+#pragma hd_warning_disable
+#endif
+    template<class ...Ts>
+DG_DEVICE void operator()( Ts&& ... xs)
+    {
+        m_f( xs...);
+    }
+    private:
+    Subroutine m_f;
+};
+///@endcond
+///@}
+
 ///@addtogroup composition
 ///@{
 /**
@@ -193,6 +193,19 @@ struct aRealProductGeometry3d : public aRealGeometry3d<real_type>
     aRealGeometry2d<real_type>* perp_grid()const{
         return do_perp_grid();
     }
+    /**
+     * @brief The (inverse) metric tensor restricted to the first plane
+     *
+     * Since the metric elements do not depend on the third coordinate
+     * it suffices to store them on the first two dimensions; the functions in
+     * \c dg::tensor broadcast them to all planes of a 3d vector.
+     * @return same as \c metric() but with values of size
+     * <tt>shape(0)*shape(1)</tt>
+     * @sa \c dg::tensor::multiply3d
+     */
+    SparseTensor<thrust::host_vector<real_type> > plane_metric()const{
+        return do_compute_plane_metric();
+    }
     ///allow deletion through base class pointer
     virtual ~aRealProductGeometry3d() = default;
     ///Geometries are cloneable
@@ -205,6 +218,13 @@ struct aRealProductGeometry3d : public aRealGeometry3d<real_type>
     aRealProductGeometry3d& operator=( const aRealProductGeometry3d& src) = default;
     private:
     virtual aRealGeometry2d<real_type>* do_perp_grid()const=0;
+    virtual SparseTensor<thrust::host_vector<real_type> > do_compute_plane_metric()const{
+        SparseTensor<thrust::host_vector<real_type> > metric = this->metric();
+        unsigned size2d = this->shape(0)*this->shape(1);
+        for( unsigned i=0; i<metric.values().size(); i++)
+            metric.values()[i].resize( size2d);
+        return metric;
+    }
 };
 
 /**
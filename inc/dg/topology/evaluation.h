@@ -69,6 +69,9 @@ auto do_evaluate( Functor&& f, const Topology& g, std::index_sequence<I...>)
  * @note In the MPI version all processes in the grid communicator need to call
  * this function. Each process evaluates the function f only on the grid
  * coordinates that it owns i.e. the local part of the given grid
+ * @note If compiled with OpenMP (and not called from inside a parallel
+ * region) \c f is evaluated by several threads concurrently, so it must not
+ * have side effects. The result is identical to serial evaluation.
  */
 template< class Functor, class Topology>
 auto evaluate( Functor&& f, const Topology& g)
@@ -160,6 +160,21 @@ TEST_CASE( "Evaluation")
         INFO( "Relative 3d error is      "<<(norm3d-solution3d)/solution3d);
         CHECK( abs( res.i - 4746764681002108278) < 2);
     }
+    SECTION( "3d grid identical to serial loop")
+    {
+        // With OpenMP evaluate runs in parallel on host vectors
+        dg::Grid3d g3d( 1, 2, 3, 4, 5, 6, 3, 12, 28, 20);
+        thrust::host_vector<double> func3d = dg::evaluate( function3d, g3d);
+        thrust::host_vector<double> x = g3d.abscissas(0), y = g3d.abscissas(1),
+            z = g3d.abscissas(2);
+        unsigned num_wrong = 0;
+        for( unsigned k=0; k<z.size(); k++)
+        for( unsigned j=0; j<y.size(); j++)
+        for( unsigned i=0; i<x.size(); i++)
+            if( func3d[(k*y.size()+j)*x.size()+i] != function3d( x[i], y[j], z[k]))
+                num_wrong++;
+        CHECK( num_wrong == 0);
+    }
 }
 
 TEST_CASE( "vdot test")
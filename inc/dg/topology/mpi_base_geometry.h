@@ -118,6 +118,20 @@ struct aRealProductMPIGeometry3d : public aRealMPIGeometry3d<real_type>
     aRealMPIGeometry2d<real_type>* perp_grid()const{
         return do_perp_grid();
     }
+    /**
+     * @brief The (inverse) metric tensor restricted to the first local plane
+     *
+     * Since the metric elements do not depend on the third coordinate
+     * it suffices to store them on the first two dimensions; the functions in
+     * \c dg::tensor broadcast them to all local planes of a 3d vector.
+     * @return same as \c metric() but with values of local size
+     * <tt>local().shape(0)*local().shape(1)</tt> on the perpendicular
+     * communicator \c get_perp_comm()
+     * @sa \c dg::tensor::multiply3d
+     */
+    SparseTensor<MPI_Vector<thrust::host_vector<real_type>> > plane_metric()const{
+        return do_compute_plane_metric();
+    }
     ///allow deletion through base class pointer
     virtual ~aRealProductMPIGeometry3d() = default;
     ///Geometries are cloneable
@@ -130,6 +144,17 @@ struct aRealProductMPIGeometry3d : public aRealMPIGeometry3d<real_type>
     aRealProductMPIGeometry3d& operator=( const aRealProductMPIGeometry3d& src) = default;
     private:
     virtual aRealMPIGeometry2d<real_type>* do_perp_grid()const=0;
+    virtual SparseTensor<MPI_Vector<thrust::host_vector<real_type>> > do_compute_plane_metric()const{
+        SparseTensor<MPI_Vector<thrust::host_vector<real_type>> > metric = this->metric();
+        unsigned size2d = this->local().shape(0)*this->local().shape(1);
+        MPI_Comm comm = this->get_perp_comm();
+        for( unsigned i=0; i<metric.values().size(); i++)
+        {
+            metric.values()[i].data().resize( size2d);
+            metric.values()[i].set_communicator( comm);
+        }
+        return metric;
+    }
 };
 
 /**
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
 #include "operator.h"
 #include "dg/functors.h"
 #include "dg/blas1.h"
@@ -168,6 +172,95 @@ struct TensorDot3d
         return lambda*mu*DG_FMA(v0,tmp0 , DG_FMA(v1,tmp1 , v2*tmp2));
     }
 };
+
+namespace detail
+{
+// (local) number of elements of a vector, 0 for everything else
+template<class ContainerType>
+unsigned broadcast_size( const ContainerType& x)
+{
+    if constexpr( dg::is_vector_v<ContainerType, dg::MPIVectorTag>)
+        return broadcast_size( x.data());
+    else if constexpr( dg::is_vector_v<ContainerType, dg::SharedVectorTag>)
+        return x.size();
+    else
+        return 0;
+}
+// the (local) data of a vector; MPI vectors are unwrapped
+template<class ContainerType>
+auto& local_data( ContainerType& x)
+{
+    if constexpr( dg::is_vector_v<ContainerType, dg::MPIVectorTag>)
+        return local_data( x.data());
+    else
+        return x;
+}
+
+// Call the subroutine f( xs[i]...) at every index i, where all arguments
+// flagged in plane (bit j for argument j) hold a single plane and are read
+// at index i%size2d
+template<class Subroutine>
+struct BroadcastPlanes
+{
+    BroadcastPlanes( Subroutine f, unsigned size2d, unsigned long long plane):
+        m_f( f), m_size2d( size2d), m_plane( plane){}
+    template<class ...PointerOrValues>
+    DG_DEVICE void operator()( unsigned i, PointerOrValues... xs) const
+    {
+        call( i, std::index_sequence_for<PointerOrValues...>(), xs...);
+    }
+    private:
+    template<std::size_t ...Is, class ...PointerOrValues>
+    DG_DEVICE void call( unsigned i, std::index_sequence<Is...>, PointerOrValues... xs) const
+    {
+        m_f( element( xs, ((m_plane >> Is) & 1ull) ? i%m_size2d : i)...);
+    }
+    template<class T>
+    DG_DEVICE static T& element( T* x, unsigned i){ return x[i];}
+    template<class T>
+    DG_DEVICE static T element( T x, unsigned){ return x;}
+    Subroutine m_f;
+    unsigned m_size2d;
+    unsigned long long m_plane;
+};
+
+// Call dg::blas1::subroutine( f, xs...) if no vector is larger than size2d,
+// else call f in a single parallel loop over all elements, where input
+// vectors of size size2d are broadcast to every plane
+template<class Subroutine, class ...ContainerTypes>
+void broadcast_planes( unsigned size2d, Subroutine f, ContainerTypes&... xs)
+{
+    static_assert( sizeof...(xs) <= 64, "Too many arguments to broadcast");
+    std::array<unsigned, sizeof...(xs)> sizes{ broadcast_size(xs)...};
+    unsigned size = *std::max_element( sizes.begin(), sizes.end());
+    if( size2d == 0 || size <= size2d)
+    {
+        dg::blas1::subroutine( f, xs...);
+        return;
+    }
+    constexpr std::array<bool, sizeof...(xs)> is_input{
+        std::is_const_v<ContainerTypes>...};
+    unsigned long long plane = 0;
+    for( unsigned j=0; j<sizes.size(); j++)
+    {
+        if( sizes[j] == size2d)
+        {
+            if( !is_input[j])
+                throw dg::Error( dg::Message(_ping_)<<"Output vector of plane size "
+                    <<size2d<<" cannot hold a result of size "<<size);
+            plane |= 1ull << j;
+        }
+        else if( sizes[j] != 0 && sizes[j] != size)
+            throw dg::Error( dg::Message(_ping_)<<"Vector of size "<<sizes[j]
+                <<" is neither of size "<<size<<" nor of plane size "<<size2d);
+    }
+    if( size%size2d != 0)
+        throw dg::Error( dg::Message(_ping_)<<"Vector size "<<size
+                <<" is not a multiple of plane size "<<size2d);
+    dg::blas2::parallel_for( BroadcastPlanes<Subroutine>( f, size2d, plane),
+        size, local_data( xs)...);
+}
+}//namespace detail
 ///@endcond
 
 /**
@@ -180,6 +273,15 @@ namespace tensor
 ///@addtogroup tensor
 ///@{
 
+/*!@class hide_tensor_broadcast
+ * @note The values of \c t may hold a single plane of a three-dimensional
+ * vector (e.g. \c aRealProductGeometry3d::plane_metric), in which case they
+ * are broadcast to all planes of the remaining vectors in a single parallel
+ * loop (cf. \c dg::blas2::parallel_for). Input vectors may then have either
+ * the size of \c t's values or a common multiple of it; output vectors must
+ * have the multiple size.
+ */
+
 /**
  * @brief \f$ t^{ij} = \mu t^{ij} \ \forall i,j \f$
  *
@@ -209,12 +311,15 @@ void scal( SparseTensor<ContainerType0>& t, const ContainerType1& mu)
  * @param out0 (output) first component  of \c w (may alias in0)
  * @param out1 (output) second component of \c w (may alias in1)
  * @note This function is just a shortcut for a call to \c dg::blas1::subroutine
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerTypeM, class ContainerType3, class ContainerType4>
 void multiply2d( const ContainerTypeL& lambda, const SparseTensor<ContainerType0>& t, const ContainerType1& in0, const ContainerType2& in1, const ContainerTypeM& mu, ContainerType3& out0, ContainerType4& out1)
 {
-    dg::blas1::subroutine( dg::TensorMultiply2d(), lambda,
+    detail::broadcast_planes( detail::broadcast_size( t.value(0,0)),
+        dg::TensorMultiply2d(),
+                           lambda,
                            t.value(0,0), t.value(0,1),
                            t.value(1,0), t.value(1,1),
                            in0, in1, mu, out0, out1);
@@ -234,12 +339,14 @@ void multiply2d( const ContainerTypeL& lambda, const SparseTensor<ContainerType0
  * @param out1 (output)  second component of \c w (may alias in1)
  * @param out2 (output)  third component of \c w  (may alias in2)
  * @note This function is just a shortcut for a call to \c dg::blas1::subroutine
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerTypeM, class ContainerType4, class ContainerType5, class ContainerType6>
 void multiply3d( const ContainerTypeL& lambda, const SparseTensor<ContainerType0>& t, const ContainerType1& in0, const ContainerType2& in1, const ContainerType3& in2, const ContainerTypeM& mu, ContainerType4& out0, ContainerType5& out1, ContainerType6& out2)
 {
-    dg::blas1::subroutine(dg::TensorMultiply3d(),
+    detail::broadcast_planes( detail::broadcast_size( t.value(0,0)),
+        dg::TensorMultiply3d(),
             lambda,      t.value(0,0), t.value(0,1), t.value(0,2),
                          t.value(1,0), t.value(1,1), t.value(1,2),
                          t.value(2,0), t.value(2,1), t.value(2,2),
@@ -260,12 +367,15 @@ void multiply3d( const ContainerTypeL& lambda, const SparseTensor<ContainerType0
  * @param out0 (output) first component of \c v  (may alias in0)
  * @param out1 (output) second component of \c v (may alias in1)
  * @note This function is just a shortcut for a call to \c dg::blas1::subroutine
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerTypeM, class ContainerType3, class ContainerType4>
 void inv_multiply2d( const ContainerTypeL& lambda, const SparseTensor<ContainerType0>& t, const ContainerType1& in0, const ContainerType2& in1, const ContainerTypeM& mu, ContainerType3& out0, ContainerType4& out1)
 {
-    dg::blas1::subroutine( dg::InverseTensorMultiply2d(), lambda,
+    detail::broadcast_planes( detail::broadcast_size( t.value(0,0)),
+        dg::InverseTensorMultiply2d(),
+                           lambda,
                            t.value(0,0), t.value(0,1),
                            t.value(1,0), t.value(1,1),
                            in0,  in1, mu, out0, out1);
@@ -286,12 +396,14 @@ void inv_multiply2d( const ContainerTypeL& lambda, const SparseTensor<ContainerT
  * @param out1 (output)  second component of \c v (may alias in1)
  * @param out2 (output)  third component  of \c v (may alias in2)
  * @note This function is just a shortcut for a call to \c dg::blas1::subroutine
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerTypeM, class ContainerType4, class ContainerType5, class ContainerType6>
 void inv_multiply3d( const ContainerTypeL& lambda, const SparseTensor<ContainerType0>& t, const ContainerType1& in0, const ContainerType2& in1, const ContainerType3& in2, const ContainerTypeM& mu, ContainerType4& out0, ContainerType5& out1, ContainerType6& out2)
 {
-    dg::blas1::subroutine( dg::InverseTensorMultiply3d(),
+    detail::broadcast_planes( detail::broadcast_size( t.value(0,0)),
+        dg::InverseTensorMultiply3d(),
            lambda,       t.value(0,0), t.value(0,1), t.value(0,2),
                          t.value(1,0), t.value(1,1), t.value(1,2),
                          t.value(2,0), t.value(2,1), t.value(2,2),
@@ -405,6 +517,7 @@ ContainerType volume( const SparseTensor<ContainerType>& t)
  * @param out0 (output) first component  of \c w (may alias in0)
  * @param out1 (output) second component of \c w (may alias in1)
  * @note This function is just a shortcut for a call to \c dg::blas1::subroutine
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerType4>
@@ -425,6 +538,7 @@ void multiply2d( const SparseTensor<ContainerType0>& t, const ContainerType1& in
  * @param out1 (output)  second component of \c w (may alias in1)
  * @param out2 (output)  third component of \c w  (may alias in2)
  * @note This function is just a shortcut for a call to \c dg::blas1::subroutine
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerType4, class ContainerType5, class ContainerType6>
@@ -464,6 +578,7 @@ void inv_multiply2d( const SparseTensor<ContainerType0>& t, const ContainerType1
  * @param out1 (output)  second component of \c v (may alias in1)
  * @param out2 (output)  third component  of \c v (may alias in2)
  * @note This function is just a shortcut for a call to \c dg::blas1::subroutine
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerType4, class ContainerType5, class ContainerType6>
@@ -487,6 +602,7 @@ void inv_multiply3d( const SparseTensor<ContainerType0>& t, const ContainerType1
  * @param beta scalar output prefactor
  * @param y (output)
  * @note This function is just a shortcut for a call to \c dg::blas1::evaluate
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerTypeM, class ContainerType4, class ContainerType5, class value_type0, class value_type1>
@@ -502,10 +618,9 @@ void scalar_product2d(
         value_type1 beta,
         ContainerType5& y)
 {
-    dg::blas1::evaluate( y,
-             dg::Axpby( alpha, beta),
-             dg::TensorDot2d(),
-             lambda, v0, v1,
+    detail::broadcast_planes( detail::broadcast_size( t.value(0,0)),
+        dg::Evaluate( dg::Axpby( alpha, beta), dg::TensorDot2d()),
+             y, lambda, v0, v1,
              t.value(0,0), t.value(0,1),
              t.value(1,0), t.value(1,1),
              mu, w0, w1);
@@ -527,6 +642,7 @@ void scalar_product2d(
  * @param beta scalar output prefactor
  * @param y (output)
  * @note This function is just a shortcut for a call to \c dg::blas1::evaluate
+ * @copydoc hide_tensor_broadcast
  * @copydoc hide_ContainerType
  */
 template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerTypeM, class ContainerType4, class ContainerType5, class ContainerType6, class ContainerType7, class value_type0, class value_type1>
@@ -544,10 +660,9 @@ void scalar_product3d(
         value_type1 beta,
         ContainerType7& y)
 {
-    dg::blas1::evaluate( y,
-            dg::Axpby( alpha, beta),
-            dg::TensorDot3d(),
-            lambda,
+    detail::broadcast_planes( detail::broadcast_size( t.value(0,0)),
+        dg::Evaluate( dg::Axpby( alpha, beta), dg::TensorDot3d()),
+            y, lambda,
             v0, v1, v2,
             t.value(0,0), t.value(0,1), t.value(0,2),
             t.value(1,0), t.value(1,1), t.value(1,2),
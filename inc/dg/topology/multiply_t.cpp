@@ -160,6 +160,38 @@ TEST_CASE( "dg::tensor")
         CHECK( cnine[0] == thrust::complex{60.,60.});
         CHECK( ctwo[0] == thrust::complex{51.,51.});
     }
+    SECTION( "broadcast planes")
+    {
+        INFO( "Multiply T with [8,9,2], [1,0,0] and [0,1,0] on three planes");
+        thrust::host_vector<double> in0 = std::vector{8.,1.,0.},
+            in1 = std::vector{9.,0.,1.}, in2 = std::vector{2.,0.,0.},
+            out0(3), out1(3), out2(3);
+        dg::tensor::multiply3d(t, in0, in1, in2, out0, out1, out2);
+        CHECK( out0 == thrust::host_vector<double>( std::vector{45.,2.,3.}));
+        CHECK( out1 == thrust::host_vector<double>( std::vector{60.,3.,4.}));
+        CHECK( out2 == thrust::host_vector<double>( std::vector{51.,2.,3.}));
+        INFO( "Compare to tensor with 3d values");
+        dg::SparseTensor<thrust::host_vector<double>> t3d = t;
+        for( auto& value : t3d.values())
+            value = thrust::host_vector<double>( 3, value[0]);
+        dg::tensor::multiply3d(t3d, in0, in1, in2, work0, work1, work2);
+        CHECK( work0 == out0);
+        CHECK( work1 == out1);
+        CHECK( work2 == out2);
+        dg::tensor::scalar_product3d( 1., 3., in0, in1, in2, t, 3., in0, in1,
+            in2, 0., out0);
+        dg::tensor::scalar_product3d( 1., 3., in0, in1, in2, t3d, 3., in0,
+            in1, in2, 0., work0);
+        CHECK( work0 == out0);
+        INFO( "Vector sizes must be a multiple of the plane size");
+        thrust::host_vector<double> wrong( 2);
+        CHECK_THROWS_AS( dg::tensor::multiply2d( t, in0, wrong, out0, out1),
+            dg::Error);
+        INFO( "Output vectors cannot be of plane size");
+        thrust::host_vector<double> plane( 1);
+        CHECK_THROWS_AS( dg::tensor::multiply2d( t, in0, in1, plane, out1),
+            dg::Error);
+    }
     SECTION( "determinant")
     {
         double det = dg::tensor::determinant(t)[0];
@@ -8,11 +8,36 @@ namespace dg
 {
 ///@cond
 namespace detail{
+// the (process local) host vector
+template<class Vector>
+auto& local_host_vector( Vector& x)
+{
+    if constexpr( std::is_same_v<get_tensor_category<Vector>, MPIVectorTag>)
+        return x.data();
+    else
+        return x;
+}
 template< class Vector, class Functor, class RecursiveVector, size_t ...I>
-auto do_pullback( Vector& result, Functor f, const RecursiveVector& map,
+void do_pullback( Vector& result, Functor f, const RecursiveVector& map,
         std::index_sequence<I...>)
 {
-    return dg::blas1::evaluate( result, dg::equals(), f, map[I]...);
+#ifdef _OPENMP
+    // Same as in dg::kronecker: evaluate host vectors in parallel with
+    // identical results (each point is computed by exactly one thread)
+    auto& y = local_host_vector( result);
+    const int size = y.size();
+    if( !omp_in_parallel() && size > dg::blas1::detail::MIN_SIZE)
+    {
+        using value_type = std::decay_t<decltype( local_host_vector( map[0])[0])>;
+        std::array<const value_type*, sizeof...(I)> xs{ thrust::raw_pointer_cast(
+            local_host_vector( map[I]).data())...};
+        #pragma omp parallel for
+        for( int i=0; i<size; i++)
+            y[i] = f( xs[I][i]...);
+        return;
+    }
+#endif //_OPENMP
+    dg::blas1::evaluate( result, dg::equals(), f, map[I]...);
 }
 } //namespace detail
 ///@endcond
@@ -36,6 +61,10 @@ auto do_pullback( Vector& result, Functor f, const RecursiveVector& map,
  * You will want to rename those uniquely
  *
  * @return The output vector \c v as a host vector
+ * @note If compiled with OpenMP (and not called from inside a parallel
+ * region) \c f is evaluated by several threads concurrently, so it must not
+ * have side effects. The result is identical to serial evaluation. In MPI
+ * each process evaluates its local points.
  * @ingroup pullback
  * @sa If the function is defined in computational space coordinates, then use \c dg::evaluate
  */
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "dg/file/nc_utilities.h"
+#include "generatorX.h"
+
+namespace dg
+{
+namespace geo
+{
+
+/**
+ * @brief Cache the result of an X-point generator on disk
+ *
+ * The construction of X-point grids (e.g. with \c SeparatrixOrthogonal or
+ * \c RibeiroX) integrates many coordinate lines and can take a long time for
+ * high resolutions. This adaptor forwards to the given generator and writes
+ * the generated coordinates and Jacobian to a netCDF file. When the same
+ * coordinates (i.e. the same resolution) are requested again with the same \c
+ * key the file is read instead.
+ * @snippet{trimleft} cached_generatorX_t.cpp doxygen
+ * @note The adaptor can be used wherever an \c aGeneratorX2d is expected, so
+ * \c CurvilinearGridX2d, \c CurvilinearProductGridX3d and the refined grids
+ * are cached alike
+ * @attention The \c key is the only thing that identifies the equilibrium. It
+ * must change whenever the magnetic field or the generator parameters change
+ * (the json string of the parameters is a good choice).
+ * @note \#include "dg/geometries/cached_generatorX.h" (link -lnetcdf -lhdf5[_serial] -lhdf5[_serial]_hl)
+ * @ingroup generators_geo
+ */
+struct CachedGeneratorX2d : public aGeneratorX2d
+{
+    /**
+     * @brief Construct
+     *
+     * @param generator the generator to cache (is cloned)
+     * @param directory cache files are read from and written to this
+     *  directory (created if it does not exist)
+     * @param key identifies equilibrium and generator parameters (s.a. the
+     *  attention note above)
+     */
+    CachedGeneratorX2d( const aGeneratorX2d& generator,
+            std::filesystem::path directory, std::string key):
+        m_generator( generator), m_dir( directory), m_key( key){ }
+    virtual CachedGeneratorX2d* clone() const override final{return new CachedGeneratorX2d(*this);}
+
+    /**
+     * @brief The file that caches the coordinates for given coordinate lists
+     *
+     * The name is a hash of the key and the arguments
+     * @param zeta1d the list of \f$ \zeta\f$ points
+     * @param eta1d the list of \f$ \eta\f$ points
+     * @param nodeX0 index of the first topology jump in \c eta1d
+     * @param nodeX1 index of the second topology jump in \c eta1d
+     * @return file name in the cache directory
+     * @sa aRealGeneratorX2d::generate
+     */
+    std::filesystem::path filename(
+         const thrust::host_vector<double>& zeta1d,
+         const thrust::host_vector<double>& eta1d,
+         unsigned nodeX0, unsigned nodeX1) const
+    {
+        std::string bytes = m_key + "_" + std::to_string( nodeX0) + "_" +
+            std::to_string( nodeX1);
+        for( auto vec : { &zeta1d, &eta1d})
+            bytes.append( reinterpret_cast<const char*>( thrust::raw_pointer_cast(
+                vec->data())), vec->size()*sizeof(double));
+        std::stringstream ss;
+        ss << "generatorX_"<<std::hex<<std::hash<std::string>{}( bytes)<<".nc";
+        return m_dir / ss.str();
+    }
+    private:
+    virtual bool do_isOrthogonal()const override final{ return m_generator->isOrthogonal();}
+    virtual double do_zeta0(double fx) const override final{ return m_generator->zeta0(fx); }
+    virtual double do_zeta1(double fx) const override final{ return m_generator->zeta1(fx); }
+    virtual double do_eta0(double fy) const override final{ return m_generator->eta0(fy); }
+    virtual double do_eta1(double fy) const override final{ return m_generator->eta1(fy); }
+    virtual void do_generate(
+         const thrust::host_vector<double>& zeta1d,
+         const thrust::host_vector<double>& eta1d,
+         unsigned nodeX0, unsigned nodeX1,
+         thrust::host_vector<double>& x,
+         thrust::host_vector<double>& y,
+         thrust::host_vector<double>& zetaX,
+         thrust::host_vector<double>& zetaY,
+         thrust::host_vector<double>& etaX,
+         thrust::host_vector<double>& etaY) const override final
+    {
+        const std::filesystem::path name = filename( zeta1d, eta1d, nodeX0, nodeX1);
+        const std::array<thrust::host_vector<double>*, 6> out{ &x, &y, &zetaX,
+            &zetaY, &etaX, &etaY};
+        if( read( name, zeta1d, eta1d, nodeX0, nodeX1, out))
+            return;
+        m_generator->generate( zeta1d, eta1d, nodeX0, nodeX1, x, y, zetaX,
+                zetaY, etaX, etaY);
+        write( name, zeta1d, eta1d, nodeX0, nodeX1, out);
+    }
+    // return false if the file does not exist or does not match (hash collision)
+    bool read( const std::filesystem::path& name,
+         const thrust::host_vector<double>& zeta1d,
+         const thrust::host_vector<double>& eta1d,
+         unsigned nodeX0, unsigned nodeX1,
+         const std::array<thrust::host_vector<double>*, 6>& out) const
+    {
+        if( !std::filesystem::exists( name))
+            return false;
+        try{
+            dg::file::SerialNcFile file( name, dg::file::nc_nowrite);
+            if( file.get_att_as<std::string>( "key") != m_key
+                || file.get_att_vec_as<double>( "zeta1d") != std::vector<double>(
+                    zeta1d.begin(), zeta1d.end())
+                || file.get_att_vec_as<double>( "eta1d") != std::vector<double>(
+                    eta1d.begin(), eta1d.end())
+                || file.get_att_vec_as<unsigned>( "nodeX") !=
+                    std::vector<unsigned>{ nodeX0, nodeX1})
+                return false;
+            for( unsigned u=0; u<6; u++)
+                file.get_var( m_names[u], {file, m_names[u]}, *out[u]);
+        }
+        catch( dg::file::NC_Error& err)
+        {
+            return false;
+        }
+        return true;
+    }
+    void write( const std::filesystem::path& name,
+         const thrust::host_vector<double>& zeta1d,
+         const thrust::host_vector<double>& eta1d,
+         unsigned nodeX0, unsigned nodeX1,
+         const std::array<thrust::host_vector<double>*, 6>& out) const
+    {
+        std::filesystem::create_directories( m_dir);
+        // write to a temporary file first so that an interrupted write (or
+        // several processes writing at once) never leaves an incomplete cache
+        // file behind
+        std::filesystem::path tmp = name;
+        tmp += ".tmp" + std::to_string( std::random_device{}());
+        dg::file::SerialNcFile file( tmp, dg::file::nc_clobber);
+        file.put_atts( std::map<std::string, dg::file::nc_att_t>{
+            { "key", m_key},
+            { "zeta1d", std::vector<double>( zeta1d.begin(), zeta1d.end())},
+            { "eta1d", std::vector<double>( eta1d.begin(), eta1d.end())},
+            { "nodeX", std::vector<unsigned>{ nodeX0, nodeX1}}});
+        file.def_dim( "eta", eta1d.size());
+        file.def_dim( "zeta", zeta1d.size());
+        for( unsigned u=0; u<6; u++)
+            file.defput_var( m_names[u], {"eta", "zeta"}, {}, {{0,0},
+                {eta1d.size(), zeta1d.size()}}, *out[u]);
+        file.close();
+        std::filesystem::rename( tmp, name);
+    }
+    dg::ClonePtr<aGeneratorX2d> m_generator;
+    std::filesystem::path m_dir;
+    std::string m_key;
+    std::array<std::string, 6> m_names{ "x", "y", "zetaX", "zetaY", "etaX", "etaY"};
+};
+
+}//namespace geo
+}//namespace dg
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+
+#include "dg/algorithm.h"
+#include "dg/file/file.h"
+
+#include "solovev.h"
+#include "curvilinearX.h"
+#include "separatrix_orthogonal.h"
+#include "cached_generatorX.h"
+
+// Generate an X-point grid, cache it on disk and compare to the cached grid
+
+int main( int argc, char* argv[])
+{
+    auto js = dg::file::file2Json( argc == 1 ? "geometry_params_Xpoint.json" : argv[1]);
+    dg::geo::solovev::Parameters gp(js);
+    dg::geo::TokamakMagneticField mag = dg::geo::createSolovevField(gp);
+    double RX = gp.R_0-1.1*gp.triangularity*gp.a;
+    double ZX = -1.1*gp.elongation*gp.a;
+    dg::geo::findXpoint( mag.get_psip(), RX, ZX);
+    dg::geo::CylindricalSymmTensorLvl1 monitor_chi = dg::geo::make_Xconst_monitor( mag.get_psip(), RX, ZX) ;
+    const double psi_0 = -20, fx = 0.25, fy = 1./22.;
+    const unsigned n = 3, Nx = 8, Ny = 44;
+    dg::geo::SeparatrixOrthogonal sep(mag.get_psip(), monitor_chi, psi_0, RX, ZX, mag.R0(), 0, 0);
+    const std::filesystem::path dir = "cache_generatorX";
+    std::filesystem::remove_all( dir);
+
+    //![doxygen]
+    // the key identifies equilibrium and generator parameters
+    std::string key = dg::file::WrappedJsonValue( gp.dump()).toStyledString()
+        + "SeparatrixOrthogonal psi_0 = " + std::to_string( psi_0);
+    dg::geo::CachedGeneratorX2d generator( sep, dir, key);
+    // the first construction generates and writes the grid to dir ...
+    dg::geo::CurvilinearGridX2d g2d( generator, fx, fy, n, Nx, Ny);
+    // ... and the second one reads it from there
+    dg::geo::CurvilinearGridX2d cached( generator, fx, fy, n, Nx, Ny);
+    //![doxygen]
+    unsigned files = std::distance( std::filesystem::directory_iterator( dir),
+            std::filesystem::directory_iterator{});
+    std::cout << "Number of cache files "<<files<<" (1)\n";
+    assert( files == 1);
+
+    dg::Timer t;
+    t.tic();
+    dg::geo::CurvilinearGridX2d direct( sep, fx, fy, n, Nx, Ny);
+    t.toc();
+    std::cout << "Generation took "<<t.diff()<<"s\n";
+    t.tic();
+    dg::geo::CurvilinearGridX2d read( generator, fx, fy, n, Nx, Ny);
+    t.toc();
+    std::cout << "Reading took    "<<t.diff()<<"s\n";
+    for( auto grid : { &g2d, &cached, &read})
+    {
+        for( unsigned u=0; u<2; u++)
+            assert( grid->map()[u] == direct.map()[u]);
+        dg::SparseTensor<dg::HVec> jac = grid->jacobian(), jacD = direct.jacobian();
+        for( unsigned i=0; i<2; i++)
+            for( unsigned j=0; j<2; j++)
+                assert( jac.value(i,j) == jacD.value(i,j));
+    }
+    std::cout << "Cached grid equals generated grid (correct)\n";
+
+    // a different resolution or key is a different file
+    dg::geo::CurvilinearGridX2d g2d_fine( generator, fx, fy, n, 2*Nx, 2*Ny);
+    dg::geo::CachedGeneratorX2d other( sep, dir, key + " (other)");
+    dg::geo::CurvilinearGridX2d g2d_other( other, fx, fy, n, Nx, Ny);
+    files = std::distance( std::filesystem::directory_iterator( dir),
+            std::filesystem::directory_iterator{});
+    std::cout << "Number of cache files "<<files<<" (3)\n";
+    assert( files == 3);
+    std::filesystem::remove_all( dir);
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -186,9 +186,7 @@ struct RealCurvilinearProductGrid3d : public dg::aRealProductGeometry3d<real_typ
                 generator.height(),gz.x1()}, {tx.n,ty.n, gz.n()},
                 {tx.N, ty.N, gz.N()},{ tx.b, ty.b, gz.bcx()}), m_handle(generator)
     {
-        m_map.resize(3);
         constructPerp( this->nx(), this->Nx(), this->ny(), this->Ny());
-        constructParallel(this->nz(), this->Nz());
     }
 
 
@@ -204,7 +202,6 @@ struct RealCurvilinearProductGrid3d : public dg::aRealProductGeometry3d<real_typ
         if( !( new_n[0] == old_n[0] && new_N[0] == old_N[0] &&
                new_n[1] == old_n[1] && new_N[1] == old_N[1] ) )
             constructPerp( new_n[0], new_N[0], new_n[1],new_N[1]);
-        constructParallel(new_n[2],new_N[2]);
     }
     virtual void do_set(std::array<dg::bc,3> new_bc) override final
     {
@@ -214,26 +211,15 @@ struct RealCurvilinearProductGrid3d : public dg::aRealProductGeometry3d<real_typ
     {
         throw dg::Error(dg::Message(_ping_)<<"This grid cannot change boundaries\n");
     }
-    //construct phi and lift rest to 3d
-    void constructParallel(unsigned nz,unsigned Nz)
+    //copy 2d plane to all planes
+    thrust::host_vector<real_type> lift( const thrust::host_vector<real_type>& in2d) const
     {
-        m_map[2]=dg::evaluate(dg::cooZ3d, *this);
-        unsigned size = this->size();
-        unsigned size2d = this->nx()*this->ny()*this->Nx()*this->Ny();
-        //resize for 3d values
-        for( unsigned r=0; r<6;r++)
-            m_jac.values()[r].resize(size);
-        m_map[0].resize(size);
-        m_map[1].resize(size);
-        //lift to 3D grid
-        for( unsigned k=1; k<nz*Nz; k++)
+        unsigned size2d = in2d.size();
+        thrust::host_vector<real_type> out( this->size());
+        for( unsigned k=0; k<this->nz()*this->Nz(); k++)
             for( unsigned i=0; i<size2d; i++)
-            {
-                for(unsigned r=0; r<6; r++)
-                    m_jac.values()[r][k*size2d+i] = m_jac.values()[r][(k-1)*size2d+i];
-                m_map[0][k*size2d+i] = m_map[0][(k-1)*size2d+i];
-                m_map[1][k*size2d+i] = m_map[1][(k-1)*size2d+i];
-            }
+                out[k*size2d+i] = in2d[i];
+        return out;
     }
     //construct 2d plane
     void constructPerp( unsigned nx, unsigned Nx, unsigned ny, unsigned Ny)
@@ -242,19 +228,36 @@ struct RealCurvilinearProductGrid3d : public dg::aRealProductGeometry3d<real_typ
         dg::Grid1d gY1d( this->y0(), this->y1(), ny, Ny);
         thrust::host_vector<real_type> x_vec = dg::evaluate( dg::cooX1d, gX1d);
         thrust::host_vector<real_type> y_vec = dg::evaluate( dg::cooX1d, gY1d);
-        m_jac = SparseTensor< thrust::host_vector<real_type>>( x_vec);//unit tensor
-        m_jac.values().resize( 6);
-        m_handle->generate( x_vec, y_vec, m_map[0], m_map[1], m_jac.values()[2], m_jac.values()[3], m_jac.values()[4], m_jac.values()[5]);
+        std::vector<thrust::host_vector<real_type>> jac(4);
+        m_map.resize(2);
+        m_handle->generate( x_vec, y_vec, m_map[0], m_map[1], jac[0], jac[1], jac[2], jac[3]);
+        m_jac = SparseTensor< thrust::host_vector<real_type>>( m_map[0]);//unit tensor
+        m_jac.values().insert( m_jac.values().end(), jac.begin(), jac.end());
         m_jac.idx(0,0) = 2, m_jac.idx(0,1) = 3, m_jac.idx(1,0)=4, m_jac.idx(1,1) = 5;
     }
     virtual SparseTensor<thrust::host_vector<real_type> > do_compute_jacobian( ) const override final{
-        return m_jac;
+        SparseTensor<thrust::host_vector<real_type> > jac = m_jac;
+        for( unsigned i=0; i<jac.values().size(); i++)
+            jac.values()[i] = lift( jac.values()[i]);
+        return jac;
     }
     virtual SparseTensor<thrust::host_vector<real_type> > do_compute_metric( ) const override final
+    {
+        SparseTensor<thrust::host_vector<real_type> > metric = do_compute_plane_metric();
+        for( unsigned i=0; i<metric.values().size(); i++)
+            metric.values()[i] = lift( metric.values()[i]);
+        return metric;
+    }
+    virtual SparseTensor<thrust::host_vector<real_type> > do_compute_plane_metric( ) const override final
     {
         return detail::square( m_jac, m_map[0], m_handle->isOrthogonal());
     }
-    virtual std::vector<thrust::host_vector<real_type> > do_compute_map()const override final{return m_map;}
+    virtual std::vector<thrust::host_vector<real_type> > do_compute_map()const override final{
+        std::vector<thrust::host_vector<real_type> > map{ lift( m_map[0]),
+            lift( m_map[1]), dg::evaluate(dg::cooZ3d, *this)};
+        return map;
+    }
+    // only the 2d plane is stored, the 3d values are lifted on demand
     std::vector<thrust::host_vector<real_type> > m_map;
     SparseTensor<thrust::host_vector<real_type> > m_jac;
     dg::ClonePtr<aRealGenerator2d<real_type>> m_handle;
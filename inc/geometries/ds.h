@@ -135,6 +135,20 @@ struct DSSDCentered
     double m_alpha, m_beta, m_delta;
 };
 
+// dssf = alpha*( wP*(fp-fo) - wM*(fo-fm)) + beta*dssf with precomputed weights
+struct DSSWeighted
+{
+    DSSWeighted( double alpha, double beta) : m_alpha(alpha), m_beta(beta){}
+    DG_DEVICE
+    void operator()( double& dssf, double fm, double fo, double fp, double wM,
+        double wP)
+    {
+        dssf = m_alpha*( wP*(fp-fo) - wM*(fo-fm)) + m_beta*dssf;
+    }
+    private:
+    double m_alpha, m_beta;
+};
+
 }//namespace detail
 ///@endcond
 
@@ -366,9 +380,9 @@ struct DS
         double eps = 1e-5,
         unsigned mx=10, unsigned my=10,
         double deltaPhi=-1, std::string interpolation_method = "dg",
-        bool benchmark=true):
+        bool benchmark=true, bool precompute_adjoint=false):
         DS( FA( vec, grid, bcx, bcy, limit, eps, mx, my, deltaPhi,
-                    interpolation_method, benchmark) )
+                    interpolation_method, benchmark, precompute_adjoint) )
     {
     }
     /**
@@ -386,9 +400,9 @@ struct DS
         double eps = 1e-5,
         unsigned mx=10, unsigned my=10,
         double deltaPhi=-1, std::string interpolation_method = "dg",
-        bool benchmark=true):
+        bool benchmark=true, bool precompute_adjoint=false):
         DS( FA( vec, grid, bcx, bcy, limit, eps, mx, my, deltaPhi,
-                    interpolation_method, benchmark))
+                    interpolation_method, benchmark, precompute_adjoint))
     {
     }
     /**
@@ -429,9 +443,9 @@ struct DS
     * @copydoc hide_ds_parameters4
     */
     void forward( double alpha, const container& f, double beta, container& g){
-        m_fa(zeroForw, f, m_tempO);
+        const container& fo = center( f);
         m_fa(einsPlus, f, m_tempP);
-        ds_forward( m_fa, alpha, m_tempO, m_tempP, beta, g);
+        ds_forward( m_fa, alpha, fo, m_tempP, beta, g);
     }
     /**
     * @brief 2nd order forward derivative \f$ g = \alpha \vec v \cdot \nabla f + \beta g\f$
@@ -440,10 +454,10 @@ struct DS
     * @copydoc hide_ds_parameters4
     */
     void forward2( double alpha, const container& f, double beta, container& g){
-        m_fa(zeroForw, f, m_tempO);
+        const container& fo = center( f);
         m_fa(einsPlus, f, m_tempP);
         m_fa(einsPlus, m_tempP, m_tempM);
-        ds_forward2( m_fa, alpha, m_tempO, m_tempP, m_tempM, beta, g);
+        ds_forward2( m_fa, alpha, fo, m_tempP, m_tempM, beta, g);
     }
     /**
     * @brief backward derivative \f$ g = \alpha \vec v \cdot \nabla f + \beta g\f$
@@ -453,8 +467,8 @@ struct DS
     */
     void backward( double alpha, const container& f, double beta, container& g){
         m_fa(einsMinus, f, m_tempM);
-        m_fa(zeroForw, f, m_tempO);
-        ds_backward( m_fa, alpha, m_tempM, m_tempO, beta, g);
+        const container& fo = center( f);
+        ds_backward( m_fa, alpha, m_tempM, fo, beta, g);
     }
     /**
     * @brief 2nd order backward derivative \f$ g = \alpha \vec v \cdot \nabla f + \beta g\f$
@@ -465,8 +479,8 @@ struct DS
     void backward2( double alpha, const container& f, double beta, container& g){
         m_fa(einsMinus, f, m_tempM);
         m_fa(einsMinus, m_tempM, m_tempP);
-        m_fa(zeroForw, f, m_tempO);
-        ds_backward2( m_fa, alpha, m_tempP, m_tempM, m_tempO, beta, g);
+        const container& fo = center( f);
+        ds_backward2( m_fa, alpha, m_tempP, m_tempM, fo, beta, g);
     }
     /**
     * @brief centered derivative \f$ g = \alpha \vec v \cdot \nabla f + \beta g\f$
@@ -527,16 +541,16 @@ struct DS
     ///@copydoc hide_ds_attention
     void divForward( double alpha, const container& f, double beta, container& g){
         m_fa(einsPlus,  f, m_tempP);
-        m_fa(zeroForw,  f, m_tempO);
-        ds_divForward( m_fa, alpha, m_tempO, m_tempP, beta, g);
+        const container& fo = center( f);
+        ds_divForward( m_fa, alpha, fo, m_tempP, beta, g);
     }
     ///@brief backward divergence \f$ g = \alpha \nabla\cdot(\vec v f) + \beta g\f$
     ///@copydoc hide_ds_parameters4
     ///@copydoc hide_ds_attention
     void divBackward( double alpha, const container& f, double beta, container& g){
         m_fa(einsMinus,  f, m_tempM);
-        m_fa(zeroForw,  f, m_tempO);
-        ds_divBackward( m_fa, alpha, m_tempM, m_tempO, beta, g);
+        const container& fo = center( f);
+        ds_divBackward( m_fa, alpha, m_tempM, fo, beta, g);
     }
     ///@brief centered divergence \f$ g = \alpha \nabla\cdot(\vec v f) + \beta g\f$
     ///@copydoc hide_ds_parameters4
@@ -637,8 +651,10 @@ struct DS
     void dss( double alpha, const container& f, double beta, container& g){
         m_fa(einsPlus, f, m_tempP);
         m_fa(einsMinus, f, m_tempM);
-        m_fa(zeroForw,  f, m_tempO);
-        dss_centered( m_fa, alpha, m_tempM, m_tempO, m_tempP, beta, g);
+        const container& fo = center( f);
+        if( !m_have_weights) update_weights();
+        dg::blas1::subroutine( detail::DSSWeighted( alpha, beta),
+            g, m_tempM, fo, m_tempP, m_dssM, m_dssP);
     }
     /// Same as \c dg::geo::dss_centered after \c dg::geo::ds_assign_bc_along_field_2nd
     void dss_bc_along_field(
@@ -646,18 +662,22 @@ struct DS
         std::array<double,2> boundary_value = {0,0}){
         m_fa(einsPlus, f, m_tempP);
         m_fa(einsMinus, f, m_tempM);
-        m_fa(zeroForw,  f, m_tempO);
-        assign_bc_along_field_2nd( m_fa, m_tempM, m_tempO, m_tempP, m_tempM, m_tempP,
+        const container& fo = center( f);
+        assign_bc_along_field_2nd( m_fa, m_tempM, fo, m_tempP, m_tempM, m_tempP,
                 bound, boundary_value);
-        dss_centered( m_fa, alpha, m_tempM, m_tempO, m_tempP, beta, g);
+        if( !m_have_weights) update_weights();
+        dg::blas1::subroutine( detail::DSSWeighted( alpha, beta),
+            g, m_tempM, fo, m_tempP, m_dssM, m_dssP);
     }
     /// Same as \c dg::geo::dssd_centered
     void dssd( double alpha, const container& f, double
             beta, container& g){
         m_fa(einsPlus, f, m_tempP);
         m_fa(einsMinus, f, m_tempM);
-        m_fa(zeroForw,  f, m_tempO);
-        dssd_centered( m_fa, alpha, m_tempM, m_tempO, m_tempP, beta, g);
+        const container& fo = center( f);
+        if( !m_have_weights) update_weights();
+        dg::blas1::subroutine( detail::DSSWeighted( alpha, beta),
+            g, m_tempM, fo, m_tempP, m_dssdM, m_dssdP);
     }
     /// Same as \c dg::geo::dssd_centered after \c dg::geo::ds_assign_bc_along_field_2nd
     void dssd_bc_along_field( double alpha, const
@@ -665,10 +685,12 @@ struct DS
             std::array<double,2> boundary_value = {0,0}){
         m_fa(einsPlus, f, m_tempP);
         m_fa(einsMinus, f, m_tempM);
-        m_fa(zeroForw,  f, m_tempO);
-        assign_bc_along_field_2nd( m_fa, m_tempM, m_tempO, m_tempP, m_tempM, m_tempP,
+        const container& fo = center( f);
+        assign_bc_along_field_2nd( m_fa, m_tempM, fo, m_tempP, m_tempM, m_tempP,
                 bound, boundary_value);
-        dssd_centered( m_fa, alpha, m_tempM, f, m_tempP, beta, g);
+        if( !m_have_weights) update_weights();
+        dg::blas1::subroutine( detail::DSSWeighted( alpha, beta),
+            g, m_tempM, f, m_tempP, m_dssdM, m_dssdP);
     }
 
     /// The volume form with dG weights
@@ -680,12 +702,25 @@ struct DS
     * @brief access the underlying Fieldaligned object
     *
     * @return acces to Fieldaligned object
+    * @attention If you assign a new object through this reference call
+    * \c construct instead, else the cached weights of \c dss and \c dssd
+    * are outdated
     */
     FA& fieldaligned(){return m_fa;}
     const FA& fieldaligned()const{return m_fa;}
     private:
+    // The zeroForw transformation is the identity for the "dg" method
+    const container& center( const container& f){
+        if( m_fa.method() == "dg")
+            return f;
+        m_fa(zeroForw, f, m_tempO);
+        return m_tempO;
+    }
+    void update_weights();
     Fieldaligned<ProductGeometry, IMatrix, container> m_fa;
     container m_tempP, m_tempO, m_tempM;
+    container m_dssM, m_dssP, m_dssdM, m_dssdP; // weights of fm and fp
+    bool m_have_weights = false;
 };
 
 ///@cond
@@ -697,6 +732,29 @@ DS<Geometry, I, container>::DS( Fieldaligned<Geometry, I, container> fa): m_fa(f
     m_tempP = fa.sqrtG(), m_tempM = m_tempO = m_tempP;
 }
 
+// Combine all metric and bphi factors of dss_centered and dssd_centered
+// into one weight for fm and one for fp such that the dss and dssd members
+// read 5 instead of 7 or 10 3d vectors
+template<class G, class I, class container>
+void DS<G,I,container>::update_weights()
+{
+    m_dssM = m_dssP = m_dssdM = m_dssdP = m_fa.sqrtG();
+    double delta = m_fa.deltaPhi();
+    dg::blas1::subroutine( [delta]DG_DEVICE( double& dssM, double& dssP,
+            double& dssdM, double& dssdP, double Gm, double Go, double Gp,
+            double bPm, double bP0, double bPp)
+        {
+            double bP2 = (bPp+bP0)/2.;
+            double bM2 = (bPm+bP0)/2.;
+            dssM  = bP0*bM2/delta/delta;
+            dssP  = bP0*bP2/delta/delta;
+            dssdM = (Gm + Go)/Go/2.*bM2*bM2/delta/delta;
+            dssdP = (Gp + Go)/Go/2.*bP2*bP2/delta/delta;
+        }, m_dssM, m_dssP, m_dssdM, m_dssdP, m_fa.sqrtGm(), m_fa.sqrtG(),
+        m_fa.sqrtGp(), m_fa.bphiM(), m_fa.bphi(), m_fa.bphiP());
+    m_have_weights = true;
+}
+
 template<class G, class I, class container>
 inline void DS<G,I,container>::ds( dg::direction dir, double alpha,
     const container& f, double beta, container& dsf) {
@@ -6,6 +6,7 @@
 #include "magnetic_field.h"
 #include "fluxfunctions.h"
 #include "curvilinear.h"
+#include "fieldline_tracer.h"
 
 namespace dg{
 namespace geo{
@@ -133,25 +134,57 @@ struct DSField
     dg::ClonePtr<dg::aGeometry2d> m_g;
 };
 
-//used in constructor of Fieldaligned
+//trace the fieldlines starting at the points y = (x, y, vol) in [phiMin, phiMax]
+inline FieldlineTracer trace_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
+    const dg::aGeometry2d& grid_field,
+    const std::array<thrust::host_vector<double>,3>& y,
+    double phiMin, double phiMax, double eps)
+{
+    //grid_field contains the global geometry for the field and the boundaries
+    //field in case of cartesian grid
+    if( dynamic_cast<const dg::CartesianGrid2d*>( &grid_field))
+        return FieldlineTracer( dg::geo::detail::DSFieldCylindrical4(vec), y,
+                phiMin, phiMax, eps);
+    //construct field on high polynomial grid, then integrate it
+    return FieldlineTracer( dg::geo::detail::DSField( vec, grid_field), y,
+            phiMin, phiMax, eps);
+}
+
+//evaluate traced fieldlines at deltaPhi and find the boundary distance
 template<class real_type>
-void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
+void evaluate_fieldlines2d( const FieldlineTracer& tracer,
     const dg::aRealGeometry2d<real_type>& grid_field,
-    const dg::aRealTopology2d<real_type>& grid_evaluate,
     std::array<thrust::host_vector<real_type>,3>& yp,
-    const thrust::host_vector<double>& vol0,
+    thrust::host_vector<real_type>& yp2b,
+    thrust::host_vector<bool>& in_boxp,
+    real_type deltaPhi, real_type eps)
+{
+    const unsigned size = tracer.size();
+    tracer.evaluate( deltaPhi, yp);
+    yp2b.assign( size, deltaPhi); //allocate memory for output
+    in_boxp.resize( yp2b.size());
+    for( unsigned i=0; i<size; i++)
+    {
+        in_boxp[i] = grid_field.contains( std::array{yp[0][i], yp[1][i]}) ? true : false;
+        if( false == in_boxp[i])
+            yp2b[i] = tracer.leave( i, deltaPhi, (const
+                        dg::aRealTopology2d<real_type>&)grid_field, eps);
+    }
+}
+
+//integrate the fieldlines starting at the points y = (x, y, vol)
+template<class real_type>
+void integrate_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
+    const dg::aRealGeometry2d<real_type>& grid_field,
+    const std::array<thrust::host_vector<real_type>,3>& y,
+    std::array<thrust::host_vector<real_type>,3>& yp,
     thrust::host_vector<real_type>& yp2b,
     thrust::host_vector<bool>& in_boxp,
     real_type deltaPhi, real_type eps)
 {
     //grid_field contains the global geometry for the field and the boundaries
-    //grid_evaluate contains the points to actually integrate
-    std::array<thrust::host_vector<real_type>,3> y{
-        dg::evaluate( dg::cooX2d, grid_evaluate),
-        dg::evaluate( dg::cooY2d, grid_evaluate),
-        vol0
-    };
-    yp.fill(dg::evaluate( dg::zero, grid_evaluate));
+    const unsigned size = y[0].size();
+    yp.fill( thrust::host_vector<real_type>( size, 0.));
     //construct field on high polynomial grid, then integrate it
     dg::geo::detail::DSField field;
     if( !dynamic_cast<const dg::CartesianGrid2d*>( &grid_field))
@@ -159,7 +192,6 @@ void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
 
     //field in case of cartesian grid
     dg::geo::detail::DSFieldCylindrical4 cyl_field(vec);
-    const unsigned size = grid_evaluate.size();
     dg::Adaptive<dg::ERKStep<std::array<real_type,3>>> adapt(
             "Dormand-Prince-7-4-5", std::array<real_type,3>{0,0,0});
     dg::AdaptiveTimeloop< std::array<real_type,3>> odeint;
@@ -179,7 +211,7 @@ void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
         odeint.integrate( 0, coords, phi1, coordsP);
         yp[0][i] = coordsP[0], yp[1][i] = coordsP[1], yp[2][i] = coordsP[2];
     }
-    yp2b.assign( grid_evaluate.size(), deltaPhi); //allocate memory for output
+    yp2b.assign( size, deltaPhi); //allocate memory for output
     in_boxp.resize( yp2b.size());
     //Now integrate again but this time find the boundary distance
     for( unsigned i=0; i<size; i++)
@@ -197,6 +229,46 @@ void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
     }
 }
 
+//used in constructor of Fieldaligned
+template<class real_type>
+void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
+    const dg::aRealGeometry2d<real_type>& grid_field,
+    const dg::aRealTopology2d<real_type>& grid_evaluate,
+    std::array<thrust::host_vector<real_type>,3>& yp,
+    const thrust::host_vector<double>& vol0,
+    thrust::host_vector<real_type>& yp2b,
+    thrust::host_vector<bool>& in_boxp,
+    real_type deltaPhi, real_type eps)
+{
+    //grid_evaluate contains the points to actually integrate
+    std::array<thrust::host_vector<real_type>,3> y{
+        dg::evaluate( dg::cooX2d, grid_evaluate),
+        dg::evaluate( dg::cooY2d, grid_evaluate),
+        vol0
+    };
+    integrate_fieldlines2d( vec, grid_field, y, yp, yp2b, in_boxp, deltaPhi, eps);
+}
+
+//used in trace_fieldlines
+//trace the fieldlines starting at the nodes of the perpendicular grid
+inline FieldlineTracer trace_all_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
+    const dg::aProductGeometry3d& grid, double maxPhi, double eps)
+{
+    dg::ClonePtr<dg::aGeometry2d> grid_transform( grid.perp_grid()) ;
+    dg::ClonePtr<dg::aGeometry2d> grid_magnetic = grid_transform;//INTEGRATE HIGH ORDER GRID
+    grid_magnetic->set( grid_transform->n() < 3 ? 4 : 7, grid_magnetic->Nx(), grid_magnetic->Ny());
+    thrust::host_vector<double> vol = dg::tensor::volume(grid.metric()), vol2d0;
+    auto vol2d = dg::split( vol, grid);
+    dg::assign( vol2d[0], vol2d0);
+    std::array<thrust::host_vector<double>,3> y{
+        dg::evaluate( dg::cooX2d, *grid_transform),
+        dg::evaluate( dg::cooY2d, *grid_transform),
+        vol2d0
+    };
+    return trace_fieldlines2d( vec, *grid_magnetic, y, -fabs(maxPhi),
+            fabs(maxPhi), eps);
+}
+
 
 }//namespace detail
 ///@endcond
@@ -252,6 +324,10 @@ void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
      * to \c create::projection (from the fine grid to the given grid)
      *
      * @param benchmark If true write construction timings to std::cout
+     * @param precompute_adjoint If true the transposed interpolation
+     * matrices (needed for \c einsPlusT, \c einsMinusT, \c zeroPlusT and \c
+     * zeroMinusT) are computed in the constructor, else they are computed on
+     * their first use
     */
 //////////////////////////////FieldalignedCLASS////////////////////////////////////////////
 /**
@@ -285,10 +361,12 @@ struct Fieldaligned
         unsigned mx=12, unsigned my=12,
         double deltaPhi = -1,
         std::string interpolation_method = "linear-nearest",
-        bool benchmark=true
+        bool benchmark=true,
+        bool precompute_adjoint=false
         ):
             Fieldaligned( dg::geo::createBHat(vec),
-                grid, bcx, bcy, limit, eps, mx, my, deltaPhi, interpolation_method, benchmark)
+                grid, bcx, bcy, limit, eps, mx, my, deltaPhi, interpolation_method, benchmark,
+                precompute_adjoint)
     {
     }
 
@@ -305,8 +383,55 @@ struct Fieldaligned
         unsigned mx=12, unsigned my=12,
         double deltaPhi = -1,
         std::string interpolation_method = "linear-nearest",
-        bool benchmark=true
-        );
+        bool benchmark=true,
+        bool precompute_adjoint=false
+        ): Fieldaligned( nullptr, vec, grid, bcx, bcy, limit, eps, mx, my,
+                deltaPhi, interpolation_method, benchmark, precompute_adjoint)
+    {
+    }
+    /**
+    * @brief Construct from already traced field lines
+    *
+    * Skips the field line integration, which is usually the most expensive
+    * part of the construction. Use this to construct several objects that
+    * differ only in \c deltaPhi (e.g. a staggered one with half the plane
+    * distance) or in the interpolation parameters from one integration:
+    * @code
+    dg::geo::FieldlineTracer tracer = dg::geo::trace_fieldlines( bhat, grid, grid.hz(), 1e-8);
+    dg::geo::Fieldaligned<dg::aProductGeometry3d, dg::IDMatrix, dg::DVec> fa( tracer, bhat, grid, dg::NEU, dg::NEU, dg::geo::NoLimiter(), 12, 12, grid.hz());
+    dg::geo::Fieldaligned<dg::aProductGeometry3d, dg::IDMatrix, dg::DVec> faST( tracer, bhat, grid, dg::NEU, dg::NEU, dg::geo::NoLimiter(), 12, 12, grid.hz()/2.);
+    * @endcode
+    * @param tracer The result of \c trace_fieldlines(vec,grid,maxPhi,eps) with the
+    * same \c vec and perpendicular grid and <tt> maxPhi >= deltaPhi</tt>.
+    * The accuracy \c tracer.eps() is used in place of the \c eps parameter.
+    * The results agree with the ones of the above constructor to the
+    * accuracy of the field line integration (s.a. \c FieldlineTracer).
+    * @attention Throws a \c dg::Error if \c tracer does not match \c grid
+    * or \c deltaPhi
+    * @copydoc hide_fieldaligned_physics_parameters
+    * @param mx refinement factor in X of the fine grid relative to grid (s.a. above)
+    * @param my analogous to \c mx, applies to y direction
+    * @param deltaPhi The angular distance between the planes (s.a. above)
+    * @param interpolation_method (s.a. above)
+    * @param benchmark If true write construction timings to std::cout
+    * @param precompute_adjoint (s.a. above)
+    */
+    template <class Limiter>
+    Fieldaligned(const FieldlineTracer& tracer,
+        const dg::geo::CylindricalVectorLvl1& vec,
+        const ProductGeometry& grid,
+        dg::bc bcx = dg::NEU,
+        dg::bc bcy = dg::NEU,
+        Limiter limit = FullLimiter(),
+        unsigned mx=12, unsigned my=12,
+        double deltaPhi = -1,
+        std::string interpolation_method = "linear-nearest",
+        bool benchmark=true,
+        bool precompute_adjoint=false
+        ): Fieldaligned( &tracer, vec, grid, bcx, bcy, limit, tracer.eps(), mx,
+                my, deltaPhi, interpolation_method, benchmark, precompute_adjoint)
+    {
+    }
     /**
     * @brief Perfect forward parameters to one of the constructors
     * @tparam Params deduced by the compiler
@@ -509,9 +634,19 @@ struct Fieldaligned
     std::string method() const{return m_interpolation_method;}
 
     private:
+    // tracer == nullptr means integrate field lines here
+    template <class Limiter>
+    Fieldaligned(const FieldlineTracer* tracer,
+        const dg::geo::CylindricalVectorLvl1& vec,
+        const ProductGeometry& grid,
+        dg::bc bcx, dg::bc bcy, Limiter limit, double eps,
+        unsigned mx, unsigned my, double deltaPhi,
+        std::string interpolation_method, bool benchmark,
+        bool precompute_adjoint);
     void ePlus( enum whichMatrix which, const container& in, container& out);
     void eMinus(enum whichMatrix which, const container& in, container& out);
     void zero( enum whichMatrix which, const container& in, container& out);
+    void symv_planes( const IMatrix& m, unsigned shift, const container& in, container& out);
     IMatrix m_plus, m_zero, m_minus, m_plusT, m_minusT; //2d interpolation matrices
     container m_hbm, m_hbp;         //3d size
     container m_G, m_Gm, m_Gp; // 3d size
@@ -539,16 +674,40 @@ struct Fieldaligned
     }
 };
 
+/**
+ * @brief Integrate the field lines of \c Fieldaligned once
+ *
+ * Traces the field lines starting at the nodes of \c grid.perp_grid()
+ * in \f$ [-\varphi_{\max}, \varphi_{\max}]\f$ with the same field and
+ * integrator as the \c Fieldaligned constructor. The result can be passed to the
+ * \c Fieldaligned constructor for any \c deltaPhi with
+ * <tt>|deltaPhi| <= maxPhi</tt>
+ * @param vec The vector field to integrate
+ * @param grid The grid of the \c Fieldaligned objects
+ * @param maxPhi The maximum angular distance (typically \c grid.hz())
+ * @param eps Desired accuracy of the fieldline integrator
+ * @return the traced field lines
+ * @note Only for shared memory geometries
+ * @ingroup fieldaligned
+ */
+inline FieldlineTracer trace_fieldlines( const dg::geo::CylindricalVectorLvl1& vec,
+    const dg::aProductGeometry3d& grid, double maxPhi, double eps = 1e-5)
+{
+    return detail::trace_all_fieldlines2d( vec, grid, maxPhi, eps);
+}
+
 ///@cond
 
 ////////////////////////////////////DEFINITIONS///////////////////////////////////////
 template<class Geometry, class IMatrix, class container>
 template <class Limiter>
 Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
+    const FieldlineTracer* tracer,
     const dg::geo::CylindricalVectorLvl1& vec,
     const Geometry& grid,
     dg::bc bcx, dg::bc bcy, Limiter limit, double eps,
-    unsigned mx, unsigned my, double deltaPhi, std::string interpolation_method, bool benchmark) :
+    unsigned mx, unsigned my, double deltaPhi, std::string interpolation_method, bool benchmark,
+    bool precompute_adjoint) :
         m_g(grid),
         m_interpolation_method(interpolation_method)
 {
@@ -599,12 +758,34 @@ Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
     thrust::host_vector<bool> in_boxp, in_boxm;
     thrust::host_vector<double> hbp, hbm;
     thrust::host_vector<double> vol = dg::tensor::volume(grid.metric()), vol2d0;
-    auto vol2d = dg::split( vol, grid);
-    dg::assign( vol2d[0], vol2d0);
-    detail::integrate_all_fieldlines2d( vec, *grid_magnetic, *grid_transform,
-            yp_trafo, vol2d0, hbp, in_boxp, deltaPhi, eps);
-    detail::integrate_all_fieldlines2d( vec, *grid_magnetic, *grid_transform,
-            ym_trafo, vol2d0, hbm, in_boxm, -deltaPhi, eps);
+    if( tracer == nullptr)
+    {
+        auto vol2d = dg::split( vol, grid);
+        dg::assign( vol2d[0], vol2d0);
+        detail::integrate_all_fieldlines2d( vec, *grid_magnetic, *grid_transform,
+                yp_trafo, vol2d0, hbp, in_boxp, deltaPhi, eps);
+        detail::integrate_all_fieldlines2d( vec, *grid_magnetic, *grid_transform,
+                ym_trafo, vol2d0, hbm, in_boxm, -deltaPhi, eps);
+    }
+    else
+    {
+        if( tracer->size() != grid_transform->size())
+            throw dg::Error( dg::Message(_ping_)<<"Fieldaligned: The tracer has "
+                <<tracer->size()<<" field lines but the grid has "
+                <<grid_transform->size()<<" points per plane!");
+        for( unsigned i=0; i<tracer->size(); i++)
+        {
+            std::array<double,2> range = tracer->range(i);
+            if( range[0] > -deltaPhi || range[1] < deltaPhi)
+                throw dg::Error( dg::Message(_ping_)<<"Fieldaligned: The tracer "
+                    <<"range ["<<range[0]<<", "<<range[1]<<"] does not contain "
+                    <<"deltaPhi "<<deltaPhi<<"!");
+        }
+        detail::evaluate_fieldlines2d( *tracer, *grid_magnetic, yp_trafo, hbp,
+                in_boxp, deltaPhi, eps);
+        detail::evaluate_fieldlines2d( *tracer, *grid_magnetic, ym_trafo, hbm,
+                in_boxm, -deltaPhi, eps);
+    }
     dg::HVec Xf = dg::evaluate(  dg::cooX2d, grid_fine);
     dg::HVec Yf = dg::evaluate(  dg::cooY2d, grid_fine);
     {
@@ -658,6 +839,16 @@ Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
     {
         t.toc();
         std::cout << "# DS: Multiplication PI    took: "<<t.diff()<<"\n";
+        t.tic();
+    }
+    if( precompute_adjoint)
+    {
+        updateAdjoint();
+        if( benchmark)
+        {
+            t.toc();
+            std::cout << "# DS: Transposition        took: "<<t.diff()<<"\n";
+        }
     }
     ///%%%%%%%%%%%%%%%%%%%%copy into h vectors %%%%%%%%%%%%%%%%%%%//
     dg::HVec hbphi( yp_trafo[2]), hbphiP(hbphi), hbphiM(hbphi);
@@ -809,58 +1000,77 @@ void Fieldaligned<G, I, container >::operator()(enum whichMatrix which, const co
             which == zeroForw  ) zero(   which, f, fe);
 }
 
+// out plane i0 = m * (in plane (i0+shift)%Nz) for all planes
 template< class G, class I, class container>
-void Fieldaligned<G, I, container>::zero( enum whichMatrix which,
-        const container& f, container& f0)
+void Fieldaligned<G, I, container>::symv_planes( const I& m, unsigned shift,
+        const container& in, container& out)
 {
-    dg::split( f, m_f, *m_g);
-    dg::split( f0, m_temp, *m_g);
-    //1. compute 2d interpolation in every plane and store in m_temp
-    for( unsigned i0=0; i0<m_Nz; i0++)
+    if constexpr( std::is_same_v<dg::get_tensor_category<I>, dg::SparseMatrixTag>)
     {
-        if(which == zeroPlus)
-            dg::blas2::symv( m_plus,   m_f[i0], m_temp[i0]);
-        else if(which == zeroMinus)
-            dg::blas2::symv( m_minus,  m_f[i0], m_temp[i0]);
-        else if(which == zeroPlusT)
-        {
-            if( ! m_have_adjoint) updateAdjoint( );
-            dg::blas2::symv( m_plusT,  m_f[i0], m_temp[i0]);
-        }
-        else if(which == zeroMinusT)
+        // Read the matrix only once for all planes: out planes [0, Nz-shift)
+        // come from in planes [shift, Nz) and out planes [Nz-shift, Nz)
+        // from in planes [0, shift)
+        unsigned size = m_perp_size, num = m_Nz - shift;
+        dg::View<const container> in_view( in.data() + shift*size, num*size);
+        dg::View<container> out_view( out.data(), num*size);
+        m.symm( num, 1., in_view, 0., out_view);
+        if( shift > 0)
         {
-            if( ! m_have_adjoint) updateAdjoint( );
-            dg::blas2::symv( m_minusT, m_f[i0], m_temp[i0]);
-        }
-        else if( which == zeroForw)
-        {
-            if ( m_interpolation_method != "dg" )
-            {
-                dg::blas2::symv( m_zero, m_f[i0], m_temp[i0]);
-            }
-            else
-                dg::blas1::copy( m_f[i0], m_temp[i0]);
+            in_view.construct( in.data(), shift*size);
+            out_view.construct( out.data() + num*size, shift*size);
+            m.symm( shift, 1., in_view, 0., out_view);
         }
     }
+    else
+    {
+        dg::split( in, m_f, *m_g);
+        dg::split( out, m_temp, *m_g);
+        for( unsigned i0=0; i0<m_Nz; i0++)
+            dg::blas2::symv( m, m_f[(i0+shift)%m_Nz], m_temp[i0]);
+    }
+}
+
+template< class G, class I, class container>
+void Fieldaligned<G, I, container>::zero( enum whichMatrix which,
+        const container& f, container& f0)
+{
+    //1. compute 2d interpolation in every plane and store in f0
+    if(which == zeroPlus)
+        symv_planes( m_plus,   0, f, f0);
+    else if(which == zeroMinus)
+        symv_planes( m_minus,  0, f, f0);
+    else if(which == zeroPlusT)
+    {
+        if( ! m_have_adjoint) updateAdjoint( );
+        symv_planes( m_plusT,  0, f, f0);
+    }
+    else if(which == zeroMinusT)
+    {
+        if( ! m_have_adjoint) updateAdjoint( );
+        symv_planes( m_minusT, 0, f, f0);
+    }
+    else if( which == zeroForw)
+    {
+        if ( m_interpolation_method != "dg" )
+            symv_planes( m_zero, 0, f, f0);
+        else
+            dg::blas1::copy( f, f0);
+    }
 }
 template< class G, class I, class container>
 void Fieldaligned<G, I, container>::ePlus( enum whichMatrix which,
         const container& f, container& fpe)
 {
-    dg::split( f, m_f, *m_g);
-    dg::split( fpe, m_temp, *m_g);
-    //1. compute 2d interpolation in every plane and store in m_temp
-    for( unsigned i0=0; i0<m_Nz; i0++)
+    //1. compute 2d interpolation in every plane and store in fpe
+    if(which == einsPlus)
+        symv_planes( m_plus,   1, f, fpe);
+    else if(which == einsMinusT)
     {
-        unsigned ip = (i0==m_Nz-1) ? 0:i0+1;
-        if(which == einsPlus)
-            dg::blas2::symv( m_plus,   m_f[ip], m_temp[i0]);
-        else if(which == einsMinusT)
-        {
-            if( ! m_have_adjoint) updateAdjoint( );
-            dg::blas2::symv( m_minusT, m_f[ip], m_temp[i0]);
-        }
+        if( ! m_have_adjoint) updateAdjoint( );
+        symv_planes( m_minusT, 1, f, fpe);
     }
+    dg::split( f, m_f, *m_g);
+    dg::split( fpe, m_temp, *m_g);
     //2. apply right boundary conditions in last plane
     unsigned i0=m_Nz-1;
     if( m_bcz != dg::PER)
@@ -879,20 +1089,16 @@ template< class G, class I, class container>
 void Fieldaligned<G, I, container>::eMinus( enum whichMatrix which,
         const container& f, container& fme)
 {
-    dg::split( f, m_f, *m_g);
-    dg::split( fme, m_temp, *m_g);
-    //1. compute 2d interpolation in every plane and store in m_temp
-    for( unsigned i0=0; i0<m_Nz; i0++)
+    //1. compute 2d interpolation in every plane and store in fme
+    if(which == einsPlusT)
     {
-        unsigned im = (i0==0) ? m_Nz-1:i0-1;
-        if(which == einsPlusT)
-        {
-            if( ! m_have_adjoint) updateAdjoint( );
-            dg::blas2::symv( m_plusT, m_f[im], m_temp[i0]);
-        }
-        else if (which == einsMinus)
-            dg::blas2::symv( m_minus, m_f[im], m_temp[i0]);
+        if( ! m_have_adjoint) updateAdjoint( );
+        symv_planes( m_plusT, m_Nz-1, f, fme);
     }
+    else if (which == einsMinus)
+        symv_planes( m_minus, m_Nz-1, f, fme);
+    dg::split( f, m_f, *m_g);
+    dg::split( fme, m_temp, *m_g);
     //2. apply left boundary conditions in first plane
     unsigned i0=0;
     if( m_bcz != dg::PER)
@@ -920,6 +1126,7 @@ container Fieldaligned<G, I,container>::evaluate( BinaryOp binary,
     container zero2d = dg::evaluate( dg::zero, *g2d);
 
     container temp(init2d), tempP(init2d), tempM(init2d);
+    container powP(init2d), powM(init2d); // I^rep init2d
     container vec3d = dg::evaluate( dg::zero, *m_g);
     std::vector<container>  plus2d(m_Nz, zero2d), minus2d(plus2d), result(plus2d);
     unsigned turns = rounds;
@@ -928,18 +1135,18 @@ container Fieldaligned<G, I,container>::evaluate( BinaryOp binary,
     for( unsigned r=0; r<turns; r++)
         for( unsigned i0=0; i0<m_Nz; i0++)
         {
-            dg::blas1::copy( init2d, tempP);
-            dg::blas1::copy( init2d, tempM);
             unsigned rep = r*m_Nz + i0;
-            for(unsigned k=0; k<rep; k++)
+            if( rep > 0) // apply once more to the previous power
             {
                 //!!! The value of f at the plus plane is I^- of the current plane
-                dg::blas2::symv( m_minus, tempP, temp);
-                temp.swap( tempP);
+                dg::blas2::symv( m_minus, powP, temp);
+                temp.swap( powP);
                 //!!! The value of f at the minus plane is I^+ of the current plane
-                dg::blas2::symv( m_plus, tempM, temp);
-                temp.swap( tempM);
+                dg::blas2::symv( m_plus, powM, temp);
+                temp.swap( powM);
             }
+            dg::blas1::copy( powP, tempP);
+            dg::blas1::copy( powM, tempM);
             dg::blas1::scal( tempP, unary(  (double)rep*m_deltaPhi ) );
             dg::blas1::scal( tempM, unary( -(double)rep*m_deltaPhi ) );
             dg::blas1::axpby( 1., tempP, 1., plus2d[i0]);
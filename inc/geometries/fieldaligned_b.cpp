@@ -0,0 +1,123 @@
+#include <iostream>
+#include <iomanip>
+
+#include "dg/algorithm.h"
+#include "magnetic_field.h"
+#include "testfunctors.h"
+#include "ds.h"
+#include "toroidal.h"
+
+// Benchmark the plane transformations of Fieldaligned and DS
+// The 2d interpolation matrix is applied to all planes at once (SpMM), which
+// is compared to applying it plane by plane with dg::blas2::symv
+
+const double R_0 = 10;
+const double I_0 = 20; //q factor at r=1 is I_0/R_0
+const double a  = 1; //small radius
+
+int main(int argc, char * argv[])
+{
+    std::cout << "# Benchmark Fieldaligned plane transformations in cylindrical coordinates for circular flux surfaces\n";
+    unsigned n, Nx, Ny, Nz, mx[2];
+    std::string method = "cubic";
+    std::cout << "# Type n (3), Nx(20), Ny(20), Nz(20)\n";
+    std::cin >> n>> Nx>>Ny>>Nz;
+    std::cout << "# Type mx (10) and my (10)\n";
+    std::cin >> mx[0]>> mx[1];
+    std::cout << "# Type method (dg, nearest, linear, cubic) \n";
+    std::cin >> method;
+    method.erase( std::remove( method.begin(), method.end(), '"'), method.end());
+    std::cout <<"# You typed\n"
+              <<"n:  "<<n<<"\n"
+              <<"Nx: "<<Nx<<"\n"
+              <<"Ny: "<<Ny<<"\n"
+              <<"Nz: "<<Nz<<"\n"
+              <<"mx: "<<mx[0]<<"\n"
+              <<"my: "<<mx[1]<<"\n"
+              <<"method: "<< method<<std::endl;
+
+    const dg::CylindricalGrid3d g3d( R_0-a, R_0+a, -a, a, 0, 2.*M_PI, n, Nx, Ny, Nz, dg::NEU, dg::NEU, dg::PER);
+    const dg::geo::TokamakMagneticField mag = dg::geo::createCircularField( R_0, I_0);
+    auto bhat = dg::geo::createBHat(mag);
+    dg::Timer t;
+    t.tic();
+    dg::geo::Fieldaligned<dg::aProductGeometry3d,dg::IDMatrix,dg::DVec>  dsFA(
+            bhat, g3d, dg::NEU, dg::NEU, dg::geo::NoLimiter(), 1e-8, mx[0], mx[1],
+            -1, method, true, true); // precompute adjoint
+    dg::geo::DS<dg::aProductGeometry3d, dg::IDMatrix, dg::DVec> ds( dsFA );
+    t.toc();
+    std::cout << "# Construction took "<<t.diff()<<"s\n";
+
+    auto ff = dg::geo::TestFunctionDirNeu(mag);
+    const dg::DVec fun = dg::pullback( ff, g3d);
+    dg::DVec result(fun);
+    const unsigned multi = 100;
+    double gbytes = fun.size()*sizeof(double)/1e9;
+
+    std::cout << "# Fieldaligned (time per call)\n";
+    for( auto which : {dg::geo::einsPlus, dg::geo::einsMinus, dg::geo::zeroForw,
+                       dg::geo::einsPlusT, dg::geo::einsMinusT})
+    {
+        dsFA( which, fun, result); // warm up
+        t.tic();
+        for( unsigned i=0; i<multi; i++)
+            dsFA( which, fun, result);
+        t.toc();
+        std::cout << "    whichMatrix "<<(int)which<<": "<<std::setw(12)
+                  <<t.diff()/multi<<"s\t "<<2*gbytes*multi/t.diff()<<"GB/s (vectors only)\n";
+    }
+    std::cout << "# DS (time per call)\n";
+    for( auto name : {"centered", "dss", "directLap"})
+    {
+        callDS( ds, name, fun, result, 1000, 1e-8);
+        t.tic();
+        for( unsigned i=0; i<multi; i++)
+            callDS( ds, name, fun, result, 1000, 1e-8);
+        t.toc();
+        std::cout << "    "<<name<<": "<<std::setw(12-std::string(name).size())
+                  <<" "<<t.diff()/multi<<"s\n";
+    }
+
+    std::cout << "# DS members with cached weights versus freestanding functions\n";
+    dg::DVec fm(fun), fo(fun), fp(fun), free(fun);
+    dsFA( dg::geo::einsMinus, fun, fm);
+    dsFA( dg::geo::zeroForw,  fun, fo);
+    dsFA( dg::geo::einsPlus,  fun, fp);
+    ds.dss( fun, result);
+    dg::geo::dss_centered( dsFA, 1., fm, fo, fp, 0., free);
+    dg::blas1::axpby( 1., result, -1., free);
+    std::cout << "    dss difference:  "<<sqrt( dg::blas1::dot( free, free))<<" (small)\n";
+    ds.dssd( 1., fun, 0., result);
+    dg::geo::dssd_centered( dsFA, 1., fm, fo, fp, 0., free);
+    dg::blas1::axpby( 1., result, -1., free);
+    std::cout << "    dssd difference: "<<sqrt( dg::blas1::dot( free, free))<<" (small)\n";
+
+    std::cout << "# Batched versus plane by plane application of a 2d interpolation matrix\n";
+    dg::ClonePtr<dg::aGeometry2d> g2d = g3d.perp_grid();
+    // interpolate onto rotated points (same sparsity as in Fieldaligned)
+    dg::HVec x = dg::evaluate( dg::cooX2d, *g2d), y = dg::evaluate( dg::cooY2d, *g2d);
+    for( unsigned i=0; i<x.size(); i++)
+    {
+        double xx = x[i]-R_0, yy = y[i];
+        x[i] = R_0 + 0.7*( xx*cos( 0.1) - yy*sin( 0.1));
+        y[i] =       0.7*( xx*sin( 0.1) + yy*cos( 0.1));
+    }
+    dg::IDMatrix interp = dg::create::interpolation( x, y, *g2d, dg::NEU, dg::NEU, method);
+    std::vector<dg::View<const dg::DVec>> f_planes = dg::split( fun, g3d);
+    std::vector<dg::View<dg::DVec>> r_planes = dg::split( result, g3d);
+    t.tic();
+    for( unsigned i=0; i<multi; i++)
+        for( unsigned k=0; k<Nz; k++)
+            dg::blas2::symv( interp, f_planes[k], r_planes[k]);
+    t.toc();
+    std::cout << "    plane by plane: "<<t.diff()/multi<<"s\n";
+    dg::DVec batched( result);
+    t.tic();
+    for( unsigned i=0; i<multi; i++)
+        interp.symm( Nz, 1., fun, 0., batched);
+    t.toc();
+    std::cout << "    batched:        "<<t.diff()/multi<<"s\n";
+    dg::blas1::axpby( 1., result, -1., batched);
+    std::cout << "    difference:     "<<sqrt( dg::blas1::dot( batched, batched))<<" (0)\n";
+    return 0;
+}
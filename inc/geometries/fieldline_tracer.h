@@ -0,0 +1,357 @@
+#pragma once
+
+#include <cmath>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "dg/algorithm.h"
+
+namespace dg{
+namespace geo{
+
+/**
+ * @brief Integrate field lines once and evaluate them at arbitrary angles
+ *
+ * Each field line is integrated from \f$ \varphi = 0\f$ to \f$ \varphi_{\max}
+ * \f$ and to \f$ \varphi_{\min}\f$ with the adaptive "Dormand-Prince-7-4-5"
+ * method (absolute tolerance 1e-10 as in \c Fieldaligned) and all accepted
+ * steps are stored. A query at any angle in between only integrates the
+ * remaining part of the step containing the angle, starting from the
+ * stored step point closer to \f$ \varphi=0\f$, so the result has the
+ * accuracy of a direct integration.
+ *
+ * If \c store_derivatives is set, the first and second derivatives at the
+ * step points are stored as well (the second by a forward difference with
+ * step \f$ \delta = 10^{-8}\f$ along the field line, which costs two
+ * additional evaluations of the right hand side per step). A query is then
+ * answered by quintic Hermite interpolation in the step containing the angle
+ * (dense output) without integrating at all. The interpolation error is \f$
+ * \mathcal O(h^6) + \mathcal O(\delta h^2)\f$ in the step size \f$ h\f$, i.e.
+ * the finite difference limits the accuracy to about \f$ 10^{-8} h^2\f$.
+ *
+ * This way several consumers of the same field lines can share one
+ * integration, e.g. a \c Fieldaligned object and its staggered counterpart
+ * with half the \c deltaPhi, or the wall distance in both directions
+ * (s.a. \c WallFieldlineCoordinate).
+ * @snippet fieldline_tracer_t.cpp doxygen
+ * @note The memory consumption is 4 doubles per accepted step and field line
+ * (10 if derivatives are stored)
+ * @attention Queries re-use an internal integrator, so a tracer must not be
+ * queried from several threads at the same time
+ * @ingroup fieldaligned
+ */
+struct FieldlineTracer
+{
+    ///@brief No field lines; no query is valid
+    FieldlineTracer() = default;
+    /**
+     * @brief Integrate all field lines
+     *
+     * @tparam ODE callable as <tt> ode( double phi, const std::array<double,3>&
+     * y, std::array<double,3>& yp)</tt> e.g. \c detail::DSFieldCylindrical3
+     * (is copied and kept to answer queries)
+     * @param ode The right hand side \f$ dy/d\varphi\f$ of the field line equation
+     * @param y0 the starting points at \f$ \varphi = 0\f$ (all three components
+     * have the same size, the number of field lines)
+     * @param phiMin integrate to this angle in negative direction (<= 0)
+     * @param phiMax integrate to this angle in positive direction (>= 0)
+     * @param eps relative accuracy of the field line integrator
+     * @param store_derivatives If true store the derivatives at the step
+     * points and answer queries by interpolation (s.a. the class description)
+     * @attention If the integrator fails to converge a \c dg::Error is thrown
+     */
+    template<class ODE>
+    FieldlineTracer( ODE&& ode, const std::array<thrust::host_vector<double>,3>& y0,
+        double phiMin, double phiMax, double eps, bool store_derivatives = false)
+    {
+        trace( std::forward<ODE>(ode), y0, phiMin, phiMax, eps,
+                (const dg::aRealTopology2d<double>*)nullptr, store_derivatives);
+    }
+    /**
+     * @brief Integrate all field lines until they leave a domain
+     *
+     * Same as above but the integration in each direction stops at the first
+     * step that ends outside \c domain (or at \c phiMin, \c phiMax)
+     * @copydetails FieldlineTracer(ODE&&,const std::array<thrust::host_vector<double>,3>&,double,double,double,bool)
+     * @param domain The first two components of \c y are tested with \c domain.contains
+     */
+    template<class ODE>
+    FieldlineTracer( ODE&& ode, const std::array<thrust::host_vector<double>,3>& y0,
+        double phiMin, double phiMax, double eps,
+        const dg::aRealTopology2d<double>& domain, bool store_derivatives = false)
+    {
+        trace( std::forward<ODE>(ode), y0, phiMin, phiMax, eps, &domain,
+                store_derivatives);
+    }
+
+    ///@brief The number of field lines
+    unsigned size() const{ return m_zero.size();}
+    ///@brief The total number of stored steps (of all field lines)
+    unsigned num_nodes() const{ return m_phi.size();}
+    ///@brief The relative accuracy given in the constructor
+    double eps() const{ return m_eps;}
+    ///@brief True if queries are answered by interpolation
+    bool stores_derivatives() const{ return !m_yp.empty();}
+    /**
+     * @brief The angles up to which field line \c i was integrated
+     *
+     * @param i field line number
+     * @return \f$ [\varphi_0, \varphi_1] \f$ with \f$ \varphi_0\leq 0\leq\varphi_1\f$
+     * (can be smaller than <tt>[phiMin, phiMax]</tt> if integration stopped
+     * at the domain boundary)
+     */
+    std::array<double,2> range( unsigned i) const{
+        return {m_phi[m_begin[i]], m_phi[m_begin[i+1]-1]};
+    }
+
+    /**
+     * @brief Field line \c i at angle \c phi
+     *
+     * @param i field line number
+     * @param phi must lie in <tt>range(i)</tt>
+     * @return the three components of \c y
+     */
+    std::array<double,3> operator()( unsigned i, double phi) const
+    {
+        std::array<double,2> r = range(i);
+        if( phi < r[0] || phi > r[1])
+            throw dg::Error( dg::Message(_ping_)<<"FieldlineTracer: angle "<<phi
+                <<" is outside of the traced range ["<<r[0]<<", "<<r[1]
+                <<"] of field line "<<i);
+        if( m_begin[i+1] - m_begin[i] == 1) // phi == 0
+            return m_y[m_begin[i]];
+        // first node with m_phi > phi
+        auto it = std::upper_bound( m_phi.begin() + m_begin[i],
+            m_phi.begin() + m_begin[i+1], phi);
+        unsigned k = (it - m_phi.begin()) - 1;
+        k = std::min( k, m_begin[i+1]-2);
+        if( phi == m_phi[k])
+            return m_y[k];
+        if( phi == m_phi[k+1]) // e.g. phi == range(i)[1]
+            return m_y[k+1];
+        if( stores_derivatives())
+            return interpolate( k, phi);
+        return integrate( phi > 0 ? k : k+1, phi);
+    }
+    /**
+     * @brief All field lines at angle \c phi
+     *
+     * @param phi must lie in <tt>range(i)</tt> for all \c i
+     * @param y (resized to \c size())
+     */
+    void evaluate( double phi, std::array<thrust::host_vector<double>,3>& y) const
+    {
+        for( unsigned u=0; u<3; u++)
+            y[u].resize( size());
+        for( unsigned i=0; i<size(); i++)
+        {
+            std::array<double,3> yy = (*this)( i, phi);
+            for( unsigned u=0; u<3; u++)
+                y[u][i] = yy[u];
+        }
+    }
+    /**
+     * @brief Angle at which field line \c i leaves a domain
+     *
+     * Searches the stored steps from \f$ \varphi=0\f$ towards \c phi1 for the
+     * first one that ends outside the domain and then finds the angle
+     * of leave with a bisection algorithm on the queries in that step (the
+     * same stopping criterion as \c dg::AdaptiveTimeloop::integrate_in_domain)
+     * @param i field line number
+     * @param phi1 the maximum angle to search (must lie in <tt>range(i)</tt>)
+     * @param domain the first two components of \c y are tested with \c domain.contains
+     * @param eps_root relative accuracy of the bisection
+     * @return the angle of leave or \c phi1 if the field line does not leave
+     * the domain before \c phi1
+     */
+    double leave( unsigned i, double phi1, const dg::aRealTopology2d<double>& domain,
+        double eps_root) const
+    {
+        // bracket the angle between t0 (inside) and t1 (outside)
+        double t0 = 0, t1 = phi1;
+        bool forward = phi1 > 0;
+        unsigned k = m_zero[i];
+        while( true)
+        {
+            if( forward && (k+1 == m_begin[i+1] || m_phi[k+1] >= phi1))
+                break;
+            if( !forward && (k == m_begin[i] || m_phi[k-1] <= phi1))
+                break;
+            k = forward ? k+1 : k-1;
+            if( !contains( domain, m_y[k]))
+            {
+                t1 = m_phi[k];
+                break;
+            }
+            t0 = m_phi[k];
+        }
+        if( t1 == phi1 && contains( domain, (*this)( i, phi1)))
+            return phi1;
+        for( unsigned j=0; j<50; j++)
+        {
+            if( fabs(t1-t0) < eps_root*fabs(t1) + eps_root)
+                break;
+            double tm = (t0+t1)/2.;
+            if( contains( domain, (*this)( i, tm)))
+                t0 = tm;
+            else
+                t1 = tm;
+        }
+        return t1;
+    }
+
+    private:
+    using Stepper = dg::Adaptive<dg::ERKStep<std::array<double,3>>>;
+    using Field = std::function<void( double, const std::array<double,3>&,
+            std::array<double,3>&)>;
+    static bool contains( const dg::aRealTopology2d<double>& domain,
+        const std::array<double,3>& y)
+    {
+        return domain.contains( std::array<double,2>{y[0], y[1]});
+    }
+    std::array<double,3> interpolate( unsigned k, double phi) const
+    {
+        // quintic Hermite interpolation between node k and k+1
+        double h = m_phi[k+1] - m_phi[k];
+        double t = (phi - m_phi[k])/h, t2 = t*t, t3 = t2*t, t4 = t3*t, t5 = t4*t;
+        double h0 = 1. - 10.*t3 + 15.*t4 - 6.*t5, h1 = 1. - h0;
+        double d0 = h*(t - 6.*t3 + 8.*t4 - 3.*t5), d1 = h*(-4.*t3 + 7.*t4 - 3.*t5);
+        double s0 = h*h*(t2 - 3.*t3 + 3.*t4 - t5)/2., s1 = h*h*(t3 - 2.*t4 + t5)/2.;
+        std::array<double,3> y;
+        for( unsigned u=0; u<3; u++)
+            y[u] = h0*m_y[k][u]   + d0*m_yp[k][u]   + s0*m_ypp[k][u]
+                 + h1*m_y[k+1][u] + d1*m_yp[k+1][u] + s1*m_ypp[k+1][u];
+        return y;
+    }
+    // integrate from node k to phi (at most one stored step)
+    std::array<double,3> integrate( unsigned k, double phi) const
+    {
+        std::array<double,3> y = m_y[k];
+        advance( m_adapt, m_ode, m_phi[k], y, phi, phi - m_phi[k], m_eps,
+            []( double, const std::array<double,3>&){ return true;});
+        return y;
+    }
+    // integrate y from t to phi1 starting with step dt; after every accepted
+    // step call store( t, y) and stop early if it returns false
+    template<class ODE, class Store>
+    static void advance( Stepper& adapt, ODE& ode, double t,
+        std::array<double,3>& y, double phi1, double dt, double eps, Store store)
+    {
+        const double length = fabs( phi1 - t);
+        bool forward = phi1 > t;
+        while( (forward && t < phi1) || (!forward && t > phi1))
+        {
+            bool last = (forward && t+dt >= phi1) || (!forward && t+dt <= phi1);
+            if( last)
+                dt = phi1 - t;
+            adapt.step( ode, t, y, t, y, dt, dg::pid_control, dg::fast_l2norm,
+                    eps, 1e-10);
+            if( !std::isfinite(dt) || fabs(dt) < 1e-9*length)
+                throw dg::Error(dg::Message(_ping_)<<"FieldlineTracer failed to converge! dt = "<<std::scientific<<dt);
+            if( adapt.failed())
+                continue;
+            if( last) // avoid round-off in t0 + (phi1 - t0)
+                t = phi1;
+            if( !store( t, y))
+                break;
+        }
+    }
+    // store a node and if derivatives are stored its first and second derivative
+    void push_back( double t, const std::array<double,3>& y,
+        std::vector<double>& phi, std::vector<std::array<double,3>>& ys,
+        std::vector<std::array<double,3>>& yps,
+        std::vector<std::array<double,3>>& ypps, bool store_derivatives) const
+    {
+        phi.push_back( t);
+        ys.push_back( y);
+        if( !store_derivatives)
+            return;
+        // forward difference along the field line y'' = (f(t+d,y+d f)-f(t,y))/d
+        const double delta = 1e-8;
+        std::array<double,3> yp, yd, ypd, ypp;
+        m_ode( t, y, yp);
+        for( unsigned u=0; u<3; u++)
+            yd[u] = y[u] + delta*yp[u];
+        m_ode( t+delta, yd, ypd);
+        for( unsigned u=0; u<3; u++)
+            ypp[u] = (ypd[u] - yp[u])/delta;
+        yps.push_back( yp);
+        ypps.push_back( ypp);
+    }
+    template<class ODE>
+    void trace( ODE&& ode, const std::array<thrust::host_vector<double>,3>& y0,
+        double phiMin, double phiMax, double eps,
+        const dg::aRealTopology2d<double>* domain, bool store_derivatives)
+    {
+        if( phiMin > 0 || phiMax < 0)
+            throw dg::Error( dg::Message(_ping_)<<"FieldlineTracer: phiMin "
+                <<phiMin<<" must be <= 0 and phiMax "<<phiMax<<" >= 0");
+        m_ode = std::forward<ODE>(ode);
+        m_eps = eps;
+        m_adapt = Stepper( "Dormand-Prince-7-4-5", std::array<double,3>{0,0,0});
+        unsigned size = y0[0].size();
+        m_begin.resize( size+1);
+        m_zero.resize( size);
+        m_begin[0] = 0;
+        std::vector<double> phiM, phiP;
+        std::vector<std::array<double,3>> yM, yP, ypM, ypP, yppM, yppP;
+        for( unsigned i=0; i<size; i++)
+        {
+            std::array<double,3> y{y0[0][i], y0[1][i], y0[2][i]};
+            trace_line( y, phiMin, domain, phiM, yM, ypM, yppM, store_derivatives);
+            trace_line( y, phiMax, domain, phiP, yP, ypP, yppP, store_derivatives);
+            // append minus direction in reverse order, then phi=0, then plus
+            for( int k=(int)phiM.size()-1; k>=0; k--)
+            {
+                m_phi.push_back( phiM[k]);
+                m_y.push_back( yM[k]);
+                if( store_derivatives)
+                {
+                    m_yp.push_back( ypM[k]);
+                    m_ypp.push_back( yppM[k]);
+                }
+            }
+            m_zero[i] = m_phi.size();
+            push_back( 0., y, m_phi, m_y, m_yp, m_ypp, store_derivatives);
+            for( unsigned k=0; k<phiP.size(); k++)
+            {
+                m_phi.push_back( phiP[k]);
+                m_y.push_back( yP[k]);
+                if( store_derivatives)
+                {
+                    m_yp.push_back( ypP[k]);
+                    m_ypp.push_back( yppP[k]);
+                }
+            }
+            m_begin[i+1] = m_phi.size();
+        }
+    }
+    // store all accepted steps from 0 to phi1 (excluding 0)
+    void trace_line( std::array<double,3> y, double phi1,
+        const dg::aRealTopology2d<double>* domain, std::vector<double>& phi,
+        std::vector<std::array<double,3>>& ys,
+        std::vector<std::array<double,3>>& yps,
+        std::vector<std::array<double,3>>& ypps, bool store_derivatives)
+    {
+        phi.clear(), ys.clear(), yps.clear(), ypps.clear();
+        if( phi1 == 0)
+            return;
+        advance( m_adapt, m_ode, 0., y, phi1, phi1/2., m_eps, // dt as in Fieldaligned
+            [&]( double t, const std::array<double,3>& yt){
+                push_back( t, yt, phi, ys, yps, ypps, store_derivatives);
+                return domain == nullptr || contains( *domain, yt);
+            });
+    }
+    Field m_ode;
+    mutable Stepper m_adapt;
+    std::vector<double> m_phi; // all nodes of all field lines
+    std::vector<std::array<double,3>> m_y, m_yp, m_ypp;
+    std::vector<unsigned> m_begin; // nodes of line i are [m_begin[i], m_begin[i+1])
+    std::vector<unsigned> m_zero; // node of line i at phi = 0
+    double m_eps = 1e-5;
+};
+
+}//namespace geo
+}//namespace dg
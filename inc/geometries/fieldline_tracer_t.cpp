@@ -0,0 +1,120 @@
+#include <iostream>
+#include <iomanip>
+#include <cassert>
+
+#include "dg/algorithm.h"
+#include "magnetic_field.h"
+#include "testfunctors.h"
+#include "fieldaligned.h"
+#include "toroidal.h"
+
+// Compare the queries of FieldlineTracer to direct field line integration
+
+const double R_0 = 10;
+const double I_0 = 20; //q factor at r=1 is I_0/R_0
+const double a  = 1; //small radius
+
+int main()
+{
+    std::cout << "# Test FieldlineTracer for circular flux surfaces\n";
+    const dg::geo::TokamakMagneticField mag = dg::geo::createCircularField( R_0, I_0);
+    const dg::geo::CylindricalVectorLvl1 bhat = dg::geo::createBHat(mag);
+    const dg::CylindricalGrid3d g3d( R_0-a, R_0+a, -a, a, 0, 2.*M_PI, 3, 10, 10, 20,
+            dg::NEU, dg::NEU, dg::PER);
+    const double eps = 1e-8, deltaPhi = g3d.hz();
+    dg::geo::detail::DSFieldCylindrical4 field( bhat);
+    std::array<dg::HVec,3> y0{ dg::HVec{R_0+0.4, R_0-0.2, R_0+0.1},
+        dg::HVec{0.4, 0.45, -0.45}, dg::HVec{1., 1., 1.}};
+    //![doxygen]
+    // integrate once in [-2 deltaPhi, 2 deltaPhi]
+    dg::geo::FieldlineTracer tracer( field, y0, -2.*deltaPhi, 2.*deltaPhi, eps);
+    // ... and evaluate at any angle in between
+    std::array<dg::HVec,3> yp;
+    tracer.evaluate( deltaPhi/2., yp);
+    //![doxygen]
+    std::cout << "Stored "<<tracer.num_nodes()<<" steps for "<<tracer.size()<<" field lines\n";
+    dg::Adaptive<dg::ERKStep<std::array<double,3>>> adapt(
+            "Dormand-Prince-7-4-5", std::array<double,3>{0,0,0});
+    dg::AdaptiveTimeloop<std::array<double,3>> odeint( adapt, field,
+            dg::pid_control, dg::fast_l2norm, eps, 1e-10);
+    // with stored derivatives the queries are interpolated
+    dg::geo::FieldlineTracer dense( field, y0, -2.*deltaPhi, 2.*deltaPhi, eps,
+            true);
+    assert( !tracer.stores_derivatives() && dense.stores_derivatives());
+    for( auto tr : { &tracer, &dense})
+    {
+        std::cout << "Difference to direct integration "
+                  <<(tr->stores_derivatives() ? "(interpolated)" : "(integrated)")<<"\n";
+        for( double phi : { 2.*deltaPhi, deltaPhi, deltaPhi/2., -deltaPhi/3., -2.*deltaPhi})
+        {
+            tr->evaluate( phi, yp);
+            double err = 0;
+            for( unsigned i=0; i<tr->size(); i++)
+            {
+                std::array<double,3> coords{y0[0][i], y0[1][i], y0[2][i]}, coordsP;
+                odeint.set_dt( phi/2.);
+                odeint.integrate( 0., coords, phi, coordsP);
+                for( unsigned u=0; u<3; u++)
+                    err = std::max( err, fabs( coordsP[u]-yp[u][i]));
+            }
+            std::cout << "    phi "<<std::setw(10)<<phi<<": "<<err<<"\n";
+            assert( err < 1e-6);
+        }
+    }
+    std::cout << "Angle of leave (box with half the minor radius)\n";
+    const dg::Grid2d box( R_0-0.5*a, R_0+0.5*a, -0.5*a, 0.5*a, 1, 1, 1);
+    dg::geo::FieldlineTracer wall( field, y0, -4.*M_PI, 4.*M_PI, eps, box);
+    for( double maxPhi : { 4.*M_PI, -4.*M_PI})
+    {
+        double err = 0;
+        for( unsigned i=0; i<wall.size(); i++)
+        {
+            std::array<double,3> coords{y0[0][i], y0[1][i], y0[2][i]}, coordsP;
+            double phi1 = maxPhi;
+            odeint.integrate_in_domain( 0., coords, phi1, coordsP, 0., box, eps);
+            double phi2 = wall.leave( i, maxPhi, box, eps);
+            err = std::max( err, fabs( phi1-phi2)/fabs(phi1));
+        }
+        std::cout << "    maxPhi "<<std::setw(8)<<maxPhi<<": "<<err<<"\n";
+        assert( err < 1e-6);
+    }
+
+    std::cout << "Fieldaligned from shared tracer versus direct construction\n";
+    dg::geo::FieldlineTracer shared = dg::geo::trace_fieldlines( bhat, g3d,
+            deltaPhi, eps);
+    const dg::HVec fun = dg::pullback( dg::geo::TestFunctionPsi2(mag,a), g3d);
+    dg::HVec direct( fun), traced( fun);
+    for( double dPhi : { deltaPhi, deltaPhi/2.})
+    {
+        dg::geo::Fieldaligned<dg::aProductGeometry3d, dg::IHMatrix, dg::HVec>
+            fa( bhat, g3d, dg::NEU, dg::NEU, dg::geo::NoLimiter(), eps, 12,
+                    12, dPhi, "dg", false);
+        dg::geo::Fieldaligned<dg::aProductGeometry3d, dg::IHMatrix, dg::HVec>
+            faT( shared, bhat, g3d, dg::NEU, dg::NEU, dg::geo::NoLimiter(),
+                    12, 12, dPhi, "dg", false);
+        fa(  dg::geo::einsPlus, fun, direct);
+        faT( dg::geo::einsPlus, fun, traced);
+        dg::blas1::axpby( 1., direct, -1., traced);
+        double err = sqrt( dg::blas1::dot( traced, traced)/ dg::blas1::dot(
+                    direct, direct));
+        std::cout << "    deltaPhi "<<std::setw(8)<<dPhi<<": "<<err<<"\n";
+        assert( err < 1e-6);
+    }
+    bool thrown = false;
+    try{
+        dg::geo::Fieldaligned<dg::aProductGeometry3d, dg::IHMatrix, dg::HVec>
+            faT( shared, bhat, g3d, dg::NEU, dg::NEU, dg::geo::NoLimiter(),
+                    12, 12, 2.*deltaPhi, "dg", false);
+    }catch( dg::Error& e)
+    {
+        thrown = true;
+    }
+    if( !thrown)
+    {
+        std::cerr << "Too large deltaPhi does not throw (FAILED)\n";
+        return 1;
+    }
+    std::cout << "Too large deltaPhi throws (correct)\n";
+    std::cout << "PASSED\n";
+    return 0;
+}
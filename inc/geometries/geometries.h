@@ -32,6 +32,7 @@
 
 #include "fluxfunctions.h"
 #include "magnetic_field.h"
+#include "tabulated.h"
 #include "adaption.h"
 #include "sheath.h"
 
@@ -28,22 +28,39 @@ struct Interpolate
         iter0_( dg::forward_transform( fZeta, g2d) ),
         iter1_( dg::forward_transform(  fEta, g2d) ),
         g_(g2d), zeta1_(g2d.x1()), eta1_(g2d.y1()){}
-    void operator()(real_type t, const std::array<real_type,2>& zeta, std::array<real_type,2>& fZeta)
+    void operator()(real_type t, const std::array<real_type,2>& zeta, std::array<real_type,2>& fZeta) const
     {
-        fZeta[0] = interpolate( dg::lspace, iter0_, fmod( zeta[0]+zeta1_, zeta1_), fmod( zeta[1]+eta1_, eta1_), g_);
-        fZeta[1] = interpolate( dg::lspace, iter1_, fmod( zeta[0]+zeta1_, zeta1_), fmod( zeta[1]+eta1_, eta1_), g_);
-        //fZeta[0] = interpolate(  zeta[0], zeta[1], iter0_, g_);
-        //fZeta[1] = interpolate(  zeta[0], zeta[1], iter1_, g_);
+        interpolate( zeta[0], zeta[1], fZeta[0], fZeta[1]);
     }
-    void operator()(real_type t, const std::array<thrust::host_vector<real_type>,2 >& zeta, std::array< thrust::host_vector<real_type>,2 >& fZeta)
+    void operator()(real_type t, const std::array<thrust::host_vector<real_type>,2 >& zeta, std::array< thrust::host_vector<real_type>,2 >& fZeta) const
     {
-        for( unsigned i=0; i<zeta[0].size(); i++)
-        {
-            fZeta[0][i] = interpolate( dg::lspace, iter0_, fmod( zeta[0][i]+zeta1_, zeta1_), fmod( zeta[1][i]+eta1_, eta1_), g_);
-            fZeta[1][i] = interpolate( dg::lspace, iter1_, fmod( zeta[0][i]+zeta1_, zeta1_), fmod( zeta[1][i]+eta1_, eta1_), g_);
-        }
+        const int size = zeta[0].size();
+        // the streamlines are independent of each other
+#ifdef _OPENMP
+        #pragma omp parallel for if( !omp_in_parallel() && size > dg::blas1::detail::MIN_SIZE)
+#endif //_OPENMP
+        for( int i=0; i<size; i++)
+            interpolate( zeta[0][i], zeta[1][i], fZeta[0][i], fZeta[1][i]);
     }
     private:
+    // same as dg::interpolate but both components share the weights
+    void interpolate( real_type zeta, real_type eta, real_type& fZeta, real_type& fEta) const
+    {
+        thrust::host_vector<real_type> valsx, valsy;
+        thrust::host_vector<int> colsx, colsy;
+        dg::create::detail::interpolation_row( dg::lspace, fmod( zeta+zeta1_,
+                    zeta1_), g_.gx(), dg::NEU, colsx, valsx);
+        dg::create::detail::interpolation_row( dg::lspace, fmod( eta+eta1_,
+                    eta1_), g_.gy(), dg::NEU, colsy, valsy);
+        fZeta = fEta = 0;
+        for( unsigned i=0; i<valsy.size(); i++)
+            for( unsigned j=0; j<valsx.size(); j++)
+            {
+                unsigned idx = colsy[i]*g_.shape(0) + colsx[j];
+                fZeta += iter0_[idx]*valsx[j]*valsy[i];
+                fEta  += iter1_[idx]*valsx[j]*valsy[i];
+            }
+    }
     thrust::host_vector<real_type> iter0_;
     thrust::host_vector<real_type> iter1_;
     dg::RealGrid2d<real_type> g_;
@@ -187,16 +204,12 @@ template< class Geometry, class container>
 void transform(
         const container& u_zeta,
         const container& u_eta,
-        thrust::host_vector<double>& u_x,
-        thrust::host_vector<double>& u_y,
+        container& u_x,
+        container& u_y,
         const Geometry& g2d)
 {
-    u_x.resize( u_zeta.size()), u_y.resize( u_zeta.size());
-    thrust::host_vector<double> uh_zeta, uh_eta;
-    dg::assign( u_zeta, uh_zeta);
-    dg::assign( u_eta, uh_eta);
-    dg::SparseTensor<thrust::host_vector<double> > jac = g2d.jacobian();
-    dg::tensor::multiply2d( jac.transpose(), uh_zeta, uh_eta, u_x, u_y);
+    dg::SparseTensor<container> jac( g2d.jacobian());
+    dg::tensor::multiply2d( jac.transpose(), u_zeta, u_eta, u_x, u_y);
 }
 
 }//namespace detail
@@ -211,6 +224,10 @@ void transform(
  * grid generation Journal of Computational Physics 340, 435-450 (2017) </a>
  *
  * @snippet flux_t.cpp hector
+ * @note The elliptic equations are solved with \c dg::MultigridCG2d and the
+ * grid is interpolated with \c IMatrix, so e.g. <tt>Hector<dg::IDMatrix,
+ * dg::DMatrix, dg::DVec></tt> constructs on the device; the streamline
+ * integration is done on the host (in parallel if compiled with OpenMP)
  * @ingroup generators_geo
  * @tparam IMatrix The interpolation matrix type
  * @copydoc hide_matrix
@@ -349,14 +366,15 @@ struct Hector : public aGenerator2d
         //the box is periodic in eta and the y=0 line needs not to coincide with the eta=0 line
         for( unsigned i=0; i<eta.size(); i++)
             eta[i] = fmod(eta[i]+2.*M_PI, 2.*M_PI);
-        dg::IHMatrix Q = dg::create::interpolation( zeta, eta, m_g2d);
-
-        dg::blas2::symv( Q, m_g2d.map()[0], x);
-        dg::blas2::symv( Q, m_g2d.map()[1], y);
-        dg::blas2::symv( Q, m_ux, ux);
-        dg::blas2::symv( Q, m_uy, uy);
-        dg::blas2::symv( Q, m_vx, vx);
-        dg::blas2::symv( Q, m_vy, vy);
+        const IMatrix Q = dg::create::interpolation( zeta, eta, m_g2d);
+        container result = dg::construct<container>( zeta);
+        std::array<const container*, 6> in{ &m_x, &m_y, &m_ux, &m_uy, &m_vx, &m_vy};
+        std::array<thrust::host_vector<double>*, 6> out{ &x, &y, &ux, &uy, &vx, &vy};
+        for( unsigned k=0; k<6; k++)
+        {
+            dg::blas2::symv( Q, *in[k], result);
+            dg::assign( result, *out[k]);
+        }
         ////Test if u1d is u
         //thrust::host_vector<double> u(u1d.size()*v1d.size());
         //dg::blas2::symv( Q, m_u, u);
@@ -370,18 +388,34 @@ struct Hector : public aGenerator2d
     }
 
     container construct_grid_and_u( const CylindricalFunctor& chi, const CylindricalFunctor& lapChiPsi, double psi0, double psi1, double X0, double Y0, double eps_u , bool verbose)
+    {
+        return construct_grid_and_u( [&]( auto& elliptic, const dg::geo::CurvilinearGrid2d& g2d)
+            {
+                const container adapt = dg::pullback( chi, g2d);
+                elliptic.set_chi( adapt);
+            }, lapChiPsi, eps_u, verbose);
+    }
+
+    container construct_grid_and_u( const CylindricalFunctorsLvl2& psi,
+            const CylindricalSymmTensorLvl1& chi, double psi0, double psi1, double X0, double Y0, double eps_u, bool verbose )
+    {
+        return construct_grid_and_u( [&]( auto& elliptic, const dg::geo::CurvilinearGrid2d& g2d)
+            {
+                dg::SparseTensor<container> chi_t;
+                dg::pushForwardPerp( chi.xx(), chi.xy(), chi.yy(), chi_t, g2d);
+                elliptic.set_chi( chi_t);
+            }, dg::geo::detail::LaplaceChiPsi( psi, chi), eps_u, verbose);
+    }
+
+    // refine m_g2d until u converges
+    template<class SetChi>
+    container construct_grid_and_u( SetChi set_chi, const CylindricalFunctor& lapChiPsi, double eps_u, bool verbose)
     {
         //first find u( \zeta, \eta)
         double eps = 1e10, eps_old = 2e10;
         dg::geo::CurvilinearGrid2d g2d_old = m_g2d;
-        container adapt = dg::pullback(chi, g2d_old);
-        dg::Elliptic2d<dg::geo::CurvilinearGrid2d, Matrix, container> ellipticD_old( g2d_old, dg::DIR, dg::PER, dg::centered);
-        ellipticD_old.set_chi( adapt);
-
         container u_old = dg::evaluate( dg::zero, g2d_old), u(u_old);
-        dg::PCG<container > invert_old( u_old, g2d_old.size());
-        container lapu = dg::pullback( lapChiPsi, g2d_old);
-        unsigned number = invert_old.solve( ellipticD_old, u_old, lapu, ellipticD_old.precond(), ellipticD_old.weights(), eps_u);
+        unsigned number = solve_u( set_chi, lapChiPsi, u_old, eps_u, verbose);
         if(verbose) std::cout << "Nx "<<m_g2d.Nx()<<" Ny "<<m_g2d.Ny()<<std::flush;
         if(verbose) std::cout <<" iter "<<number<<" error "<<eps<<"\n";
         while( (eps < eps_old||eps > 1e-7) && eps > eps_u)
@@ -389,71 +423,42 @@ struct Hector : public aGenerator2d
             eps = eps_old;
             m_g2d.multiplyCellNumbers(2,2);
             if(verbose) std::cout << "Nx "<<m_g2d.Nx()<<" Ny "<<m_g2d.Ny()<<std::flush;
-            dg::Elliptic2d<dg::geo::CurvilinearGrid2d, Matrix, container> ellipticD( m_g2d, dg::DIR, dg::PER, dg::centered);
-            adapt = dg::pullback(chi, m_g2d);
-            ellipticD.set_chi( adapt);
             const container vol2d = dg::create::weights( m_g2d);
             const IMatrix Q = dg::create::interpolation( m_g2d, g2d_old);
             container u_diff = dg::evaluate( dg::zero, m_g2d);
             dg::blas2::gemv( Q, u_old, u_diff);
             u = u_diff;
 
-            dg::PCG<container > invert( u_diff, m_g2d.size());
-            lapu = dg::pullback( lapChiPsi, m_g2d);
-            number = invert.solve( ellipticD, u, lapu, ellipticD.precond(), ellipticD.weights(), 0.1*eps_u);
+            number = solve_u( set_chi, lapChiPsi, u, 0.1*eps_u, verbose);
             dg::blas1::axpby( 1. ,u, -1., u_diff);
             eps = sqrt( dg::blas2::dot( u_diff, vol2d, u_diff) / dg::blas2::dot( u, vol2d, u) );
             if(verbose) std::cout <<" iter "<<number<<" error "<<eps<<"\n";
             g2d_old = m_g2d;
             u_old = u;
-            number++;//get rid of warning
         }
         return u;
     }
 
-    container construct_grid_and_u( const CylindricalFunctorsLvl2& psi,
-            const CylindricalSymmTensorLvl1& chi, double psi0, double psi1, double X0, double Y0, double eps_u, bool verbose )
+    // solve the elliptic equation for u on m_g2d with nested iterations
+    // (on as many as three grids)
+    template<class SetChi>
+    unsigned solve_u( SetChi set_chi, const CylindricalFunctor& lapChiPsi, container& u, double eps, bool verbose)
     {
-        dg::geo::detail::LaplaceChiPsi lapChiPsi( psi, chi);
-        //first find u( \zeta, \eta)
-        double eps = 1e10, eps_old = 2e10;
-        dg::geo::CurvilinearGrid2d g2d_old = m_g2d;
-        dg::Elliptic2d<dg::geo::CurvilinearGrid2d, Matrix, container> ellipticD_old( g2d_old, dg::DIR, dg::PER, dg::centered);
-        dg::SparseTensor<container> chi_t;
-        dg::pushForwardPerp( chi.xx(), chi.xy(), chi.yy(), chi_t, g2d_old);
-
-        ellipticD_old.set_chi( chi_t);
-
-        container u_old = dg::evaluate( dg::zero, g2d_old), u(u_old);
-        dg::PCG<container > invert_old( u_old, g2d_old.size());
-        container lapu = dg::pullback( lapChiPsi, g2d_old);
-        unsigned number = invert_old.solve( ellipticD_old, u_old, lapu, ellipticD_old.precond(), ellipticD_old.weights(), eps_u);
-        while( (eps < eps_old||eps > 1e-7) && eps > eps_u)
+        unsigned stages = 1;
+        while( stages < 3 && m_g2d.Nx()%(1u<<stages) == 0 && m_g2d.Ny()%(1u<<stages) == 0)
+            stages++;
+        dg::MultigridCG2d<dg::geo::CurvilinearGrid2d, Matrix, container>
+            multigrid( m_g2d, stages);
+        multigrid.set_benchmark( verbose);
+        std::vector<dg::Elliptic2d<dg::geo::CurvilinearGrid2d, Matrix, container>>
+            multi_elliptic( stages);
+        for( unsigned k=0; k<stages; k++)
         {
-            eps = eps_old;
-            m_g2d.multiplyCellNumbers(2,2);
-            if(verbose) std::cout << "Nx "<<m_g2d.Nx()<<" Ny "<<m_g2d.Ny()<<std::flush;
-            dg::Elliptic2d<dg::geo::CurvilinearGrid2d, Matrix, container> ellipticD( m_g2d, dg::DIR, dg::PER, dg::centered);
-            dg::pushForwardPerp( chi.xx(), chi.xy(), chi.yy(), chi_t, m_g2d);
-
-            ellipticD.set_chi( chi_t );
-            const container vol2d = dg::create::weights( m_g2d);
-            const IMatrix Q = dg::create::interpolation( m_g2d, g2d_old);
-            container u_diff = dg::evaluate( dg::zero, m_g2d);
-            dg::blas2::gemv( Q, u_old, u_diff);
-            u = u_diff;
-
-            dg::PCG<container > invert( u_diff, m_g2d.size());
-            lapu = dg::pullback( lapChiPsi, m_g2d);
-            number = invert.solve( ellipticD, u, lapu, ellipticD.precond(), ellipticD.weights(), 0.1*eps_u);
-            dg::blas1::axpby( 1. ,u, -1., u_diff);
-            eps = sqrt( dg::blas2::dot( u_diff, vol2d, u_diff) / dg::blas2::dot( u, vol2d, u) );
-            if(verbose) std::cout <<" iter "<<number<<" error "<<eps<<"\n";
-            g2d_old = m_g2d;
-            u_old = u;
-            number++;//get rid of warning
+            multi_elliptic[k].construct( multigrid.grid(k), dg::DIR, dg::PER, dg::centered);
+            set_chi( multi_elliptic[k], multigrid.grid(k));
         }
-        return u;
+        const container lapu = dg::pullback( lapChiPsi, m_g2d);
+        return multigrid.solve( multi_elliptic, u, lapu, eps)[0];
     }
 
     void construct(const container& u, double psi0, double psi1, const CylindricalFunctor& chi_XX, const CylindricalFunctor& chi_XY, const CylindricalFunctor& chi_YY, bool verbose)
@@ -506,9 +511,12 @@ struct Hector : public aGenerator2d
         dg::blas1::scal( v_zeta, m_c0);
         dg::blas1::scal(  u_eta, m_c0);
         dg::blas1::scal(  v_eta, m_c0);
-        //transfer to host
+        m_ux = m_uy = m_vx = m_vy = u;
         detail::transform( u_zeta, u_eta, m_ux, m_uy, m_g2d);
         detail::transform( v_zeta, v_eta, m_vx, m_vy, m_g2d);
+        dg::assign( m_g2d.map()[0], m_x);
+        dg::assign( m_g2d.map()[1], m_y);
+        //transfer to host for the streamline integration
         dg::assign( etaV, m_etaV);
         dg::assign( etaU, m_etaU);
         dg::assign( zetaU, m_zetaU);
@@ -516,7 +524,7 @@ struct Hector : public aGenerator2d
     private:
     bool m_conformal, m_orthogonal;
     double m_c0, m_lu;
-    thrust::host_vector<double> m_ux, m_uy, m_vx, m_vy;
+    container m_x, m_y, m_ux, m_uy, m_vx, m_vy;
     thrust::host_vector<double> m_etaV, m_zetaU, m_etaU;
     dg::geo::CurvilinearGrid2d m_g2d;
 
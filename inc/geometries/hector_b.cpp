@@ -0,0 +1,70 @@
+#include <iostream>
+#include <iomanip>
+
+#include "dg/algorithm.h"
+#include "dg/file/json_utilities.h"
+
+#include "curvilinear.h"
+#include "hector.h"
+#include "solovev.h"
+
+// Benchmark the construction of the conformal Hector generator and of the
+// grids it generates for increasing resolution
+
+int main(int argc, char**argv)
+{
+    std::cout << "# Type nHector, NxHector, NyHector (13 2 10)\n";
+    unsigned nGrid, NxGrid, NyGrid;
+    std::cin >> nGrid>> NxGrid>>NyGrid;
+    std::cout << "# Type n, Nx, Ny of the coarsest generated grid (3 8 40)\n";
+    unsigned n, Nx, Ny;
+    std::cin >> n>> Nx>>Ny;
+    std::cout << "# Type psi_0 and psi_1 (-20 -4)\n";
+    double psi_0, psi_1;
+    std::cin >> psi_0>> psi_1;
+    auto js = dg::file::file2Json( argc == 1 ? "geometry_params.json" : argv[1]);
+    dg::geo::solovev::Parameters gp(js);
+    dg::geo::TokamakMagneticField c = dg::geo::createSolovevField( gp);
+    std::cout <<"# You typed\n"
+              <<"nHector:  "<<nGrid<<"\n"
+              <<"NxHector: "<<NxGrid<<"\n"
+              <<"NyHector: "<<NyGrid<<"\n"
+              <<"n:  "<<n<<"\n"
+              <<"Nx: "<<Nx<<"\n"
+              <<"Ny: "<<Ny<<"\n"
+              <<"psi_0: "<<psi_0<<"\n"
+              <<"psi_1: "<<psi_1<<std::endl;
+
+    dg::Timer t;
+    std::cout << "# Construction of Hector (time vs resolution)\n";
+    std::cout << "# n\tNx\tNy\ttime (s)\n";
+    // the generated grids below use the coarsest Hector
+    dg::ClonePtr<dg::geo::aGenerator2d> hector;
+    for( unsigned i=0; i<4; i++)
+    {
+        t.tic();
+        dg::geo::Hector<dg::IDMatrix, dg::DMatrix, dg::DVec> hectorN(
+                c.get_psip(), psi_0, psi_1, gp.R_0, 0., nGrid, NxGrid,
+                NyGrid, 1e-10, false);
+        t.toc();
+        const dg::geo::CurvilinearGrid2d& internal = hectorN.internal_grid();
+        std::cout << internal.n()<<"\t"<<internal.Nx()<<"\t"<<internal.Ny()
+                  <<"\t"<<t.diff()<<"\n";
+        if( i == 0)
+            hector = hectorN;
+        NxGrid*=2; NyGrid*=2;
+    }
+
+    std::cout << "# Grid generation (time vs resolution)\n";
+    std::cout << "# n\tNx\tNy\tsize\ttime (s)\n";
+    for( unsigned i=0; i<4; i++)
+    {
+        t.tic();
+        dg::geo::CurvilinearGrid2d g2d( *hector, n, Nx, Ny);
+        t.toc();
+        std::cout << n<<"\t"<<Nx<<"\t"<<Ny<<"\t"<<g2d.size()<<"\t"
+                  <<t.diff()<<"\n";
+        Nx*=2; Ny*=2;
+    }
+    return 0;
+}
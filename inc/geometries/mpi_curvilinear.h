@@ -137,10 +137,8 @@ struct RealCurvilinearProductMPIGrid3d : public dg::aRealProductMPIGeometry3d<re
                 {tx.N, ty.N, gz.N()},{ tx.b, ty.b, gz.bcx()},
                 dg::mpi_cart_split_as<3>(comm)), m_handle(generator)
     {
-        m_map.resize(3);
         RealCurvilinearMPIGrid2d<real_type> g(generator,tx,ty,this->get_perp_comm());
         constructPerp( g);
-        constructParallel(this->nz(), this->local().Nz());
     }
 
 
@@ -171,7 +169,6 @@ struct RealCurvilinearProductMPIGrid3d : public dg::aRealProductMPIGeometry3d<re
                     this->get_perp_comm());
             constructPerp( g);
         }
-        constructParallel(this->nz(), this->local().Nz());
     }
     virtual void do_set(std::array<dg::bc,3> new_bc) override final
     {
@@ -186,40 +183,37 @@ struct RealCurvilinearProductMPIGrid3d : public dg::aRealProductMPIGeometry3d<re
         m_jac=g2d.jacobian();
         m_map=g2d.map();
     }
-    void constructParallel( unsigned nz, unsigned localNz )
+    //copy local 2d plane to all local planes
+    MPI_Vector<thrust::host_vector<real_type>> lift( const MPI_Vector<thrust::host_vector<real_type>>& in2d) const
     {
-        m_map.resize(3);
-        m_map[2]=dg::evaluate(dg::cooZ3d, *this);
-        unsigned size = this->local().size();
-        unsigned size2d = this->nx()*this->ny()*this->local().Nx()*this->local().Ny();
-        //resize for 3d values
-        MPI_Comm comm = this->communicator();
-        for( unsigned r=0; r<6;r++)
-        {
-            m_jac.values()[r].data().resize(size);
-            m_jac.values()[r].set_communicator( comm);
-        }
-        m_map[0].data().resize(size);
-        m_map[0].set_communicator( comm);
-        m_map[1].data().resize(size);
-        m_map[1].set_communicator( comm);
-        //lift to 3D grid
-        for( unsigned k=1; k<nz*localNz; k++)
+        unsigned size2d = in2d.data().size();
+        thrust::host_vector<real_type> out( this->local().size());
+        for( unsigned k=0; k<this->nz()*this->local().Nz(); k++)
             for( unsigned i=0; i<size2d; i++)
-            {
-                for(unsigned r=0; r<6; r++)
-                    m_jac.values()[r].data()[k*size2d+i] = m_jac.values()[r].data()[(k-1)*size2d+i];
-                m_map[0].data()[k*size2d+i] = m_map[0].data()[(k-1)*size2d+i];
-                m_map[1].data()[k*size2d+i] = m_map[1].data()[(k-1)*size2d+i];
-            }
+                out[k*size2d+i] = in2d.data()[i];
+        return MPI_Vector<thrust::host_vector<real_type>>( out, this->communicator());
     }
     virtual SparseTensor<MPI_Vector<thrust::host_vector<real_type>>> do_compute_jacobian( ) const override final{
-        return m_jac;
+        SparseTensor<MPI_Vector<thrust::host_vector<real_type>>> jac = m_jac;
+        for( unsigned i=0; i<jac.values().size(); i++)
+            jac.values()[i] = lift( jac.values()[i]);
+        return jac;
     }
     virtual SparseTensor<MPI_Vector<thrust::host_vector<real_type>>> do_compute_metric( ) const override final{
+        SparseTensor<MPI_Vector<thrust::host_vector<real_type>>> metric = do_compute_plane_metric();
+        for( unsigned i=0; i<metric.values().size(); i++)
+            metric.values()[i] = lift( metric.values()[i]);
+        return metric;
+    }
+    virtual SparseTensor<MPI_Vector<thrust::host_vector<real_type>>> do_compute_plane_metric( ) const override final{
         return detail::square( m_jac, m_map[0], m_handle->isOrthogonal());
     }
-    virtual std::vector<MPI_Vector<thrust::host_vector<real_type>>> do_compute_map()const override final{return m_map;}
+    virtual std::vector<MPI_Vector<thrust::host_vector<real_type>>> do_compute_map()const override final{
+        std::vector<MPI_Vector<thrust::host_vector<real_type>>> map{
+            lift( m_map[0]), lift( m_map[1]), dg::evaluate(dg::cooZ3d, *this)};
+        return map;
+    }
+    // only the local 2d plane is stored, the 3d values are lifted on demand
     dg::SparseTensor<MPI_Vector<thrust::host_vector<real_type>>> m_jac;
     std::vector<MPI_Vector<thrust::host_vector<real_type>>> m_map;
     ClonePtr<dg::geo::aRealGenerator2d<real_type>> m_handle;
@@ -8,6 +8,97 @@ namespace dg{
 namespace geo{
 
 ///@cond
+namespace detail{
+// All processes in the z-communicator hold the same perpendicular points
+// Process r of the z-communicator works on the points [begin, end) of its chunk
+inline std::array<unsigned,2> z_chunk( unsigned size, MPI_Comm comm_z)
+{
+    int rank, num_ranks;
+    MPI_Comm_rank( comm_z, &rank);
+    MPI_Comm_size( comm_z, &num_ranks);
+    return { (unsigned)((size_t)rank*size/num_ranks),
+             (unsigned)((size_t)(rank+1)*size/num_ranks)};
+}
+// in consists of num_blocks blocks of the local chunk of size points each
+// out has num_blocks blocks of all size points gathered from all chunks
+inline void z_allgather( unsigned size, unsigned num_blocks,
+    const thrust::host_vector<double>& in, thrust::host_vector<double>& out,
+    MPI_Comm comm_z)
+{
+    int num_ranks;
+    MPI_Comm_size( comm_z, &num_ranks);
+    std::vector<int> counts( num_ranks), displs( num_ranks, 0);
+    for( int r=0; r<num_ranks; r++)
+    {
+        unsigned len = (size_t)(r+1)*size/num_ranks - (size_t)r*size/num_ranks;
+        counts[r] = num_blocks*len;
+        if( r > 0)
+            displs[r] = displs[r-1] + counts[r-1];
+    }
+    thrust::host_vector<double> buffer( num_blocks*size);
+    MPI_Allgatherv( thrust::raw_pointer_cast( in.data()), in.size(), MPI_DOUBLE,
+        thrust::raw_pointer_cast( buffer.data()), &counts[0], &displs[0],
+        MPI_DOUBLE, comm_z);
+    out.resize( num_blocks*size);
+    for( int r=0; r<num_ranks; r++)
+    {
+        unsigned begin = (size_t)r*size/num_ranks;
+        unsigned len = counts[r]/num_blocks;
+        for( unsigned b=0; b<num_blocks; b++)
+            for( unsigned i=0; i<len; i++)
+                out[b*size+begin+i] = buffer[displs[r]+b*len+i];
+    }
+}
+
+// Same as the shared memory version but the integration of the (local)
+// points in grid_evaluate is distributed among the processes in comm_z
+template<class real_type>
+void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl1& vec,
+    const dg::aRealGeometry2d<real_type>& grid_field,
+    const dg::aRealTopology2d<real_type>& grid_evaluate,
+    std::array<thrust::host_vector<real_type>,3>& yp,
+    const thrust::host_vector<double>& vol0,
+    thrust::host_vector<real_type>& yp2b,
+    thrust::host_vector<bool>& in_boxp,
+    real_type deltaPhi, real_type eps, MPI_Comm comm_z)
+{
+    const unsigned size = grid_evaluate.size();
+    std::array<unsigned,2> chunk = z_chunk( size, comm_z);
+    const unsigned len = chunk[1] - chunk[0];
+    thrust::host_vector<real_type> X = dg::evaluate( dg::cooX2d, grid_evaluate);
+    thrust::host_vector<real_type> Y = dg::evaluate( dg::cooY2d, grid_evaluate);
+    std::array<thrust::host_vector<real_type>,3> y{
+        thrust::host_vector<real_type>( X.begin()+chunk[0], X.begin()+chunk[1]),
+        thrust::host_vector<real_type>( Y.begin()+chunk[0], Y.begin()+chunk[1]),
+        thrust::host_vector<real_type>( vol0.begin()+chunk[0], vol0.begin()+chunk[1])
+    }, yc;
+    thrust::host_vector<real_type> yc2b;
+    thrust::host_vector<bool> in_boxc;
+    integrate_fieldlines2d( vec, grid_field, y, yc, yc2b, in_boxc, deltaPhi, eps);
+    // pack yp[0], yp[1], yp[2], yp2b and in_boxp and gather
+    thrust::host_vector<double> send( 5*len), recv;
+    for( unsigned i=0; i<len; i++)
+    {
+        send[0*len+i] = yc[0][i];
+        send[1*len+i] = yc[1][i];
+        send[2*len+i] = yc[2][i];
+        send[3*len+i] = yc2b[i];
+        send[4*len+i] = in_boxc[i] ? 1. : 0.;
+    }
+    z_allgather( size, 5, send, recv, comm_z);
+    yp.fill( thrust::host_vector<real_type>( size));
+    yp2b.resize( size);
+    in_boxp.resize( size);
+    for( unsigned i=0; i<size; i++)
+    {
+        yp[0][i]   = recv[0*size+i];
+        yp[1][i]   = recv[1*size+i];
+        yp[2][i]   = recv[2*size+i];
+        yp2b[i]    = recv[3*size+i];
+        in_boxp[i] = recv[4*size+i] != 0.;
+    }
+}
+}//namespace detail
 
 template <class ProductMPIGeometry, class MIMatrix, class LocalContainer>
 struct Fieldaligned< ProductMPIGeometry, MIMatrix, MPI_Vector<LocalContainer> >
@@ -22,9 +113,10 @@ struct Fieldaligned< ProductMPIGeometry, MIMatrix, MPI_Vector<LocalContainer> >
         double eps = 1e-5,
         unsigned mx=12, unsigned my=12,
         double deltaPhi = -1, std::string interpolation_method = "linear-nearest",
-        bool benchmark = true):
+        bool benchmark = true, bool precompute_adjoint = false):
             Fieldaligned( dg::geo::createBHat(vec), grid, bcx, bcy, limit, eps,
-                    mx, my, deltaPhi, interpolation_method, benchmark)
+                    mx, my, deltaPhi, interpolation_method, benchmark,
+                    precompute_adjoint)
     {
     }
     template <class Limiter>
@@ -36,7 +128,7 @@ struct Fieldaligned< ProductMPIGeometry, MIMatrix, MPI_Vector<LocalContainer> >
         double eps = 1e-5,
         unsigned mx=12, unsigned my=12,
         double deltaPhi = -1, std::string interpolation_method = "linear-nearest",
-        bool benchmark = true);
+        bool benchmark = true, bool precompute_adjoint = false);
     template<class ...Params>
     void construct( Params&& ...ps)
     {
@@ -222,10 +314,10 @@ struct Fieldaligned< ProductMPIGeometry, MIMatrix, MPI_Vector<LocalContainer> >
     std::array<thrust::host_vector<double>,3> yp, ym;
     detail::integrate_all_fieldlines2d( vec, *global_grid_magnetic,
             grid_transform->local(), yp_trafo, vol2d0.data(), hbp, in_boxp,
-            deltaPhi, eps);
+            deltaPhi, eps, m_g->comm(2));
     detail::integrate_all_fieldlines2d( vec, *global_grid_magnetic,
             grid_transform->local(), ym_trafo, vol2d0.data(), hbm, in_boxm,
-            -deltaPhi, eps);
+            -deltaPhi, eps, m_g->comm(2));
     dg::HVec Xf = dg::evaluate(  dg::cooX2d, grid_fine_local);
     dg::HVec Yf = dg::evaluate(  dg::cooY2d, grid_fine_local);
     {
@@ -309,7 +401,8 @@ Fieldaligned<MPIGeometry, MIMatrix, MPI_Vector<LocalContainer> >::Fieldaligned(
     const MPIGeometry& grid,
     dg::bc bcx, dg::bc bcy, Limiter limit, double eps,
     unsigned mx, unsigned my,
-    double deltaPhi, std::string interpolation_method, bool benchmark
+    double deltaPhi, std::string interpolation_method, bool benchmark,
+    bool precompute_adjoint
     ):
         m_g(grid), m_bcx(bcx), m_bcy(bcy), m_bcz(grid.bcz()),
         m_Nz( grid.local().Nz()), m_mx(mx), m_my(my), m_eps(eps),
@@ -341,7 +434,7 @@ Fieldaligned<MPIGeometry, MIMatrix, MPI_Vector<LocalContainer> >::Fieldaligned(
 
     make_matrices( vec, grid_transform, global_grid_magnetic,
             bcx, bcy, eps, mx, my, m_deltaPhi, interpolation_method,
-            benchmark, false, vol2d0, hbp, hbm,
+            benchmark, precompute_adjoint, vol2d0, hbp, hbm,
             in_boxp, in_boxm,
             yp_trafo, ym_trafo);
     ///%%%%%%%%%%%%%%%%%%%%copy into h vectors %%%%%%%%%%%%%%%%%%%//
@@ -430,8 +523,6 @@ void Fieldaligned<G, M, MPI_Vector<container> >::operator()(enum
         whichMatrix which, const MPI_Vector<container>& f,
         MPI_Vector<container>& fe)
 {
-    if(which == einsPlus || which == einsMinusT) ePlus( which, f, fe);
-    if(which == einsMinus || which == einsPlusT) eMinus( which, f, fe);
     if(     which == einsPlus  || which == einsMinusT ) ePlus(  which, f, fe);
     else if(which == einsMinus || which == einsPlusT  ) eMinus( which, f, fe);
     else if(which == zeroMinus || which == zeroPlus ||
@@ -576,26 +667,35 @@ MPI_Vector<container> Fieldaligned<G,M, MPI_Vector<container> >::evaluate( Binar
     unsigned globalNz = m_g->global().Nz();
 
     MPI_Vector<container> temp(init2d), tempP(init2d), tempM(init2d);
+    MPI_Vector<container> powP(init2d), powM(init2d); // I^rep init2d
     MPI_Vector<container> vec3d = dg::evaluate( dg::zero, *m_g);
     std::vector<MPI_Vector<container> >  plus2d(globalNz, zero2d), minus2d(plus2d), result(plus2d);
     unsigned turns = rounds;
     if( turns ==0) turns++;
+    // Without rounds only the planes up to the furthest local plane are needed
+    // (the same number for all processes in the perpendicular communicator)
+    unsigned num_planes = globalNz;
+    if( rounds == 0)
+    {
+        int lo = (int)(m_coords2*m_Nz) - (int)p0, hi = lo + (int)m_Nz - 1;
+        num_planes = std::min( globalNz, (unsigned)std::max( hi, -lo) + 1);
+    }
     //first apply Interpolation many times, scale and store results
     for( unsigned r=0; r<turns; r++)
-        for( unsigned i0=0; i0<globalNz; i0++)
+        for( unsigned i0=0; i0<num_planes; i0++)
         {
-            dg::blas1::copy( init2d, tempP);
-            dg::blas1::copy( init2d, tempM);
             unsigned rep = r*globalNz + i0;
-            for(unsigned k=0; k<rep; k++)
+            if( rep > 0) // apply once more to the previous power
             {
                 //!!! The value of f at the plus plane is I^- of the current plane
-                dg::blas2::symv( m_minus, tempP, temp);
-                temp.swap( tempP);
+                dg::blas2::symv( m_minus, powP, temp);
+                temp.swap( powP);
                 //!!! The value of f at the minus plane is I^+ of the current plane
-                dg::blas2::symv( m_plus, tempM, temp);
-                temp.swap( tempM);
+                dg::blas2::symv( m_plus, powM, temp);
+                temp.swap( powM);
             }
+            dg::blas1::copy( powP, tempP);
+            dg::blas1::copy( powM, tempM);
             dg::blas1::scal( tempP, unary(  (double)rep*m_deltaPhi ) );
             dg::blas1::scal( tempM, unary( -(double)rep*m_deltaPhi ) );
             dg::blas1::axpby( 1., tempP, 1., plus2d[i0]);
@@ -655,13 +755,23 @@ MPI_Vector<thrust::host_vector<double>> fieldaligned_evaluate(
     const dg::ClonePtr<aMPIGeometry2d> g2d = grid.perp_grid();
     // Construct for field-aligned output
     dg::MHVec vec3d = dg::evaluate( dg::zero, grid);
-    dg::MHVec tempP = dg::evaluate( dg::zero, *g2d), tempM( tempP);
-    std::vector<dg::MHVec>  plus2d(Nz, tempP), minus2d(plus2d), result(plus2d);
+    dg::MHVec zero2d = dg::evaluate( dg::zero, *g2d);
+    std::vector<dg::MHVec>  plus2d(Nz, zero2d), minus2d(plus2d), result(plus2d);
     dg::MHVec init2d = dg::pullback( binary, *g2d);
+    // All processes in the z-communicator have the same perpendicular points
+    // so each integrates only its chunk of the points
+    const unsigned size = g2d->local().size();
+    std::array<unsigned,2> chunk = detail::z_chunk( size, grid.comm(2));
+    const unsigned len = chunk[1] - chunk[0];
+    dg::HVec X = dg::evaluate( dg::cooX2d, g2d->local());
+    dg::HVec Y = dg::evaluate( dg::cooY2d, g2d->local());
     std::array<dg::HVec,3> yy0{
-        dg::evaluate( dg::cooX2d, g2d->local()),
-        dg::evaluate( dg::cooY2d, g2d->local()),
-        dg::evaluate( dg::zero, g2d->local())}, yy1(yy0), xx0( yy0), xx1(yy0); //s
+        dg::HVec( X.begin()+chunk[0], X.begin()+chunk[1]),
+        dg::HVec( Y.begin()+chunk[0], Y.begin()+chunk[1]),
+        dg::HVec( len, 0.)}, yy1(yy0), xx0( yy0), xx1(yy0); //s
+    dg::HVec init( init2d.data().begin()+chunk[0], init2d.data().begin()+chunk[1]);
+    dg::HVec tempP( init), tempM( init);
+    std::vector<dg::HVec> plus( Nz, dg::HVec( len, 0.)), minus( plus);
     dg::geo::detail::DSFieldCylindrical3 cyl_field(vec);
     double deltaPhi = grid.hz();
     double phiM0 = 0., phiP0 = 0.;
@@ -672,14 +782,14 @@ MPI_Vector<thrust::host_vector<double>> fieldaligned_evaluate(
         {
             unsigned rep = r*Nz + i0;
             if( rep == 0)
-                tempM = tempP = init2d;
+                tempM = tempP = init;
             else
             {
                 dg::Adaptive<dg::ERKStep<std::array<double,3>>> adapt(
                         "Dormand-Prince-7-4-5", std::array<double,3>{0,0,0});
                 dg::AdaptiveTimeloop<std::array<double,3>> odeint( adapt,
                     cyl_field, dg::pid_control, dg::fast_l2norm, eps, 1e-10);
-                for( unsigned i=0; i<g2d->local().size(); i++)
+                for( unsigned i=0; i<len; i++)
                 {
                     // minus direction needs positive integration!
                     double phiM1 = phiM0 + deltaPhi;
@@ -689,7 +799,7 @@ MPI_Vector<thrust::host_vector<double>> fieldaligned_evaluate(
                             coords1, deltaPhi, g2d->global(), eps);
                     yy1[0][i] = coords1[0], yy1[1][i] = coords1[1], yy1[2][i] =
                         coords1[2];
-                    tempM.data()[i] = binary( yy1[0][i], yy1[1][i]);
+                    tempM[i] = binary( yy1[0][i], yy1[1][i]);
 
                     // plus direction needs negative integration!
                     double phiP1 = phiP0 - deltaPhi;
@@ -698,7 +808,7 @@ MPI_Vector<thrust::host_vector<double>> fieldaligned_evaluate(
                             coords1, -deltaPhi, g2d->global(), eps);
                     xx1[0][i] = coords1[0], xx1[1][i] = coords1[1], xx1[2][i] =
                         coords1[2];
-                    tempP.data()[i] = binary( xx1[0][i], xx1[1][i]);
+                    tempP[i] = binary( xx1[0][i], xx1[1][i]);
                 }
                 std::swap( yy0, yy1);
                 std::swap( xx0, xx1);
@@ -707,9 +817,24 @@ MPI_Vector<thrust::host_vector<double>> fieldaligned_evaluate(
             }
             dg::blas1::scal( tempM, unary( -(double)rep*deltaPhi ) );
             dg::blas1::scal( tempP, unary(  (double)rep*deltaPhi ) );
-            dg::blas1::axpby( 1., tempM, 1., minus2d[i0]);
-            dg::blas1::axpby( 1., tempP, 1., plus2d[i0]);
+            dg::blas1::axpby( 1., tempM, 1., minus[i0]);
+            dg::blas1::axpby( 1., tempP, 1., plus[i0]);
         }
+    // gather the chunks of all z-processes
+    dg::HVec send( 2*Nz*len), recv;
+    for( unsigned i0=0; i0<Nz; i0++)
+    {
+        thrust::copy( minus[i0].begin(), minus[i0].end(), send.begin() + i0*len);
+        thrust::copy( plus[i0].begin(), plus[i0].end(), send.begin() + (Nz+i0)*len);
+    }
+    detail::z_allgather( size, 2*Nz, send, recv, grid.comm(2));
+    for( unsigned i0=0; i0<Nz; i0++)
+    {
+        thrust::copy( recv.begin() + i0*size, recv.begin() + (i0+1)*size,
+            minus2d[i0].data().begin());
+        thrust::copy( recv.begin() + (Nz+i0)*size, recv.begin() + (Nz+i0+1)*size,
+            plus2d[i0].data().begin());
+    }
     //now we have the plus and the minus filaments
     int dims[3], periods[3], coords[3];
     MPI_Cart_get( grid.communicator(), 3, dims, periods, coords);
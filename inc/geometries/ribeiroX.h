@@ -290,7 +290,13 @@ struct RibeiroX : public aGeneratorX2d
         zetaX = zetaY = etaX = etaY =x ;
         unsigned Nx = zeta1d.size(), Ny = eta1d.size();
         fx_.resize(Nx);
-        for( unsigned i=0; i<zeta1d.size(); i++)
+        // every psi surface is integrated independently (computeX_rzy takes
+        // copies of fpsi_ and the field); surfaces close to the separatrix
+        // take many more steps, hence the dynamic schedule
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic) if( !omp_in_parallel())
+#endif //_OPENMP
+        for( int i=0; i<(int)Nx; i++)
         {
             thrust::host_vector<double> ry, zy;
             thrust::host_vector<double> yr, yz, xr, xz;
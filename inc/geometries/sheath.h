@@ -21,7 +21,7 @@ namespace geo{
  *     \frac{ d Z}{d \varphi} = b^Z / b^\varphi \\
  *     \frac{ d s}{s \varphi} = 1   / b^\varphi
  * \f]
- * for initial conditions \f$ (R,Z,0)\f$ until either a maximum angle is reached or until \f$ (R,Z) \f$ leaves the given domain. In the latter case a bisection algorithm is used to find the exact angle \f$\varphi_l\f$ of leave. Either the angle \f$ \varphi_l\f$ or the corresponding \f$ s_l\f$ is returned by the function.
+ * for initial conditions \f$ (R,Z,0)\f$ until either a maximum angle is reached or until \f$ (R,Z) \f$ leaves the given domain. In the latter case a bisection algorithm on the field line stored by \c FieldlineTracer is used to find the exact angle \f$\varphi_l\f$ of leave. Either the angle \f$ \varphi_l\f$ or the corresponding \f$ s_l\f$ is returned by the function.
  * @ingroup wall
  * @attention The sign of the angle coordinate in this class (unlike in
  * Fieldaligned) is defined with respect to the direction of the magnetic
@@ -73,14 +73,15 @@ struct WallFieldlineDistance : public aCylindricalFunctor<WallFieldlineDistance>
         if( m_pred(R,Z)) // only integrate if necessary
         {
             try{
-                dg::Adaptive<dg::ERKStep<std::array<double,3>>> adapt(
-                        "Dormand-Prince-7-4-5", coords);
-                dg::AdaptiveTimeloop<std::array<double,3>> odeint( adapt,
-                        m_cyl_field, dg::pid_control, dg::fast_l2norm, m_eps,
-                        1e-10); // using 1e-10 instead of eps may cost 10% of performance but is what we also use in Fieldaligned
-                odeint.integrate_in_domain( 0., coords, phi1, coordsP, 0.,
-                        m_domain, m_eps);
-                //integration
+                // the angle of leave is found on the stored field line
+                FieldlineTracer tracer( m_cyl_field, {
+                        thrust::host_vector<double>( 1, R),
+                        thrust::host_vector<double>( 1, Z),
+                        thrust::host_vector<double>( 1, 0.)},
+                        std::min( phi1, 0.), std::max( phi1, 0.), m_eps,
+                        m_domain);
+                phi1 = tracer.leave( 0, phi1, m_domain, m_eps);
+                coordsP = tracer( 0, phi1);
             }catch (std::exception& e)
             {
                 // if not possible the distance is large
@@ -151,15 +152,18 @@ struct WallFieldlineCoordinate : public aCylindricalFunctor<WallFieldlineCoordin
         if( m_pred(R,Z)) // only integrate if necessary
         {
             try{
-                dg::AdaptiveTimeloop<std::array<double,3>> odeint(
-                        dg::Adaptive<dg::ERKStep<std::array<double,3>>>(
-                            "Dormand-Prince-7-4-5", coords), m_cyl_field,
-                        dg::pid_control, dg::fast_l2norm, m_eps,
-                        1e-10); // using 1e-10 instead of eps may cost 10% of performance but is what we also use in Fieldaligned
-                odeint.integrate_in_domain( 0., coords, phiP, coordsP, 0.,
-                        m_domain, m_eps);
-                odeint.integrate_in_domain( 0., coords, phiM, coordsM, 0.,
-                        m_domain, m_eps);
+                // integrate both directions once and find the angles of
+                // leave on the stored field line
+                FieldlineTracer tracer( m_cyl_field, {
+                        thrust::host_vector<double>( 1, R),
+                        thrust::host_vector<double>( 1, Z),
+                        thrust::host_vector<double>( 1, 0.)},
+                        std::min( phiM, phiP), std::max( phiM, phiP), m_eps,
+                        m_domain);
+                phiP = tracer.leave( 0, phiP, m_domain, m_eps);
+                phiM = tracer.leave( 0, phiM, m_domain, m_eps);
+                coordsP = tracer( 0, phiP);
+                coordsM = tracer( 0, phiM);
             }catch (std::exception& e)
             {
                 // if not possible the distance is large
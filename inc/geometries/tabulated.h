@@ -0,0 +1,394 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "magnetic_field.h"
+
+/*!@file
+ *
+ * Tabulated MagneticField objects
+ */
+namespace dg
+{
+namespace geo
+{
+///@cond
+namespace detail
+{
+// 4th order finite difference derivative of the n (>= 5) values
+// f[0], f[stride], ..., f[(n-1)*stride] with spacing h, written to df
+// (same stride); one-sided stencils at the two ends
+inline void fd_derivative( unsigned n, const double* f, unsigned stride,
+    double h, double* df)
+{
+    auto F = [&]( unsigned i){ return f[i*stride];};
+    const double c = 1./12./h;
+    df[0] = c*(-25.*F(0)+48.*F(1)-36.*F(2)+16.*F(3)-3.*F(4));
+    df[stride] = c*(-3.*F(0)-10.*F(1)+18.*F(2)-6.*F(3)+F(4));
+    for( unsigned i=2; i<n-2; i++)
+        df[i*stride] = c*(F(i-2) - 8.*F(i-1) + 8.*F(i+1) - F(i+2));
+    df[(n-2)*stride] = c*(3.*F(n-1)+10.*F(n-2)-18.*F(n-3)+6.*F(n-4)-F(n-5));
+    df[(n-1)*stride] = c*(25.*F(n-1)-48.*F(n-2)+36.*F(n-3)-16.*F(n-4)+3.*F(n-5));
+}
+}//namespace detail
+///@endcond
+
+///@addtogroup fluxfunctions
+///@{
+/**
+ * @brief Bicubic Hermite interpolation of a function tabulated on an
+ * equidistant R-Z mesh
+ *
+ * The function and its derivatives \f$ f, \partial_R f, \partial_Z f,
+ * \partial_R\partial_Z f\f$ are stored in the \f$ (N_R+1)(N_Z+1)\f$ nodes of
+ * the mesh. Derivatives that are not given are computed with 4th order
+ * finite differences from the tabulated values. In each cell the function is
+ * the tensor product of cubic Hermite polynomials, i.e. the interpolation is
+ * continuously differentiable, the function is interpolated with error
+ * \f$ \mathcal O(h^4)\f$ and its first derivatives with error \f$ \mathcal
+ * O(h^3)\f$. This holds with and without given derivatives: the \f$
+ * \mathcal O(h^4)\f$ error of the finite differences is multiplied by basis
+ * functions of size \f$ h\f$ and adds only \f$ \mathcal O(h^5)\f$.
+ *
+ * Evaluation computes the cell index with \c std::floor, \c std::min and \c
+ * std::max only and contains no branches apart from a check for non-finite
+ * coordinates. Points outside the mesh are extrapolated with the polynomial of
+ * the nearest boundary cell.
+ * @note The table is shared between copies, so the object is cheap to copy
+ * (e.g. into a \c dg::geo::CylindricalFunctor)
+ */
+struct BicubicHermite : public aCylindricalFunctor<BicubicHermite>
+{
+    ///as long as the object stays empty the access functions are undefined
+    BicubicHermite(){}
+    /**
+     * @brief Tabulate function, derivatives by finite differences
+     *
+     * @param f the function to tabulate
+     * @copydoc hide_tabulated_mesh
+     */
+    BicubicHermite( const CylindricalFunctor& f, double R0, double R1,
+        double Z0, double Z1, unsigned NR, unsigned NZ)
+    {
+        tabulate( &f, nullptr, nullptr, nullptr, R0, R1, Z0, Z1, NR, NZ);
+    }
+    /**
+     * @brief Tabulate function and first derivatives, mixed derivative by
+     * finite differences
+     *
+     * @param f the function to tabulate
+     * @param fR \f$ \partial_R f\f$
+     * @param fZ \f$ \partial_Z f\f$
+     * @copydoc hide_tabulated_mesh
+     */
+    BicubicHermite( const CylindricalFunctor& f, const CylindricalFunctor& fR,
+        const CylindricalFunctor& fZ, double R0, double R1, double Z0,
+        double Z1, unsigned NR, unsigned NZ)
+    {
+        tabulate( &f, &fR, &fZ, nullptr, R0, R1, Z0, Z1, NR, NZ);
+    }
+    /**
+     * @brief Tabulate function and all derivatives
+     *
+     * @param f the function to tabulate
+     * @param fR \f$ \partial_R f\f$
+     * @param fZ \f$ \partial_Z f\f$
+     * @param fRZ \f$ \partial_R\partial_Z f\f$
+     * @copydoc hide_tabulated_mesh
+     */
+    BicubicHermite( const CylindricalFunctor& f, const CylindricalFunctor& fR,
+        const CylindricalFunctor& fZ, const CylindricalFunctor& fRZ,
+        double R0, double R1, double Z0, double Z1, unsigned NR, unsigned NZ)
+    {
+        tabulate( &f, &fR, &fZ, &fRZ, R0, R1, Z0, Z1, NR, NZ);
+    }
+
+    ///@return the interpolated function at (R,Z)
+    double do_compute( double R, double Z) const
+    {
+        return apply( stencil( R, Z));
+    }
+    ///@brief The cell and basis function values of a point
+    struct Stencil
+    {
+        size_t idx; //!< index of the lower left node
+        double a0, a1, b0, b1; //!< basis in R (b scaled by hR)
+        double c0, c1, d0, d1; //!< basis in Z (d scaled by hZ)
+    };
+    /**
+     * @brief Locate a point in the mesh
+     *
+     * Tables on the same mesh can share the stencil (see \c apply)
+     * @param R R-coordinate
+     * @param Z Z-coordinate
+     * @return cell and cubic Hermite basis functions
+     * @attention Throws a \c dg::Error if \c R or \c Z is not finite
+     */
+    Stencil stencil( double R, double Z) const
+    {
+        // a NaN passes through std::min and std::max into the cell index
+        if( !std::isfinite( R) || !std::isfinite( Z))
+            throw dg::Error( dg::Message(_ping_)<<"Tabulated function evaluated at non-finite point R = "<<R<<" Z = "<<Z);
+        double x = (R-m_R0)*m_invhR, y = (Z-m_Z0)*m_invhZ;
+        double ci = std::min( std::max( std::floor( x), 0.), m_NR-1.);
+        double cj = std::min( std::max( std::floor( y), 0.), m_NZ-1.);
+        double t = x - ci, u = y - cj;
+        Stencil s;
+        s.idx = 4*((size_t)cj*(m_NR+1) + (size_t)ci);
+        s.a0 = (1.+2.*t)*(1.-t)*(1.-t), s.a1 = t*t*(3.-2.*t);
+        s.b0 = m_hR*t*(1.-t)*(1.-t),   s.b1 = m_hR*t*t*(t-1.);
+        s.c0 = (1.+2.*u)*(1.-u)*(1.-u), s.c1 = u*u*(3.-2.*u);
+        s.d0 = m_hZ*u*(1.-u)*(1.-u),   s.d1 = m_hZ*u*u*(u-1.);
+        return s;
+    }
+    /**
+     * @brief Interpolate with a given stencil
+     *
+     * @param s a stencil computed by \c stencil of a table on the same mesh
+     * @return the interpolated function
+     */
+    double apply( const Stencil& s) const
+    {
+        const double* p00 = m_ptr + s.idx;
+        const double* p10 = p00 + 4;
+        const double* p01 = p00 + 4*(m_NR+1);
+        const double* p11 = p01 + 4;
+        return s.c0*(s.a0*p00[0] + s.a1*p10[0] + s.b0*p00[1] + s.b1*p10[1])
+             + s.c1*(s.a0*p01[0] + s.a1*p11[0] + s.b0*p01[1] + s.b1*p11[1])
+             + s.d0*(s.a0*p00[2] + s.a1*p10[2] + s.b0*p00[3] + s.b1*p10[3])
+             + s.d1*(s.a0*p01[2] + s.a1*p11[2] + s.b0*p01[3] + s.b1*p11[3]);
+    }
+    /**
+     * @brief Evaluate at many points at once
+     *
+     * @param size number of points
+     * @param R R-coordinates of the points (size elements)
+     * @param Z Z-coordinates of the points (size elements)
+     * @param f contains the interpolated function on output (size elements)
+     */
+    void evaluate( unsigned size, const double* R, const double* Z, double* f) const
+    {
+        for( unsigned i=0; i<size; i++)
+            f[i] = do_compute( R[i], Z[i]);
+    }
+    ///left boundary in R
+    double R0() const{ return m_R0;}
+    ///lower boundary in Z
+    double Z0() const{ return m_Z0;}
+    ///number of cells in R
+    unsigned NR() const{ return m_NR;}
+    ///number of cells in Z
+    unsigned NZ() const{ return m_NZ;}
+    ///cell size in R
+    double hR() const{ return m_hR;}
+    ///cell size in Z
+    double hZ() const{ return m_hZ;}
+    private:
+    void tabulate( const CylindricalFunctor* f, const CylindricalFunctor* fR,
+        const CylindricalFunctor* fZ, const CylindricalFunctor* fRZ,
+        double R0, double R1, double Z0, double Z1, unsigned NR, unsigned NZ)
+    {
+        if( NR < 4 || NZ < 4)
+            throw dg::Error( dg::Message(_ping_)<<"Tabulation needs at least 4 cells in each direction but got NR = "<<NR<<" and NZ = "<<NZ);
+        if( !(R1 > R0) || !(Z1 > Z0))
+            throw dg::Error( dg::Message(_ping_)<<"Tabulation needs R1 > R0 and Z1 > Z0 but got "<<R0<<" "<<R1<<" "<<Z0<<" "<<Z1);
+        m_R0 = R0, m_Z0 = Z0, m_NR = NR, m_NZ = NZ;
+        m_hR = (R1-R0)/(double)NR, m_hZ = (Z1-Z0)/(double)NZ;
+        m_invhR = 1./m_hR, m_invhZ = 1./m_hZ;
+        const unsigned nR = NR+1, nZ = NZ+1;
+        auto data = std::make_shared<std::vector<double>>( 4*nR*nZ);
+        std::vector<double>& d = *data;
+        for( unsigned j=0; j<nZ; j++)
+        for( unsigned i=0; i<nR; i++)
+        {
+            double R = R0 + i*m_hR, Z = Z0 + j*m_hZ;
+            double* p = &d[4*(j*nR+i)];
+            p[0] = (*f)(R,Z);
+            if( fR)  p[1] = (*fR)(R,Z);
+            if( fZ)  p[2] = (*fZ)(R,Z);
+            if( fRZ) p[3] = (*fRZ)(R,Z);
+        }
+        if( !fR)
+            for( unsigned j=0; j<nZ; j++)
+                detail::fd_derivative( nR, &d[4*j*nR], 4, m_hR, &d[4*j*nR+1]);
+        if( !fZ)
+            for( unsigned i=0; i<nR; i++)
+                detail::fd_derivative( nZ, &d[4*i], 4*nR, m_hZ, &d[4*i+2]);
+        if( !fRZ)
+            for( unsigned j=0; j<nZ; j++)
+                detail::fd_derivative( nR, &d[4*j*nR+2], 4, m_hR, &d[4*j*nR+3]);
+        m_ptr = data->data();
+        m_data = data;
+    }
+    double m_R0, m_Z0, m_hR, m_hZ, m_invhR, m_invhZ;
+    unsigned m_NR, m_NZ;
+    const double* m_ptr = nullptr;
+    std::shared_ptr<const std::vector<double>> m_data;
+};
+
+/*!@class hide_tabulated_mesh
+ * @param R0 left boundary in R
+ * @param R1 right boundary in R
+ * @param Z0 lower boundary in Z
+ * @param Z1 upper boundary in Z
+ * @param NR number of cells in R (at least 4)
+ * @param NZ number of cells in Z (at least 4)
+ */
+
+/**
+ * @brief A magnetic field tabulated on a fine R-Z mesh
+ *
+ * Analytic equilibria (e.g. the Solovev or polynomial expansions) are
+ * expensive to evaluate and are evaluated many times during field line
+ * integration and grid generation. This class evaluates \f$ \psi_p\f$ and
+ * its first and second derivatives as well as \f$ I\f$ and its derivatives
+ * once on the nodes of an equidistant mesh and interpolates them with
+ * \c dg::geo::BicubicHermite splines. Analytic derivatives are used where
+ * available: \f$ \psi_p\f$ uses \f$ \psi_R, \psi_Z, \psi_{RZ}\f$,
+ * \f$ \psi_R\f$ uses \f$ \psi_{RR}, \psi_{RZ}\f$, \f$ \psi_Z\f$ uses \f$
+ * \psi_{RZ}, \psi_{ZZ}\f$ and \f$ I\f$ uses \f$ I_R, I_Z\f$; all other
+ * derivatives are finite differences on the mesh.
+ *
+ * The splines can be evaluated directly (without the \c std::function in
+ * \c dg::geo::CylindricalFunctor), for many points at once with the \c
+ * evaluate functions, or the class can be converted to a \c
+ * dg::geo::TokamakMagneticField to be used in place of the original field
+ * @note The mesh should be a bit larger than the region where the field is
+ * needed; outside of it the field is extrapolated
+ * @snippet tabulated_t.cpp doxygen
+ */
+struct TabulatedMagneticField
+{
+    ///as long as the field stays empty the access functions are undefined
+    TabulatedMagneticField(){}
+    /**
+     * @brief Tabulate a given magnetic field
+     *
+     * @param mag the magnetic field to tabulate
+     * @copydoc hide_tabulated_mesh
+     */
+    TabulatedMagneticField( const TokamakMagneticField& mag, double R0,
+        double R1, double Z0, double Z1, unsigned NR, unsigned NZ):
+        m_R0( mag.R0()), m_params( mag.params()),
+        m_psip( mag.psip(), mag.psipR(), mag.psipZ(), mag.psipRZ(),
+            R0, R1, Z0, Z1, NR, NZ),
+        m_psipR( mag.psipR(), mag.psipRR(), mag.psipRZ(), R0, R1, Z0, Z1, NR, NZ),
+        m_psipZ( mag.psipZ(), mag.psipRZ(), mag.psipZZ(), R0, R1, Z0, Z1, NR, NZ),
+        m_psipRR( mag.psipRR(), R0, R1, Z0, Z1, NR, NZ),
+        m_psipRZ( mag.psipRZ(), R0, R1, Z0, Z1, NR, NZ),
+        m_psipZZ( mag.psipZZ(), R0, R1, Z0, Z1, NR, NZ),
+        m_ipol( mag.ipol(), mag.ipolR(), mag.ipolZ(), R0, R1, Z0, Z1, NR, NZ),
+        m_ipolR( mag.ipolR(), R0, R1, Z0, Z1, NR, NZ),
+        m_ipolZ( mag.ipolZ(), R0, R1, Z0, Z1, NR, NZ)
+    { }
+    /// \f$ R_0 \f$
+    double R0()const {return m_R0;}
+    /// \f$ \psi_p(R,Z)\f$
+    const BicubicHermite& psip()const{return m_psip;}
+    /// \f$ \partial_R \psi_p(R,Z)\f$
+    const BicubicHermite& psipR()const{return m_psipR;}
+    /// \f$ \partial_Z \psi_p(R,Z)\f$
+    const BicubicHermite& psipZ()const{return m_psipZ;}
+    /// \f$ \partial_R\partial_R \psi_p(R,Z)\f$
+    const BicubicHermite& psipRR()const{return m_psipRR;}
+    /// \f$ \partial_R\partial_Z \psi_p(R,Z)\f$
+    const BicubicHermite& psipRZ()const{return m_psipRZ;}
+    /// \f$ \partial_Z\partial_Z \psi_p(R,Z)\f$
+    const BicubicHermite& psipZZ()const{return m_psipZZ;}
+    /// \f$ I(\psi_p) \f$
+    const BicubicHermite& ipol()const{return m_ipol;}
+    /// \f$ \partial_R I(\psi_p) \f$
+    const BicubicHermite& ipolR()const{return m_ipolR;}
+    /// \f$ \partial_Z I(\psi_p) \f$
+    const BicubicHermite& ipolZ()const{return m_ipolZ;}
+    ///Meta-data of the original field
+    const MagneticFieldParameters& params() const{return m_params;}
+
+    /**
+     * @brief \f$ \psi_p, \partial_R\psi_p, \partial_Z\psi_p\f$ at many points
+     *
+     * @param size number of points
+     * @param R R-coordinates of the points (size elements)
+     * @param Z Z-coordinates of the points (size elements)
+     * @param psip \f$ \psi_p\f$ on output (size elements)
+     * @param psipR \f$ \partial_R\psi_p\f$ on output (size elements)
+     * @param psipZ \f$ \partial_Z\psi_p\f$ on output (size elements)
+     */
+    void evaluate( unsigned size, const double* R, const double* Z,
+        double* psip, double* psipR, double* psipZ) const
+    {
+        for( unsigned i=0; i<size; i++)
+        {
+            BicubicHermite::Stencil s = m_psip.stencil( R[i], Z[i]);
+            psip[i]  = m_psip.apply( s);
+            psipR[i] = m_psipR.apply( s);
+            psipZ[i] = m_psipZ.apply( s);
+        }
+    }
+    /**
+     * @brief Contravariant components \f$ B^R, B^Z, B^\varphi\f$ at many points
+     *
+     * The right hand side of the field line equations, same as \c
+     * dg::geo::BFieldR, \c dg::geo::BFieldZ and \c dg::geo::BFieldP
+     * @param size number of points
+     * @param R R-coordinates of the points (size elements)
+     * @param Z Z-coordinates of the points (size elements)
+     * @param BR \f$ B^R = R_0\psi_Z/R\f$ on output (size elements)
+     * @param BZ \f$ B^Z = -R_0\psi_R/R\f$ on output (size elements)
+     * @param BP \f$ B^\varphi = R_0 I/R^2\f$ on output (size elements)
+     */
+    void evaluate_field( unsigned size, const double* R, const double* Z,
+        double* BR, double* BZ, double* BP) const
+    {
+        for( unsigned i=0; i<size; i++)
+        {
+            BicubicHermite::Stencil s = m_psip.stencil( R[i], Z[i]);
+            double R0R = m_R0/R[i];
+            BR[i] =  R0R*m_psipZ.apply( s);
+            BZ[i] = -R0R*m_psipR.apply( s);
+            BP[i] =  R0R*m_ipol.apply( s)/R[i];
+        }
+    }
+    /**
+     * @brief The tabulated field as a \c dg::geo::TokamakMagneticField
+     *
+     * Can be used everywhere in place of the original field
+     * @return a magnetic field that evaluates the splines
+     */
+    TokamakMagneticField field() const
+    {
+        return TokamakMagneticField( m_R0,
+            CylindricalFunctorsLvl2( m_psip, m_psipR, m_psipZ, m_psipRR,
+                m_psipRZ, m_psipZZ),
+            CylindricalFunctorsLvl1( m_ipol, m_ipolR, m_ipolZ), m_params);
+    }
+    ///same as \c field()
+    operator TokamakMagneticField() const{ return field();}
+    private:
+    double m_R0;
+    MagneticFieldParameters m_params;
+    BicubicHermite m_psip, m_psipR, m_psipZ, m_psipRR, m_psipRZ, m_psipZZ,
+                   m_ipol, m_ipolR, m_ipolZ;
+};
+
+/**
+ * @brief Tabulate a magnetic field on an equidistant R-Z mesh
+ *
+ * Shortcut for <tt> TabulatedMagneticField( mag, R0, R1, Z0, Z1, NR, NZ).field() </tt>
+ * @param mag the magnetic field to tabulate
+ * @copydoc hide_tabulated_mesh
+ * @return a magnetic field that evaluates bicubic splines instead of \c mag
+ * @sa \c dg::geo::TabulatedMagneticField
+ */
+inline TokamakMagneticField createTabulatedField( const TokamakMagneticField&
+    mag, double R0, double R1, double Z0, double Z1, unsigned NR, unsigned NZ)
+{
+    return TabulatedMagneticField( mag, R0, R1, Z0, Z1, NR, NZ).field();
+}
+///@}
+
+} //namespace geo
+}//namespace dg
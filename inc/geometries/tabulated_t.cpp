@@ -0,0 +1,100 @@
+#include <iostream>
+#include <iomanip>
+
+#include "dg/algorithm.h"
+#include "dg/file/file.h"
+
+#include "make_field.h"
+#include "tabulated.h"
+
+// Compare a tabulated to the analytic magnetic field and time the evaluation
+
+double max_error( const dg::HVec& ana, const dg::HVec& tab)
+{
+    double err = 0, norm = 0;
+    for( unsigned i=0; i<ana.size(); i++)
+    {
+        err  = std::max( err, fabs( ana[i]-tab[i]));
+        norm = std::max( norm, fabs( ana[i]));
+    }
+    return norm == 0 ? err : err/norm; // e.g. constant current
+}
+
+int main( int argc, char* argv[])
+{
+    std::string input = argc==1 ? "geometry_params_Xpoint.json" : argv[1];
+    dg::file::WrappedJsonValue js = dg::file::file2Json( input);
+    dg::geo::TokamakMagneticField mag = dg::geo::createMagneticField( js);
+    const double R0 = mag.R0(), a = mag.params().a(), e = mag.params().elongation();
+    unsigned NR = 256, NZ = 256;
+    std::cout << "Tabulate field on "<<NR<<"x"<<NZ<<" mesh\n";
+    dg::Timer t;
+    t.tic();
+    //![doxygen]
+    // tabulate once on a box slightly larger than the simulation box
+    dg::geo::TabulatedMagneticField tab( mag, R0-1.3*a, R0+1.3*a,
+            -1.3*a*e, 1.3*a*e, NR, NZ);
+    // use in place of the analytic field, e.g. for field line integration
+    dg::geo::TokamakMagneticField tab_mag = tab.field();
+    //![doxygen]
+    t.toc();
+    std::cout << "Tabulation took "<<t.diff()<<"s\n";
+
+    dg::Grid2d grid( R0-1.2*a, R0+1.2*a, -1.2*a*e, 1.2*a*e, 3, 100, 100);
+    std::cout << "Relative max error (should be small)\n";
+    std::vector<std::pair<std::string, std::pair<dg::geo::CylindricalFunctor,
+        dg::geo::CylindricalFunctor>>> list = {
+        {"psip",   {mag.psip(),   tab_mag.psip()}},
+        {"psipR",  {mag.psipR(),  tab_mag.psipR()}},
+        {"psipZ",  {mag.psipZ(),  tab_mag.psipZ()}},
+        {"psipRR", {mag.psipRR(), tab_mag.psipRR()}},
+        {"psipRZ", {mag.psipRZ(), tab_mag.psipRZ()}},
+        {"psipZZ", {mag.psipZZ(), tab_mag.psipZZ()}},
+        {"ipol",   {mag.ipol(),   tab_mag.ipol()}},
+        {"ipolR",  {mag.ipolR(),  tab_mag.ipolR()}},
+        {"ipolZ",  {mag.ipolZ(),  tab_mag.ipolZ()}}
+    };
+    for( auto pair : list)
+    {
+        dg::HVec ana = dg::evaluate( pair.second.first, grid);
+        dg::HVec num = dg::evaluate( pair.second.second, grid);
+        double err = max_error( ana, num);
+        std::cout << "    "<<std::setw(8)<<pair.first<<" "<<err<<"\n";
+        assert( err < 1e-5);
+    }
+
+    std::cout << "Evaluation at "<<grid.size()<<" points (time per call)\n";
+    const dg::HVec R = dg::evaluate( dg::cooX2d, grid);
+    const dg::HVec Z = dg::evaluate( dg::cooY2d, grid);
+    dg::HVec BR(R), BZ(R), BP(R), bR(R), bZ(R), bP(R);
+    const unsigned multi = 10;
+    t.tic();
+    for( unsigned k=0; k<multi; k++)
+    {
+        dg::blas1::evaluate( BR, dg::equals(), dg::geo::BFieldR(mag), R, Z);
+        dg::blas1::evaluate( BZ, dg::equals(), dg::geo::BFieldZ(mag), R, Z);
+        dg::blas1::evaluate( BP, dg::equals(), dg::geo::BFieldP(mag), R, Z);
+    }
+    t.toc();
+    std::cout << "    analytic field:   "<<t.diff()/multi<<"s\n";
+    t.tic();
+    for( unsigned k=0; k<multi; k++)
+    {
+        dg::blas1::evaluate( bR, dg::equals(), dg::geo::BFieldR(tab_mag), R, Z);
+        dg::blas1::evaluate( bZ, dg::equals(), dg::geo::BFieldZ(tab_mag), R, Z);
+        dg::blas1::evaluate( bP, dg::equals(), dg::geo::BFieldP(tab_mag), R, Z);
+    }
+    t.toc();
+    std::cout << "    tabulated field:  "<<t.diff()/multi<<"s\n";
+    t.tic();
+    for( unsigned k=0; k<multi; k++)
+        tab.evaluate_field( R.size(), &R[0], &Z[0], &bR[0], &bZ[0], &bP[0]);
+    t.toc();
+    std::cout << "    batch evaluation: "<<t.diff()/multi<<"s\n";
+    assert( max_error( BR, bR) < 1e-5);
+    assert( max_error( BZ, bZ) < 1e-5);
+    assert( max_error( BP, bP) < 1e-5);
+
+    std::cout << "ALL TESTS PASSED\n";
+    return 0;
+}
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "dg/algorithm.h"
 #include "matrixsqrt.h"
 #include "lanczos.h"
@@ -255,5 +257,87 @@ struct ExponentialERKStep
 
 };
 
+/**
+* @brief Compute matrix functions \f$ y = f(A) x\f$ of a self-adjoint matrix via Lanczos
+*
+* This is a \c MatrixFunction for \c ExponentialStep and \c ExponentialERKStep
+* that approximates the exponential and the \f$\varphi\f$-functions
+* (\c dg::mat::phi1, \c dg::mat::phi2, ...) in the Krylov subspace generated
+* by \c UniversalLanczos with the "universal" stopping criterion.
+* The functions of the tridiagonal matrix are computed via \c make_FuncEigen_Te1.
+* The typical use is a stiff linear diffusion operator \f$ A = \nu\Delta\f$
+* (note the sign, \c dg::Elliptic computes \f$ -\Delta\f$) such that only the
+* remaining (non-stiff) part of the equation restricts the timestep
+* @code{.cpp}
+dg::Elliptic2d<dg::CartesianGrid2d, dg::DMatrix, dg::DVec> lapperp( grid);
+auto diffusion = [&]( const auto& x, auto& y){
+    dg::blas2::symv( -nu, lapperp, x, 0., y);
+};
+dg::mat::LanczosMatrixFunction<dg::DVec> matrix( diffusion, lapperp.weights(), 1e-10);
+dg::mat::ExponentialERKStep<dg::DVec> stepper( "Hochbruck-3-3-4", y0);
+dg::SinglestepTimeloop<dg::DVec> loop( stepper, std::tie( rhs, matrix), dt);
+loop.integrate( t0, y0, t1, y1);
+* @endcode
+* @note The number of Lanczos iterations grows roughly like \f$\sqrt{\Delta t ||A||}\f$
+* @copydoc hide_ContainerType
+* @ingroup exp_int
+*/
+template<class ContainerType>
+struct LanczosMatrixFunction
+{
+    using value_type = get_value_type<ContainerType>;//!< the value type of the time variable (float or double)
+    using container_type = ContainerType; //!< the type of the vector class in use
+    ///@brief No memory allocation
+    LanczosMatrixFunction() = default;
+    /**
+    * @brief Construct Lanczos solver
+    *
+    * @tparam MatrixType Any type that can be used in \c dg::blas2::symv
+    * @param A self-adjoint matrix in \c weights
+    * (@attention \c A is stored by reference and must outlive this object)
+    * @param weights weights in which \c A is self-adjoint
+    * @param eps relative accuracy of the Lanczos method
+    * @param max_iter maximum number of Lanczos iterations
+    */
+    template<class MatrixType>
+    LanczosMatrixFunction( MatrixType& A, const ContainerType& weights,
+            value_type eps, unsigned max_iter = 500) :
+        m_A( [&A]( const ContainerType& x, ContainerType& y){
+                dg::blas2::symv( A, x, y);}),
+        m_lanczos( weights, max_iter), m_weights( weights), m_eps( eps)
+    { }
+    ///@copydoc hide_construct
+    template<class ...Params>
+    void construct( Params&& ...ps)
+    {
+        //construct and swap
+        *this = LanczosMatrixFunction( std::forward<Params>( ps)...);
+    }
+    ///@brief Set relative accuracy of the Lanczos method
+    ///@param eps new accuracy
+    void set_eps( value_type eps){ m_eps = eps;}
+    ///@brief Number of Lanczos iterations in the last call to \c operator()
+    ///@return number of iterations
+    unsigned get_iter() const{ return m_lanczos.get_iter();}
+    /**
+    * @brief \f$ y = f(A) x\f$
+    *
+    * @param f the matrix function (e.g. <tt>[dt](double x){return dg::mat::phi1(dt*x);}</tt>)
+    * @param x input vector
+    * @param y result (may not alias \c x)
+    */
+    template<class UnaryOp>
+    void operator()( UnaryOp f, const ContainerType& x, ContainerType& y)
+    {
+        m_lanczos.solve( y, make_FuncEigen_Te1( f), m_A, x, m_weights, m_eps,
+                1., "universal");
+    }
+    private:
+    std::function<void( const ContainerType&, ContainerType&)> m_A;
+    UniversalLanczos<ContainerType> m_lanczos;
+    ContainerType m_weights;
+    value_type m_eps;
+};
+
 } //namespace matrix
 } //namespace dg
@@ -57,5 +57,32 @@ int main()
         dg::blas1::axpby( 1., sol , -1., u1);
         std::cout << "Norm of error in "<<std::setw(24) <<name<<"\t"<<sqrt(dg::blas1::dot( u1, u1))<<"\n";
     }
+    // Stiff diffusion u_t = nu u_xx + g with solution u = sin(x)cos(t)
+    std::cout << "Diffusion with Lanczos matrix function\n";
+    const double nu = 1.;
+    dg::Grid1d grid( 0, 2.*M_PI, 3, 64, dg::PER);
+    dg::Elliptic1d<dg::Grid1d, dg::DMatrix, dg::DVec> lap( grid);
+    const dg::DVec sinx = dg::evaluate( dg::SinX( 1., 0., 1.), grid);
+    auto diffusion = [&]( const dg::DVec& x, dg::DVec& y){
+        dg::blas2::symv( -nu, lap, x, 0., y);
+    };
+    auto source = [&]( double t, const dg::DVec& y, dg::DVec& yp){
+        dg::blas1::axpby( nu*cos(t)-sin(t), sinx, 0., yp);
+    };
+    dg::mat::LanczosMatrixFunction<dg::DVec> lanczos( diffusion,
+            lap.weights(), 1e-12);
+    for ( auto name : names)
+    {
+        dg::DVec y0( sinx), y1( y0), sol( sinx);
+        dg::blas1::scal( sol, cos( t_end));
+        dg::mat::ExponentialERKStep<dg::DVec> rk( name, y0);
+        // dt is much larger than the explicit diffusive stability limit
+        dg::SinglestepTimeloop<dg::DVec>( rk, std::tie(source,lanczos),
+                dt).integrate( t_start, y0, t_end, y1);
+        dg::blas1::axpby( 1., sol , -1., y1);
+        std::cout << "Norm of error in "<<std::setw(24) <<name<<"\t"
+                  <<sqrt(dg::blas2::dot( y1, lap.weights(), y1))
+                  <<" (last # Lanczos iterations "<<lanczos.get_iter()<<")\n";
+    }
     return 0;
 }
@@ -720,10 +720,20 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_bhat(
     // do not construct FCI if we just want to calibrate
     if( !p.calibrate )
     {
+#ifdef MPI_VERSION
         m_fa.construct( bhat, g, dg::NEU, dg::NEU, dg::geo::NoLimiter(),
             p.rk4eps, p.mx, p.my, 2.*M_PI/(double)p.Nz, p.interpolation_method);
         m_faST.construct( bhat, g, dg::NEU, dg::NEU, dg::geo::NoLimiter(),
             p.rk4eps, p.mx, p.my, 2.*M_PI/(double)p.Nz/2., p.interpolation_method );
+#else
+        // the staggered object re-uses the field lines of the first
+        dg::geo::FieldlineTracer tracer = dg::geo::trace_fieldlines( bhat, g,
+            2.*M_PI/(double)p.Nz, p.rk4eps);
+        m_fa.construct( tracer, bhat, g, dg::NEU, dg::NEU, dg::geo::NoLimiter(),
+            p.mx, p.my, 2.*M_PI/(double)p.Nz, p.interpolation_method);
+        m_faST.construct( tracer, bhat, g, dg::NEU, dg::NEU, dg::geo::NoLimiter(),
+            p.mx, p.my, 2.*M_PI/(double)p.Nz/2., p.interpolation_method );
+#endif //MPI_VERSION
     }
 
     // in Poisson we take EPhi except for the true curvmode
@@ -767,6 +777,7 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_invert(
     //Set a hard code limit on the maximum number of iteration to avoid
     //endless iteration in case of failure
     m_multigrid.set_max_iter( 1e5);
+    m_multigrid.set_solver_type( p.mg_type, p.mg_smoother, p.mg_num_smooth);
     /////////////////////////init elliptic and helmholtz operators/////////
     auto bhat = dg::geo::createEPhi(+1); //bhat = ephi except when "true"
     if( p.curvmode == "true")
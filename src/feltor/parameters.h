@@ -20,6 +20,8 @@ struct Parameters
     double jfactor;
     double eps_gamma, eps_ampere;
     unsigned stages;
+    std::string mg_type, mg_smoother;
+    unsigned mg_num_smooth;
     unsigned mx, my;
     double rk4eps;
     std::string interpolation_method;
@@ -79,6 +81,9 @@ struct Parameters
         eps_ampere  = js["elliptic"].get( "eps_ampere", 1e-6).asDouble();
         pol_dir = dg::str2direction(
                 js["elliptic"].get("direction", "centered").asString() );
+        mg_type     = js["elliptic"].get( "type", "nested").asString();
+        mg_smoother = js["elliptic"].get( "smoother", "chebyshev").asString();
+        mg_num_smooth = js["elliptic"].get( "num_smooth", 3).asUInt();
 
 
         mx          = js["FCI"]["refine"].get( 0u, 1).asUInt();
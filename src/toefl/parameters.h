@@ -14,6 +14,8 @@ struct Parameters
     std::vector<double> eps_pol, eps_gamma;
     enum dg::direction pol_dir, diff_dir;
     unsigned num_stages;
+    std::string mg_type, mg_smoother;
+    unsigned mg_num_smooth;
 
     double amp, sigma, posX, posY;
 
@@ -42,6 +44,9 @@ struct Parameters
             eps_gamma[u]*=eps_gamma[0];
         }
         pol_dir =  dg::str2direction( js["elliptic"]["direction"].asString());
+        mg_type = js["elliptic"].get( "type", "nested").asString();
+        mg_smoother = js["elliptic"].get( "smoother", "chebyshev").asString();
+        mg_num_smooth = js["elliptic"].get( "num_smooth", 3).asUInt();
         diff_dir = dg::centered;
 
         amp = js["init"]["amplitude"].asDouble();
@@ -108,6 +113,9 @@ struct Parameters
             << "    amplitude:    "<<amp<<"\n"
             << "    posX:         "<<posX<<"\n"
             << "    posY:         "<<posY<<"\n";
+        os << "Multigrid type:          "<<mg_type<<"\n";
+        if( mg_type != "nested")
+            os << "    smoother "<<mg_smoother<<" with "<<mg_num_smooth<<" steps\n";
         os << "Stopping for CG:         "<<eps_pol[0]<<"\n"
             <<"Stopping for Gamma CG:   "<<eps_gamma[0]<<std::endl;
     }
@@ -0,0 +1,106 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif // WITH_MPI
+
+#include "dg/algorithm.h"
+#include "dg/file/file.h"
+
+#include "toefl.h"
+
+// Compare a serial fine integration with the Parareal iteration
+// Usage: parareal_b [input.json]
+// The optional "parareal" field in the input file may contain
+// "slices", "coarse", "fine" (tableaus), "dt_coarse", "dt_fine", "tend", "eps"
+// With MPI rank 0 reads npx and npy (the processes in space per time slice)
+// and the number of time processes is the total number divided by npx*npy
+int main( int argc, char* argv[])
+{
+#ifdef WITH_MPI
+    dg::mpi_init( argc, argv);
+    int rank, size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+    MPI_Comm_size( MPI_COMM_WORLD, &size);
+    DG_RANK0 std::cout << "# Type npx and npy\n";
+    auto np = dg::mpi_read_as<int>( 2, MPI_COMM_WORLD);
+    MPI_Comm space_comm, time_comm;
+    dg::mpi_split_time( MPI_COMM_WORLD, size/(np[0]*np[1]), space_comm,
+            time_comm);
+    MPI_Comm comm = dg::mpi_cart_create( space_comm, {np[0], np[1]},
+            {false, true});
+#endif //WITH_MPI
+    dg::file::WrappedJsonValue js( dg::file::error::is_throw);
+    toefl::Parameters p;
+    const std::string inputfile = argc == 1 ? "input/default.json" : argv[1];
+    try{
+        js = dg::file::file2Json( inputfile);
+        p = { js};
+    } catch( std::exception& e) {
+        DG_RANK0 std::cerr << "ERROR in input file "<<inputfile<<std::endl;
+        DG_RANK0 std::cerr << e.what()<<std::endl;
+        dg::abort_program();
+    }
+    DG_RANK0 p.display(std::cout);
+    dg::x::CartesianGrid2d grid( 0, p.lx, 0., p.ly, p.n, p.Nx, p.Ny,
+            p.bcx, p.bcy
+        #ifdef WITH_MPI
+        , comm
+        #endif //WITH_MPI
+        );
+    toefl::Explicit<dg::x::CartesianGrid2d, dg::x::DMatrix, dg::x::DVec>
+        rhs( grid, p);
+    dg::Gaussian g( p.posX*p.lx, p.posY*p.ly, p.sigma, p.sigma, p.amp);
+    using Vec = std::array< dg::x::DVec, 2>;
+    Vec y0({dg::evaluate( g, grid), dg::evaluate(g, grid)}), y1(y0), ref(y0);
+    if( p.model == "gravity_local" || p.model == "gravity_global" ||
+            p.model == "drift_global")
+        y0[1] = dg::evaluate( dg::zero, grid);
+
+    unsigned slices = js["parareal"].get("slices", 8).asUInt();
+    std::string coarse_tableau = js["parareal"].get("coarse",
+            "Runge-Kutta-4-4").asString();
+    std::string fine_tableau = js["parareal"].get("fine",
+            "Runge-Kutta-4-4").asString();
+    double dt_coarse = js["parareal"].get("dt_coarse", 1.).asDouble();
+    double dt_fine = js["parareal"].get("dt_fine", 0.1).asDouble();
+    double tend = js["parareal"].get("tend", 8.).asDouble();
+    double eps = js["parareal"].get("eps", 1e-8).asDouble();
+    DG_RANK0 std::cout << "# Parareal with "<<slices<<" slices, coarse "
+        <<coarse_tableau<<" dt "<<dt_coarse<<", fine "<<fine_tableau
+        <<" dt "<<dt_fine<<"\n";
+
+    dg::RungeKutta<Vec> coarse_rk( coarse_tableau, y0),
+        fine_rk( fine_tableau, y0);
+    coarse_rk.ignore_fsal();
+    fine_rk.ignore_fsal();
+    dg::SinglestepTimeloop<Vec> coarse( coarse_rk, rhs, dt_coarse),
+        fine( fine_rk, rhs, dt_fine);
+    dg::Timer t;
+    t.tic();
+    fine.integrate( 0., y0, tend, ref);
+    t.toc();
+    double serial = t.diff();
+    DG_RANK0 std::cout << "Serial fine integration took   "<<serial<<"s\n";
+
+    dg::Parareal<Vec> parareal( coarse, fine, y0, slices, slices);
+#ifdef WITH_MPI
+    parareal.set_communicator( time_comm);
+#endif //WITH_MPI
+    parareal.set_benchmark( true);
+    t.tic();
+    unsigned iter = parareal.integrate( 0., y0, tend, y1, eps);
+    t.toc();
+    dg::blas1::axpby( 1., ref, -1., y1);
+    double norm = sqrt( dg::blas1::dot( ref, ref));
+    double error = sqrt( dg::blas1::dot( y1, y1))/norm;
+    DG_RANK0 std::cout << "Parareal integration took      "<<t.diff()<<"s\n";
+    DG_RANK0 std::cout << "Number of iterations           "<<iter<<"\n";
+    DG_RANK0 std::cout << "Relative error to serial fine  "<<error<<"\n";
+    DG_RANK0 std::cout << "Speed-up                       "<<serial/t.diff()<<"\n";
+#ifdef WITH_MPI
+    MPI_Finalize();
+#endif //WITH_MPI
+    return 0;
+}
@@ -70,6 +70,7 @@ Explicit< Geometry, M, Container>::Explicit( const Geometry& grid, const Paramet
     m_old_phi( 2, m_chi), m_old_psi( 2, m_chi), m_old_gammaN( 2, m_chi),
     m_p(p)
 {
+    m_multigrid.set_solver_type( p.mg_type, p.mg_smoother, p.mg_num_smooth);
     m_multi_chi= m_multigrid.project( m_chi);
     for( unsigned u=0; u<p.num_stages; u++)
     {
@@ -83,6 +84,7 @@ Explicit< Geometry, M, Container>::Explicit( const Geometry& grid, const Paramet
 template< class G, class M, class Container>
 void Explicit<G, M, Container>::compute_psi( double t)
 {
+    DG_PROFILE_REGION( "toefl::compute_psi");
     if(m_p.model == "gravity_local")
         return;
     //in gyrofluid invert Gamma operator
@@ -121,6 +123,7 @@ template<class G, class M, class Container>
 void Explicit<G, M, Container>::polarisation( double t,
         const std::array<Container,2>& y)
 {
+    DG_PROFILE_REGION( "toefl::polarisation");
     //compute chi
     if(m_p.model == "global" )
     {
@@ -197,6 +200,7 @@ template< class G, class M, class Container>
 void Explicit<G, M, Container>::operator()( double t,
         const std::array<Container,2>& y, std::array<Container,2>& yp)
 {
+    DG_PROFILE_REGION( "toefl::rhs");
     m_ncalls ++ ;
     //y[0] = N_e - 1
     //y[1] = N_i - 1 || y[1] = Omega
@@ -273,9 +277,12 @@ void Explicit<G, M, Container>::operator()( double t,
             // ExB + Curv advection with updwind scheme
             dg::blas2::symv( m_centered[0], m_phi[u], m_dxphi[u]);
             dg::blas2::symv( m_centered[1], m_phi[u], m_dyphi[u]);
-            dg::blas1::pointwiseDot( -1., m_binv, m_dyphi[u], 0., m_v[0]);
-            dg::blas1::pointwiseDot( +1., m_binv, m_dxphi[u], 0., m_v[1]);
-            dg::blas1::plus( m_v[1], -tau[u]*m_p.kappa);
+            // v_x = -binv dyphi, v_y = binv dxphi - tau kappa in one pass
+            dg::blas1::fused(
+                dg::args<0,2,3>( dg::PointwiseDot( -1., 0.)),
+                dg::args<0,1,4>( dg::PointwiseDot( +1., 0.)),
+                dg::args<4>( dg::Plus( -tau[u]*m_p.kappa))
+            )( m_binv, m_dxphi[u], m_dyphi[u], m_v[0], m_v[1]);
             m_adv.upwind( -1., m_v[0], m_v[1], y[u], 0., yp[u]);
             // Div ExB velocity
             dg::blas1::pointwiseDot( m_p.kappa, m_ype[u], m_dyphi[u], 1., yp[u]);